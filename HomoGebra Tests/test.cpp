@@ -1,14 +1,49 @@
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <thread>
+
 #include "../HomoGebra/Assert.h"
+#include "../HomoGebra/Clipping.cpp"
+#include "../HomoGebra/Clipping.h"
 #include "../HomoGebra/Complex.cpp"
 #include "../HomoGebra/Complex.h"
+#include "../HomoGebra/ConicProjection.cpp"
+#include "../HomoGebra/ConicProjection.h"
+#include "../HomoGebra/Construction.cpp"
+#include "../HomoGebra/Construction.h"
 #include "../HomoGebra/Coordinate.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "../HomoGebra/Coordinate.h"
 #include "../HomoGebra/Equation.cpp"
 #include "../HomoGebra/Equation.h"
+#include "../HomoGebra/GeometricObject.cpp"
+#include "../HomoGebra/GeometricObject.h"
+#include "../HomoGebra/GeometricObjectFactory.cpp"
+#include "../HomoGebra/GeometricObjectFactory.h"
+#include "../HomoGebra/GeometricObjectImplementation.cpp"
+#include "../HomoGebra/GeometricObjectImplementation.h"
+#include "../HomoGebra/JsonLines.cpp"
+#include "../HomoGebra/JsonLines.h"
+#include "../HomoGebra/MappedFile.cpp"
+#include "../HomoGebra/MappedFile.h"
 #include "../HomoGebra/Matrix.cpp"
 #include "../HomoGebra/Matrix.h"
 #include "../HomoGebra/NameGenerator.cpp"
 #include "../HomoGebra/NameGenerator.h"
+#include "../HomoGebra/NameIndex.cpp"
+#include "../HomoGebra/NameIndex.h"
+#include "../HomoGebra/ObjectConstruction.cpp"
+#include "../HomoGebra/ObjectConstruction.h"
+#include "../HomoGebra/Observer.cpp"
+#include "../HomoGebra/Observer.h"
+#include "../HomoGebra/PlaneImplementation.cpp"
+#include "../HomoGebra/PlaneImplementation.h"
+#include "../HomoGebra/Polynomial.cpp"
+#include "../HomoGebra/Polynomial.h"
+#include "../HomoGebra/Profiler.h"
+#include "../HomoGebra/SceneFile.cpp"
+#include "../HomoGebra/SceneFile.h"
+#include "../HomoGebra/TripleBuffer.h"
 #include "gtest/gtest.h"
 
 using namespace HomoGebra;
@@ -272,6 +307,51 @@ TEST_F(ComplexSquaredMatrixTF, Determinant)
   ASSERT_TRUE(check_two_complex(Complex(0.0, 0.0),
                                 determinant_with_zero_determinant, kEpsilon));
 }
+
+TEST_F(ComplexSquaredMatrixTF, DeterminantWithSwappedRows)
+{
+  // Elimination swaps rows of this matrix
+  const ComplexSquaredMatrix permutation{
+      ComplexSquaredMatrix::Matrix{
+          ComplexSquaredMatrix::Row{Complex(0.0), Complex(1.0), Complex(0.0)},
+          ComplexSquaredMatrix::Row{Complex(2.0), Complex(0.0), Complex(0.0)},
+          ComplexSquaredMatrix::Row{Complex(0.0), Complex(0.0), Complex(3.0)}},
+      ComplexSquaredMatrix::Row(3)};
+
+  // Check that determinant has the right sign
+  EXPECT_TRUE(check_two_complex(Complex(-6.0), permutation.GetDeterminant(),
+                                kEpsilon));
+}
+
+TEST_F(ComplexSquaredMatrixTF, ScaledInverse)
+{
+  // Multiply matrix by a small number
+  auto matrix = non_singular_matrix;
+  for (size_t row = 0; row < matrix.GetSize(); ++row)
+  {
+    for (auto& value : matrix[row])
+    {
+      value *= Complex(1e-12L);
+    }
+  }
+
+  // Check that it is still regular
+  const auto inverse = matrix.GetInverse();
+  ASSERT_TRUE(inverse.has_value());
+
+  // Check that inverse is multiplied by the inverse number
+  const auto real_inverse = non_singular_matrix.GetInverse();
+  ASSERT_TRUE(real_inverse.has_value());
+  for (size_t row = 0; row < matrix.GetSize(); ++row)
+  {
+    for (size_t column = 0; column < matrix.GetSize(); ++column)
+    {
+      EXPECT_TRUE(check_two_complex(
+          (*real_inverse)[row][column],  // NOLINT
+          (*inverse)[row][column] * Complex(1e-12L), kEpsilon));  // NOLINT
+    }
+  }
+}
 }  // namespace Matrix
 
 namespace Coordinate
@@ -623,6 +703,36 @@ TEST(Transformation, From_points_constructor)
                                     kEpsilon));
 }
 
+TEST(Transformation, Fit)
+{
+  // Homothety with images, which aren't normalized
+  PointEquation a({Complex(1, 0), Complex(0, 0), Complex(1, 0)});
+  PointEquation b({Complex(0, 0), Complex(1, 0), Complex(1, 0)});
+  PointEquation c({Complex(1, 0), Complex(1, 0), Complex(1, 0)});
+  PointEquation d({Complex(0, 0), Complex(0, 0), Complex(1, 0)});
+
+  PointEquation a_image({Complex(4, 0), Complex(0, 0), Complex(2, 0)});
+  PointEquation b_image({Complex(0, 0), Complex(6, 0), Complex(3, 0)});
+  PointEquation c_image({Complex(2, 0), Complex(2, 0), Complex(1, 0)});
+  PointEquation d_image({Complex(0, 0), Complex(0, 0), Complex(5, 0)});
+
+  const auto homothety =
+      Transformation::Fit(a, b, c, d, a_image, b_image, c_image, d_image);
+  ASSERT_TRUE(homothety.has_value());
+
+  // Check that the point is moved twice as far
+  const HomogeneousCoordinate point{Complex(3, 1), Complex(1, 2)};
+  EXPECT_TRUE(check_two_coordinates(
+      (*homothety)(point).GetNormalized(),  // NOLINT
+      HomogeneousCoordinate{Complex(6, 2), Complex(2, 4)}, kEpsilon));
+
+  // Three preimages on a line have no transformation
+  EXPECT_FALSE(
+      Transformation::Fit(a, b, PointEquation({Complex(2), Complex(-1)}), d,
+                          a_image, b_image, c_image, d_image)
+          .has_value());
+}
+
 TEST(Transformation, Multiplication)
 {
   // Create random matrix
@@ -719,6 +829,17 @@ TEST(Subname, ParseSubname)
   EXPECT_EQ(parsed_multi_subname.subname, subname + silly_text);
   ASSERT_TRUE(parsed_multi_subname.number.has_value());
   EXPECT_EQ(parsed_multi_subname.number.value(), number);
+
+  // Create subname with number, which isn't at the end
+  const std::string number_first_subname = std::to_string(number) + silly_text;
+
+  // Parse
+  const auto parsed_number_first_subname =
+      NameGenerator::ParseSubname(number_first_subname);
+
+  // Check
+  EXPECT_EQ(parsed_number_first_subname.subname, number_first_subname);
+  ASSERT_TRUE(!parsed_number_first_subname.number.has_value());
 }
 
 TEST(Name, ParseName)
@@ -904,8 +1025,660 @@ TEST(Name, EmptyNameGen)
             NameGenerator::ParseName(std::string{kTestingCharacter} +
                                      kDelimiter + std::to_string(0)));
 }
+
+TEST(Name, NumberSet)
+{
+  NumberSet numbers;
+
+  EXPECT_TRUE(numbers.IsEmpty());
+  EXPECT_EQ(numbers.GetLowestFree(), 0);
+
+  // Runs are joined from both sides
+  EXPECT_TRUE(numbers.Add(0));
+  EXPECT_TRUE(numbers.Add(2));
+  EXPECT_FALSE(numbers.Add(2));
+  EXPECT_EQ(numbers.GetLowestFree(), 1);
+  EXPECT_TRUE(numbers.Add(1));
+  EXPECT_EQ(numbers.GetLowestFree(), 3);
+
+  // Large numbers don't fill the gap
+  EXPECT_TRUE(numbers.Add(1'000'000'000));
+  EXPECT_EQ(numbers.GetLowestFree(), 3);
+  EXPECT_TRUE(numbers.Contains(1'000'000'000));
+  EXPECT_FALSE(numbers.Contains(999'999'999));
+
+  // Deleting splits the run
+  EXPECT_TRUE(numbers.Delete(1));
+  EXPECT_FALSE(numbers.Delete(1));
+  EXPECT_EQ(numbers.GetLowestFree(), 1);
+  EXPECT_TRUE(numbers.Contains(0));
+  EXPECT_TRUE(numbers.Contains(2));
+
+  EXPECT_TRUE(numbers.Delete(0));
+  EXPECT_TRUE(numbers.Delete(2));
+  EXPECT_TRUE(numbers.Delete(1'000'000'000));
+  EXPECT_TRUE(numbers.IsEmpty());
+}
+
+TEST(Name, NamePool)
+{
+  NamePool pool;
+
+  const std::string_view key = "A_B";
+  EXPECT_EQ(pool.Find(key, NamePool::Hash(key)), NamePool::kNone);
+
+  // Strings are interned once, handles survive growing of the table
+  const auto handle = pool.Intern(key, NamePool::Hash(key));
+  for (size_t index = 0; index < 1000; ++index)
+  {
+    const auto other = "P_" + std::to_string(index);
+    EXPECT_EQ(pool.Intern(other, NamePool::Hash(other)), index + 1);
+  }
+
+  EXPECT_EQ(pool.Intern(key, NamePool::Hash(key)), handle);
+  EXPECT_EQ(pool.Find(key, NamePool::Hash(key)), handle);
+  EXPECT_EQ(pool.GetKey(handle), key);
+  EXPECT_EQ(pool.GetKey(pool.Find("P_999", NamePool::Hash("P_999"))), "P_999");
+  EXPECT_EQ(pool.GetSize(), 1001);
+}
+
+TEST(Name, ReserveNames)
+{
+  NameGenerator name_generator;
+  name_generator.AddName(std::string{"P"});
+
+  const std::vector<std::string> names{"P", "Q", "", "Q", "P_0", "R"};
+  const auto reserved = name_generator.ReserveNames(names);
+
+  // Free names are kept, others are adjusted after them
+  const std::vector<std::string> expected{"P_1", "Q", "", "Q_0", "P_0", "R"};
+  EXPECT_EQ(reserved, expected);
+
+  for (const auto& name : expected)
+  {
+    if (!name.empty()) EXPECT_TRUE(name_generator.IsNameUsed(name));
+  }
+}
+
+TEST(Name, ManyGeneratedNames)
+{
+  NameGenerator name_generator;
+
+  // Names are generated letter by letter, then number by number
+  constexpr size_t kAmount = 26 * 1000;
+  for (size_t index = 0; index < kAmount; ++index)
+  {
+    const auto name = name_generator.GenerateName();
+    ASSERT_TRUE(name_generator.AddName(name));
+  }
+
+  EXPECT_EQ(name_generator.GenerateName(), NameGenerator::ParseName("A_999"));
+  EXPECT_FALSE(name_generator.AddName(std::string{"Q_500"}));
+
+  // Deleted names are reused from the lowest one
+  name_generator.DeleteName(std::string{"Q_500"});
+  name_generator.DeleteName(std::string{"Q_7"});
+  EXPECT_EQ(name_generator.GenerateName(), NameGenerator::ParseName("Q_7"));
+  name_generator.AddName(std::string{"Q_7"});
+  EXPECT_EQ(name_generator.GenerateName(), NameGenerator::ParseName("Q_500"));
+  EXPECT_EQ(name_generator.GenerateName("Q_3"),
+            NameGenerator::ParseName("Q_500"));
+}
+
+TEST(Name, IndexVersionChangesOnRename)
+{
+  PlaneImplementation plane;
+  auto* point = PointOnPlaneFactory{&plane}(PointEquation{{1, 2, 1}});
+
+  // Selectors copy names and check the version to copy them again
+  const auto& name_index = plane.GetNameIndex();
+  const auto version = name_index.GetVersion();
+  point->SetName("Renamed");
+
+  EXPECT_NE(name_index.GetVersion(), version);
+  EXPECT_EQ(name_index.Find("Renamed"), point);
+}
 }  // namespace NameGen
 
+namespace Polynomials
+{
+TEST(Polynomial, Multiplication)
+{
+  // (x + 1)(x - 2) = x^2 - x - 2
+  const Polynomial first{{Complex{1}, Complex{1}}};
+  const Polynomial second{{Complex{-2}, Complex{1}}};
+
+  const auto product = first * second;
+
+  EXPECT_EQ(product.GetDegree(), 2);
+  EXPECT_TRUE(check_two_complex(product[0], Complex{-2}, kEpsilon));
+  EXPECT_TRUE(check_two_complex(product[1], Complex{-1}, kEpsilon));
+  EXPECT_TRUE(check_two_complex(product[2], Complex{1}, kEpsilon));
+  EXPECT_TRUE(check_two_complex(product(Complex{3}), Complex{4}, kEpsilon));
+}
+
+TEST(Polynomial, Roots)
+{
+  const std::vector<Complex> correct_roots = {Complex{1}, Complex{-2},
+                                              Complex{0, 3}, Complex{0, -3}};
+
+  // Build polynomial from its roots
+  Polynomial polynomial{{Complex{1}}};
+  for (const auto& root : correct_roots)
+  {
+    polynomial *= Polynomial{{-root, Complex{1}}};
+  }
+
+  const auto roots = polynomial.GetRoots();
+
+  ASSERT_EQ(roots.size(), correct_roots.size());
+  for (const auto& correct_root : correct_roots)
+  {
+    EXPECT_TRUE(std::ranges::any_of(
+        roots, [&correct_root](const auto& root)
+        { return check_two_complex(root, correct_root, 1e-9L); }));
+  }
+}
+
+TEST(Polynomial, NegligibleLeadingCoefficient)
+{
+  // 1e-20*x^2 + 2x - 4 is treated as 2x - 4
+  const Polynomial polynomial{{Complex{-4}, Complex{2}, Complex{1e-20L}}};
+
+  const auto roots = polynomial.GetRoots();
+
+  ASSERT_EQ(roots.size(), 1);
+  EXPECT_TRUE(check_two_complex(roots.front(), Complex{2}, kEpsilon));
+}
+}  // namespace Polynomials
+
+namespace ConicProjections
+{
+using HomoGebra::ConicProjection::Conic;
+using HomoGebra::ConicProjection::Project;
+
+TEST(ConicProjection, Circle)
+{
+  // x^2 + y^2 = 25
+  const Conic circle{1, 0, 1, 0, 0, -25};
+
+  const auto outer = Project(circle, 6, 8);
+  ASSERT_TRUE(outer.has_value());
+  EXPECT_NEAR(outer->x, 3, 1e-9L);
+  EXPECT_NEAR(outer->y, 4, 1e-9L);
+  EXPECT_NEAR(outer->distance, 5, 1e-9L);
+
+  const auto inner = Project(circle, 1, 0);
+  ASSERT_TRUE(inner.has_value());
+  EXPECT_NEAR(inner->x, 5, 1e-9L);
+  EXPECT_NEAR(inner->y, 0, 1e-9L);
+  EXPECT_NEAR(inner->distance, 4, 1e-9L);
+}
+
+TEST(ConicProjection, EllipseNearAxes)
+{
+  // x^2 / 16 + y^2 / 4 = 1
+  const Conic ellipse{1.0L / 16, 0, 1.0L / 4, 0, 0, -1};
+
+  // Near the major axis the normal from the position hits the ellipse four
+  // times, the nearest feet are symmetric
+  const auto major = Project(ellipse, 0.5L, 0);
+  ASSERT_TRUE(major.has_value());
+  EXPECT_NEAR(major->x, 2.0L / 3, 1e-9L);
+  EXPECT_NEAR(std::abs(major->y), std::sqrt(35.0L) / 3, 1e-9L);
+  EXPECT_NEAR(major->distance, std::sqrt(141.0L) / 6, 1e-9L);
+
+  const auto minor = Project(ellipse, 0, 0.5L);
+  ASSERT_TRUE(minor.has_value());
+  EXPECT_NEAR(minor->x, 0, 1e-9L);
+  EXPECT_NEAR(minor->y, 2, 1e-9L);
+  EXPECT_NEAR(minor->distance, 1.5L, 1e-9L);
+}
+
+TEST(ConicProjection, Parabola)
+{
+  // y = x^2
+  const Conic parabola{1, 0, 0, 0, -1, 0};
+
+  // Above the focus of the curvature the feet leave the vertex
+  const auto high = Project(parabola, 0, 2);
+  ASSERT_TRUE(high.has_value());
+  EXPECT_NEAR(std::abs(high->x), std::sqrt(1.5L), 1e-9L);
+  EXPECT_NEAR(high->y, 1.5L, 1e-9L);
+  EXPECT_NEAR(high->distance, std::sqrt(1.75L), 1e-9L);
+
+  const auto low = Project(parabola, 0, 0.25L);
+  ASSERT_TRUE(low.has_value());
+  EXPECT_NEAR(low->x, 0, 1e-9L);
+  EXPECT_NEAR(low->y, 0, 1e-9L);
+  EXPECT_NEAR(low->distance, 0.25L, 1e-9L);
+}
+
+TEST(ConicProjection, Center)
+{
+  // Any point of the circle is the nearest one
+  const auto circle = Project(Conic{1, 0, 1, 0, 0, -25}, 0, 0);
+  ASSERT_TRUE(circle.has_value());
+  EXPECT_NEAR(std::hypot(circle->x, circle->y), 5, 1e-9L);
+  EXPECT_NEAR(circle->distance, 5, 1e-9L);
+
+  // End of the minor axis is the nearest one
+  const auto ellipse = Project(Conic{1.0L / 16, 0, 1.0L / 4, 0, 0, -1}, 0, 0);
+  ASSERT_TRUE(ellipse.has_value());
+  EXPECT_NEAR(ellipse->x, 0, 1e-9L);
+  EXPECT_NEAR(std::abs(ellipse->y), 2, 1e-9L);
+  EXPECT_NEAR(ellipse->distance, 2, 1e-9L);
+
+  // Imaginary circle has no points
+  EXPECT_FALSE(Project(Conic{1, 0, 1, 0, 0, 25}, 0, 0).has_value());
+}
+}  // namespace ConicProjections
+
+namespace Profiling
+{
+TEST(RingBuffer, Percentiles)
+{
+  using HomoGebra::Profiling::RingBuffer;
+
+  // Push more values than buffer can keep
+  RingBuffer<float, 100> buffer;
+  for (int value = 1; value <= 150; ++value)
+  {
+    buffer.Push(static_cast<float>(value));
+  }
+
+  // Only last 100 values are kept, from the oldest to the newest
+  ASSERT_EQ(buffer.GetSize(), 100);
+  EXPECT_EQ(buffer[0], 51.f);
+  EXPECT_EQ(buffer.GetLast(), 150.f);
+
+  // Check statistics of values from 51 to 150
+  EXPECT_EQ(buffer.GetPercentile(0.), 51.f);
+  EXPECT_EQ(buffer.GetPercentile(1.), 150.f);
+  EXPECT_EQ(buffer.GetPercentile(0.95), 145.f);
+  EXPECT_FLOAT_EQ(buffer.GetMean(), 100.5f);
+}
+}  // namespace Profiling
+
+namespace Clipping
+{
+TEST(Clipping, Lines)
+{
+  using namespace HomoGebra::Clipping;
+
+  constexpr Bounds kBounds{-1.f, -1.f, 1.f, 1.f};
+
+  Lines lines;
+  lines.Push(1.f, 0.f, -0.5f);  // Vertical x = 0.5
+  lines.Push(0.f, 1.f, 0.f);    // Horizontal y = 0
+  lines.Push(1.f, -1.f, 0.f);   // Diagonal y = x
+  lines.Push(1.f, 0.f, -2.f);   // Vertical x = 2, outside
+  lines.Push(0.f, 0.f, 1.f);    // Line at infinity
+
+  Segments segments;
+  ClipLines(lines, kBounds, segments);
+
+  ASSERT_EQ(segments.visible.size(), 5);
+  EXPECT_TRUE(segments.visible[0]);
+  EXPECT_TRUE(segments.visible[1]);
+  EXPECT_TRUE(segments.visible[2]);
+  EXPECT_FALSE(segments.visible[3]);
+  EXPECT_FALSE(segments.visible[4]);
+
+  // Ends of the segments lie on the bounds
+  EXPECT_FLOAT_EQ(segments.x0[0], 0.5f);
+  EXPECT_FLOAT_EQ(segments.x1[0], 0.5f);
+  EXPECT_FLOAT_EQ(std::abs(segments.y0[0] - segments.y1[0]), 2.f);
+  EXPECT_FLOAT_EQ(std::abs(segments.x0[1] - segments.x1[1]), 2.f);
+  EXPECT_FLOAT_EQ(segments.y0[1], 0.f);
+  EXPECT_FLOAT_EQ(std::abs(segments.x0[2]), 1.f);
+  EXPECT_FLOAT_EQ(segments.x0[2], segments.y0[2]);
+  EXPECT_FLOAT_EQ(segments.x1[2], -segments.x0[2]);
+}
+
+TEST(Clipping, Rays)
+{
+  using namespace HomoGebra::Clipping;
+
+  constexpr Bounds kBounds{0.f, 0.f, 4.f, 2.f};
+
+  Rays rays;
+  rays.Push(2.f, 1.f, 0.f, -3.f);  // Up from the center
+  rays.Push(2.f, 1.f, 1.f, 1.f);   // Diagonal from the center
+  rays.Push(5.f, 1.f, 1.f, 0.f);   // Away from the bounds
+  rays.Push(2.f, 1.f, 0.f, 0.f);   // Without direction
+
+  Segments segments;
+  ClipRays(rays, kBounds, segments);
+
+  ASSERT_EQ(segments.visible.size(), 4);
+  EXPECT_TRUE(segments.visible[0]);
+  EXPECT_TRUE(segments.visible[1]);
+  EXPECT_FALSE(segments.visible[2]);
+  EXPECT_FALSE(segments.visible[3]);
+
+  // Rays start at their origins and leave through a side
+  EXPECT_FLOAT_EQ(segments.x0[0], 2.f);
+  EXPECT_FLOAT_EQ(segments.y0[0], 1.f);
+  EXPECT_FLOAT_EQ(segments.x1[0], 2.f);
+  EXPECT_FLOAT_EQ(segments.y1[0], 0.f);
+  EXPECT_FLOAT_EQ(segments.x1[1], 3.f);
+  EXPECT_FLOAT_EQ(segments.y1[1], 2.f);
+}
+}  // namespace Clipping
+
+namespace Scene
+{
+TEST(TripleBuffer, ReaderTakesNewestBuffer)
+{
+  TripleBuffer<int> buffer;
+  EXPECT_FALSE(buffer.Update());
+
+  // Reader skips buffers, which were replaced before it read them
+  buffer.GetBack() = 1;
+  buffer.Publish();
+  buffer.GetBack() = 2;
+  buffer.Publish();
+
+  EXPECT_TRUE(buffer.Update());
+  EXPECT_EQ(buffer.GetFront(), 2);
+
+  // Front buffer stays until something is published
+  EXPECT_FALSE(buffer.Update());
+  EXPECT_EQ(buffer.GetFront(), 2);
+}
+
+TEST(TripleBuffer, ConcurrentReaderSeesWholeBuffers)
+{
+  constexpr int kLastValue = 100000;
+
+  // Writer fills whole buffer with a value, so a torn buffer is visible
+  TripleBuffer<std::array<int, 64>> buffer;
+  std::thread writer(
+      [&buffer]
+      {
+        for (int value = 1; value <= kLastValue; ++value)
+        {
+          buffer.GetBack().fill(value);
+          buffer.Publish();
+        }
+      });
+
+  int last_value = 0;
+  bool whole = true;
+  bool increasing = true;
+  while (last_value != kLastValue)
+  {
+    if (!buffer.Update()) continue;
+
+    const auto& front = buffer.GetFront();
+    whole &= std::ranges::all_of(front, [&front](const int value)
+                                 { return value == front.front(); });
+    increasing &= front.front() > last_value;
+    last_value = front.front();
+  }
+
+  writer.join();
+
+  EXPECT_TRUE(whole);
+  EXPECT_TRUE(increasing);
+}
+}  // namespace Scene
+
+namespace Files
+{
+constexpr size_t kSavedConstructions = 5;  // Constructions of SaveScene()
+
+/**
+ * \brief Saves two points, a point coinciding with the first one, a line
+ * through the first two points and a free line.
+ *
+ * \return Path to the file.
+ */
+std::filesystem::path SaveScene()
+{
+  PlaneImplementation plane;
+  auto* point = PointOnPlaneFactory{&plane}(PointEquation{{1, 2, 1}});
+  auto* other = PointOnPlaneFactory{&plane}(PointEquation{{3, 4, 1}});
+  PointOnPlaneFactory{&plane}(PointEquation{{2, 4, 2}});
+  LineByTwoPointsFactory{&plane}(point, other);
+  LineOnPlaneFactory{&plane}(LineEquation{{1, 1, 1}});
+
+  const auto path =
+      std::filesystem::temp_directory_path() / "HomoGebraCorrupt.hgscene";
+  EXPECT_TRUE(SceneFile::Save(plane, path));
+  return path;
+}
+
+/**
+ * \brief Overwrites bytes of a file.
+ *
+ * \param path Path to the file.
+ * \param offset Offset of the first byte.
+ * \param value Value to write.
+ */
+template <class Value>
+void Patch(const std::filesystem::path& path, const size_t offset,
+           const Value& value)
+{
+  std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+  file.seekp(static_cast<std::streamoff>(offset));
+  file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/**
+ * \brief Replaces parents of the line by two points.
+ *
+ * \param path Path to the file.
+ * \param first First parent of the line.
+ * \param second Second parent of the line.
+ */
+void PatchParents(const std::filesystem::path& path, const std::uint32_t first,
+                  const std::uint32_t second)
+{
+  Patch(path,
+        sizeof(SceneFile::Header) + 3 * sizeof(SceneFile::ConstructionRecord) +
+            offsetof(SceneFile::ConstructionRecord, parents),
+        std::array{first, second});
+}
+
+/**
+ * \brief Replaces a parameter, e.g. a coefficient of an equation.
+ *
+ * \param path Path to the file.
+ * \param index Index of the parameter.
+ * \param real Real part of the parameter.
+ */
+void PatchParameter(const std::filesystem::path& path, const size_t index,
+                    const double real)
+{
+  Patch(path,
+        sizeof(SceneFile::Header) +
+            kSavedConstructions * sizeof(SceneFile::ConstructionRecord) +
+            index * sizeof(SceneFile::PackedComplex),
+        SceneFile::PackedComplex{real, 0.});
+}
+
+/**
+ * \brief Checks that a file isn't loaded and the plane isn't changed.
+ *
+ * \param path Path to the file.
+ */
+void ExpectRejected(const std::filesystem::path& path)
+{
+  PlaneImplementation plane;
+  EXPECT_FALSE(SceneFile::Load(path, plane));
+  EXPECT_TRUE(plane.GetConstructions().empty());
+
+  std::filesystem::remove(path);
+}
+
+TEST(SceneFile, LoadsScene)
+{
+  const auto path = SaveScene();
+
+  PlaneImplementation plane;
+  EXPECT_TRUE(SceneFile::Load(path, plane));
+  EXPECT_EQ(plane.GetConstructions().size(), kSavedConstructions);
+
+  std::filesystem::remove(path);
+}
+
+TEST(SceneFile, RejectsLineByIdenticalPoints)
+{
+  const auto path = SaveScene();
+  PatchParents(path, 0, 0);
+  ExpectRejected(path);
+}
+
+TEST(SceneFile, RejectsLineByCoincidentPoints)
+{
+  const auto path = SaveScene();
+  PatchParents(path, 0, 2);
+  ExpectRejected(path);
+}
+
+TEST(SceneFile, RejectsZeroPointAndLine)
+{
+  // Parameters of the first point, then of the free line after three points
+  for (const size_t first : {size_t{0}, size_t{9}})
+  {
+    const auto path = SaveScene();
+    for (size_t index = first; index < first + 3; ++index)
+    {
+      PatchParameter(path, index, 0.);
+    }
+    ExpectRejected(path);
+  }
+}
+
+TEST(SceneFile, RejectsNonFiniteParameters)
+{
+  for (const auto number : {std::numeric_limits<double>::quiet_NaN(),
+                            std::numeric_limits<double>::infinity()})
+  {
+    const auto path = SaveScene();
+    PatchParameter(path, 4, number);
+    ExpectRejected(path);
+  }
+}
+
+/**
+ * \brief Imports JSON Lines to an empty plane.
+ *
+ * \param text Lines to import.
+ *
+ * \return Report of the import.
+ */
+JsonLines::ImportReport ImportText(const std::string& text)
+{
+  PlaneImplementation plane;
+  std::istringstream input(text);
+  return JsonLines::Import(input, plane);
+}
+
+TEST(JsonLines, RejectsZeroPointAndLine)
+{
+  const auto report = ImportText(
+      R"({"type": "PointOnPlane", "id": 0, "equation": [0, 0, 0]})"
+      "\n"
+      R"({"type": "LineOnPlane", "id": 1, "equation": [0, 0, 0]})"
+      "\n");
+
+  EXPECT_EQ(report.imported, 0);
+  EXPECT_EQ(report.failed, 2);
+  ASSERT_EQ(report.errors.size(), 2);
+  EXPECT_EQ(report.errors.front().line, 1);
+  EXPECT_EQ(report.errors.back().line, 2);
+}
+
+TEST(JsonLines, RejectsNonFiniteNumbers)
+{
+  // from_chars reads them, but JSON has no such numbers
+  const auto report = ImportText(
+      R"({"type": "PointOnPlane", "id": 0, "equation": [nan, 1, 1]})"
+      "\n"
+      R"({"type": "LineOnPlane", "id": 1, "equation": [1, inf, 1]})"
+      "\n"
+      R"({"type": "PointOnPlane", "id": 2, "equation": [1, [1, -inf], 1]})"
+      "\n");
+
+  EXPECT_EQ(report.imported, 0);
+  EXPECT_EQ(report.failed, 3);
+}
+
+TEST(JsonLines, RejectsLineByIdenticalPoints)
+{
+  const auto report = ImportText(
+      R"({"type": "PointOnPlane", "id": 1, "equation": [1, 2, 1]})"
+      "\n"
+      R"({"type": "ByTwoPoints", "id": 2, "points": [1, 1]})"
+      "\n");
+
+  EXPECT_EQ(report.imported, 1);
+  EXPECT_EQ(report.failed, 1);
+  ASSERT_EQ(report.errors.size(), 1);
+  EXPECT_EQ(report.errors.front().line, 2);
+}
+
+TEST(JsonLines, RejectsLineByCoincidentPoints)
+{
+  // Coordinates are proportional
+  const auto report = ImportText(
+      R"({"type": "PointOnPlane", "id": 1, "equation": [1, 2, 1]})"
+      "\n"
+      R"({"type": "PointOnPlane", "id": 2, "equation": [2, 4, 2]})"
+      "\n"
+      R"({"type": "ByTwoPoints", "id": 3, "points": [1, 2]})"
+      "\n");
+
+  EXPECT_EQ(report.imported, 2);
+  EXPECT_EQ(report.failed, 1);
+  ASSERT_EQ(report.errors.size(), 1);
+  EXPECT_EQ(report.errors.front().line, 3);
+}
+
+TEST(JsonLines, ReportsObjectsByIds)
+{
+  // Line refers to points, which are declared later
+  PlaneImplementation plane;
+  std::istringstream input(
+      R"({"type": "ByTwoPoints", "id": 7, "points": [42, 13]})"
+      "\n"
+      R"({"type": "PointOnPlane", "id": 42, "equation": [1, 2, 1]})"
+      "\n"
+      R"({"type": "PointOnPlane", "id": 13, "equation": [3, 4, 1]})"
+      "\n");
+  const auto report = JsonLines::Import(input, plane);
+
+  ASSERT_EQ(report.imported, 3);
+  ASSERT_EQ(report.objects.size(), 3);
+
+  const auto& constructions = plane.GetConstructions();
+  EXPECT_EQ(report.objects.at("42"), constructions[0]->GetObject());
+  EXPECT_EQ(report.objects.at("13"), constructions[1]->GetObject());
+  EXPECT_EQ(report.objects.at("7"), constructions[2]->GetObject());
+}
+
+TEST(PointOnPlane, CanMoveOnlyIfLinesStayDefined)
+{
+  PlaneImplementation plane;
+  auto* point = PointOnPlaneFactory{&plane}(PointEquation{{100, 100, 1}});
+  auto* other = PointOnPlaneFactory{&plane}(PointEquation{{300, 300, 1}});
+  LineByTwoPointsFactory{&plane}(point, other);
+
+  const auto* construction =
+      dynamic_cast<const PointOnPlane*>(plane.GetConstructions().front().get());
+  ASSERT_NE(construction, nullptr);
+
+  // Dragging onto the other point of the line is skipped
+  EXPECT_TRUE(construction->CanMove(PointEquation{{200, 100, 1}}));
+  EXPECT_FALSE(construction->CanMove(PointEquation{{300, 300, 1}}));
+  EXPECT_FALSE(construction->CanMove(PointEquation{{600, 600, 2}}));
+  EXPECT_FALSE(construction->CanMove(PointEquation{{0, 0, 0}}));
+}
+}  // namespace Files
+
 /*namespace Functions
 {
 TEST(SolveQuadraticEquation, NoSolution)
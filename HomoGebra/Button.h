@@ -25,14 +25,28 @@ class ButtonBase : public ButtonImplementation<Elements...>
   /**
    * \brief Draws button.
    *
+   * \details Draws only copies of the plane, which are made by Refresh().
+   *
+   * \return True if the apply button is pressed, so the change should be
+   * applied.
    */
-  void Draw()
+  bool Draw()
   {
     ButtonImplementation<Elements...>::Draw();
-    if (DrawApplyButton())
-    {
-      ButtonImplementation<Elements...>::PassArguments();
-    }
+    return DrawApplyButton();
+  }
+
+  /**
+   * \brief Gets change of the plane, which applies the button.
+   *
+   * \details Change may be applied later, e.g. by the worker of the scene. It
+   * does nothing if some of the selected objects are removed meanwhile.
+   *
+   * \return Change of the plane.
+   */
+  [[nodiscard]] std::function<void(Plane&)> GetChange()
+  {
+    return ButtonImplementation<Elements...>::Bind();
   }
 
  private:
@@ -17,14 +17,6 @@ template <class GeometricObjectType>
 class ObjectSelector : public ObjectSelectorBody<GeometricObjectType>
 {
  public:
-  /**
-   * @brief Updates the object selector when an object is removed from the
-   * plane.
-   *
-   * @param object_removed The event data for the object removed event.
-   */
-  void Update(const PlaneEvent::ObjectRemoved& object_removed) override;
-
   /**
    * @brief Constructs an ObjectSelector object.
    *
@@ -59,13 +51,19 @@ class FactoryWrapper : public Factory
    *
    * @param plane A pointer to the plane on which the factory operates.
    */
-  explicit FactoryWrapper(Plane* plane) : Factory(plane) {}
+  explicit FactoryWrapper(Plane* plane) : Factory(&plane->GetImplementation())
+  {}
 
   /**
    * @brief Draws the factory.
    */
   void Draw() {}
 
+  /**
+   * @brief Copies nothing from the plane, the factory has no state.
+   */
+  void Refresh() {}
+
   /**
    * @brief Calls the wrapped factory with the specified arguments.
    *
@@ -109,6 +107,11 @@ class Deleter
    */
   void Draw() {}
 
+  /**
+   * @brief Copies nothing from the plane, the deleter has no state.
+   */
+  void Refresh() {}
+
   /**
    * @brief Calls the deleter with the specified arguments.
    *
@@ -2,12 +2,26 @@
 
 #include <imgui.h>
 
+#include <algorithm>
+#include <limits>
+#include <ranges>
 #include <vector>
 
-#include "GuiUtilities.h"
-
 namespace HomoGebra
 {
+template <class GeometricObjectType>
+ObjectSelectorBody<GeometricObjectType>::ObjectSelectorBody(Plane* plane)
+    : plane_(plane), object_getter_(plane)
+{
+  plane->Attach(this);
+
+  // Later objects are added by events
+  for (auto* object : plane->GetObjects<GeometricObjectType>())
+  {
+    objects_.push_back(static_cast<GeometricObjectType*>(object));
+  }
+}
+
 template <class GeometricObjectType>
 void ObjectSelectorBody<GeometricObjectType>::Draw()
 {
@@ -25,12 +39,62 @@ void ObjectSelectorBody<GeometricObjectType>::Draw()
   ImGui::PopID();
 }
 
+template <class GeometricObjectType>
+void ObjectSelectorBody<GeometricObjectType>::Refresh()
+{
+  if (is_filter_changed_)
+  {
+    are_found_objects_valid_ = false;
+    are_rows_valid_ = false;
+    is_filter_changed_ = false;
+  }
+
+  // Renamed objects move in the filtered list and change their rows
+  if (const auto version =
+          plane_->GetImplementation().GetNameIndex().GetVersion();
+      version != names_version_)
+  {
+    are_found_objects_valid_ = false;
+    are_rows_valid_ = false;
+    names_version_ = version;
+  }
+
+  // Names are copied again only after the list has changed
+  if (!are_rows_valid_)
+  {
+    const auto& objects =
+        filter_.front() == '\0' ? objects_ : GetFoundObjects();
+
+    rows_.clear();
+    rows_.reserve(objects.size());
+    for (auto* object : objects)
+    {
+      rows_.push_back(Row{object, object->GetName()});
+    }
+
+    are_rows_valid_ = true;
+  }
+
+  // Object selected from old rows may be already removed
+  auto* object = GetObject();
+  if (object != copied_object_ && object &&
+      !plane_->GetImplementation().IsContained(object))
+  {
+    object = nullptr;
+    SetObject(object);
+  }
+  copied_object_ = object;
+  object_name_ = object ? object->GetName() : "nullptr";
+
+  last_object_ = object_getter_.GetLastObject();
+  last_object_name_ = last_object_ ? last_object_->GetName() : "nullptr";
+}
+
 template <class GeometricObjectType>
 void ObjectSelectorBody<GeometricObjectType>::SetObject(
     GeometricObjectType* object)
 {
   object_ = object;
-  current_object_ = -1;
 }
 
 template <class GeometricObjectType>
@@ -41,72 +105,117 @@ GeometricObjectType* ObjectSelectorBody<GeometricObjectType>::GetObject() const
 
 template <class GeometricObjectType>
 void ObjectSelectorBody<GeometricObjectType>::Update(
-    const PlaneEvent::ObjectRemoved& object_removed)
+    const PlaneEvent::ObjectAdded& object_added)
 {
-  if (GetObject() == object_removed.removed_object)
+  // New objects don't change the selection
+  if (auto* object =
+          dynamic_cast<GeometricObjectType*>(object_added.added_object))
   {
-    SetObject(nullptr);
+    objects_.push_back(object);
+    are_found_objects_valid_ = false;
+    are_rows_valid_ = false;
   }
 }
 
 template <class GeometricObjectType>
-void ObjectSelectorBody<GeometricObjectType>::DrawName()
+void ObjectSelectorBody<GeometricObjectType>::Update(
+    const PlaneEvent::ObjectRemoved& object_removed)
 {
-  if (!GetObject())
+  // Selection is changed by the drawing thread, so only the removed one is
+  // reset
+  if (auto* selected = GetObject(); selected == object_removed.removed_object)
   {
-    // If there is no object selected, draw nullptr
-    ImGui::Text("nullptr");
-    return;
+    object_.compare_exchange_strong(selected, nullptr);
   }
 
-  // Draw name of object
-  ImGui::Text(GetObject()->GetName().c_str());
+  // Objects are usually removed from the end, e.g. when plane is destroyed
+  const auto found = std::ranges::find_if(
+      objects_ | std::views::reverse,
+      [&object_removed](const GeometricObject* object)
+      { return object == object_removed.removed_object; });
+  if (found != std::ranges::rend(objects_))
+  {
+    objects_.erase(std::prev(found.base()));
+    are_found_objects_valid_ = false;
+    are_rows_valid_ = false;
+  }
 }
 
 template <class GeometricObjectType>
-void ObjectSelectorBody<GeometricObjectType>::DrawList()
+void ObjectSelectorBody<GeometricObjectType>::DrawName()
 {
-  // Get objects of type
-  std::vector<GeometricObject*> objects =
-      plane_->GetObjects<GeometricObjectType>();
-
-  // Construct object selector
-  if (ImGui::ListBox("Objects", &current_object_, ObjectsNameGetter, &objects,
-                     static_cast<int>(objects.size())) &&
-      (current_object_ >= 0 &&
-       current_object_ < static_cast<int>(objects.size())))
-  {
-    // Select object
-    SetObject(dynamic_cast<GeometricObjectType*>(objects[current_object_]));
-  }
+  // Draw name of object, which is nullptr if there is no object selected
+  ImGui::TextUnformatted(object_name_.c_str());
 }
 
 template <class GeometricObjectType>
-void ObjectSelectorBody<GeometricObjectType>::DrawSetter()
+void ObjectSelectorBody<GeometricObjectType>::DrawList()
 {
-  std::string last_used_object_text = "Last used object: ";
-
-  // Get last used object
-  const auto object = object_getter_.GetLastObject();
-
-  // Add name of object to text if it is not nullptr, otherwise add nullptr
-  if (object)
+  // Objects are filtered by the next Refresh()
+  if (ImGui::InputText("Filter", filter_.data(), filter_.size()))
   {
-    last_used_object_text += object->GetName();
+    is_filter_changed_ = true;
   }
-  else
+
+  // Construct object selector, only visible rows are drawn
+  if (!ImGui::BeginListBox("Objects")) return;
+
+  ImGuiListClipper clipper;
+  clipper.Begin(static_cast<int>(rows_.size()));
+  while (clipper.Step())
   {
-    last_used_object_text += "nullptr";
+    for (auto row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+    {
+      const auto& [object, name] = rows_[row];
+
+      ImGui::PushID(object);
+      if (ImGui::Selectable(name.c_str(), object == GetObject()))
+      {
+        // Select object
+        SetObject(object);
+        object_name_ = name;
+      }
+      ImGui::PopID();
+    }
   }
 
+  ImGui::EndListBox();
+}
+
+template <class GeometricObjectType>
+void ObjectSelectorBody<GeometricObjectType>::DrawSetter()
+{
   // Draw last used object
-  ImGui::Text(last_used_object_text.c_str());
+  const auto last_used_object_text = "Last used object: " + last_object_name_;
+  ImGui::TextUnformatted(last_used_object_text.c_str());
 
   // Create button to select object
   if (ImGui::Button("Select object"))
   {
-    SetObject(object);
+    SetObject(last_object_);
+    object_name_ = last_object_name_;
+  }
+}
+
+template <class GeometricObjectType>
+const std::vector<GeometricObjectType*>&
+ObjectSelectorBody<GeometricObjectType>::GetFoundObjects()
+{
+  if (are_found_objects_valid_) return found_objects_;
+
+  found_objects_.clear();
+  const auto& name_index = plane_->GetImplementation().GetNameIndex();
+  for (auto* object : name_index.FindByPrefix(
+           filter_.data(), std::numeric_limits<size_t>::max()))
+  {
+    if (auto* found = dynamic_cast<GeometricObjectType*>(object))
+    {
+      found_objects_.push_back(found);
+    }
   }
+
+  are_found_objects_valid_ = true;
+  return found_objects_;
 }
 
 template class ObjectSelectorBody<GeometricObject>;
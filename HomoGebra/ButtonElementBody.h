@@ -1,4 +1,9 @@
 #pragma once
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
 #include "GeometricObject.h"
 #include "Input.h"
 #include "Plane.h"
@@ -12,6 +17,15 @@ namespace HomoGebra
    * selected object, as well as drawing the body of the selector, including the
    * name of the selected object and a list of objects to choose from.
    *
+   * Objects of the type are kept in a list, which is updated by events of the
+   * plane, and only visible rows of the list are drawn. The list may be
+   * filtered by the beginning of names, which is looked up in the name index
+   * of the plane. So a frame costs as many rows as are visible.
+   *
+   * The plane is changed on the worker thread, so the selector is drawn from
+   * rows and names, which are copied by Refresh() while the plane is locked.
+   * Draw() never touches the plane, so it may be called every frame.
+   *
    * \tparam GeometricObjectType The type of geometric object to be selected.
    */
 template <class GeometricObjectType>
@@ -23,21 +37,25 @@ class ObjectSelectorBody : public PlaneObserver
    *
    * \param plane The plane to associate with the ObjectSelectorBody.
    */
-  explicit ObjectSelectorBody(Plane* plane)
-      : plane_(plane), object_getter_(plane)
-  {
-    plane->Attach(this);
-  }
+  explicit ObjectSelectorBody(Plane* plane);
 
   /**
    * \brief Draws the body of the ObjectSelector.
    *
    * This method is responsible for drawing the body of the ObjectSelector,
    * including the name of the selected object and a list of objects to choose
-   * from.
+   * from. Only copies made by the last Refresh() are drawn.
    */
   void Draw();
 
+  /**
+   * \brief Copies what is drawn from the plane.
+   *
+   * \details Plane must be locked. Rows are copied again only if the filter,
+   * the plane or names of objects have changed.
+   */
+  void Refresh();
+
   /**
    * \brief Sets the selected object.
    *
@@ -52,6 +70,8 @@ class ObjectSelectorBody : public PlaneObserver
    */
   [[nodiscard]] GeometricObjectType* GetObject() const;
 
+  void Update(const PlaneEvent::ObjectAdded& object_added) override;
+
   /**
    * \brief Updates the ObjectSelectorBody when an object is removed from the
    * plane.
@@ -83,10 +103,47 @@ class ObjectSelectorBody : public PlaneObserver
    */
   void DrawSetter();
 
-  GeometricObjectType* object_{};
-  Plane* plane_;
-  NearbyObjectGetter<GeometricObjectType> object_getter_;
+  /**
+   * \brief Gets objects, which names start with the filter.
+   *
+   * \details Objects are found again only if the filter, the plane or names
+   * of objects have changed.
+   *
+   * \return Found objects in order of their names.
+   */
+  const std::vector<GeometricObjectType*>& GetFoundObjects();
+
+  /**
+   * \brief Row of the list, which is drawn.
+   */
+  struct Row
+  {
+    GeometricObjectType* object;  //!< Object, it is never dereferenced.
+    std::string name;             //!< Name of the object.
+  };
+
+  /**
+   * Member data.
+   */
+  std::atomic<GeometricObjectType*> object_{};  //!< Selected object.
+  Plane* plane_;                                //!< Plane to select from.
+  NearbyObjectGetter<GeometricObjectType>
+      object_getter_;  //!< Getter of the last nearby object.
+
+  // Guarded by the plane
+  std::vector<GeometricObjectType*> objects_;        //!< Objects of the type.
+  std::vector<GeometricObjectType*> found_objects_;  //!< Filtered objects.
+  bool are_found_objects_valid_ = false;  //!< Are filtered objects valid?
+  bool are_rows_valid_ = false;           //!< Are copied rows valid?
+  size_t names_version_ = 0;              //!< Version of the name index.
 
-  int current_object_ = -1;
+  // Used only by the thread, which draws
+  std::array<char, 64> filter_{};             //!< Beginning of shown names.
+  bool is_filter_changed_ = false;            //!< Was filter changed?
+  std::vector<Row> rows_;                     //!< Copied rows of the list.
+  GeometricObjectType* copied_object_{};      //!< Copied selected object.
+  std::string object_name_ = "nullptr";       //!< Name of the selected object.
+  GeometricObjectType* last_object_{};        //!< Copied last nearby object.
+  std::string last_object_name_ = "nullptr";  //!< Name of the last one.
 };
 }  // namespace HomoGebra
@@ -1,4 +1,5 @@
 #pragma once
+#include <functional>
 #include <utility>
 
 #include "Plane.h"
@@ -13,6 +14,9 @@ concept ButtonElement = requires(T button_part) {
   {
     button_part.Draw()
   };
+  {
+    button_part.Refresh()
+  };
 } && requires(const T button_part) {
   {
     button_part()
@@ -70,13 +74,25 @@ class ButtonImplementation : public Wrapper<First, sizeof...(Rest)>,
   }
 
   /**
-   * \brief Construct object from arguments.
+   * \brief Copies what is drawn from the plane.
+   *
+   */
+  void Refresh()
+  {
+    Wrapper<First, sizeof...(Rest)>::Refresh();
+    ButtonImplementation<Rest...>::Refresh();
+  }
+
+  /**
+   * \brief Binds arguments to a change of the plane.
    *
    * \tparam Args Argument types.
    * \param arguments Already received arguments.
+   *
+   * \return Change, which constructs object from arguments.
    */
   template <class... Args>
-  void PassArguments(Args&&... arguments);
+  std::function<void(Plane&)> Bind(Args... arguments);
 };
 
 /**
@@ -110,28 +126,47 @@ class ButtonImplementation<First> : public Wrapper<First, 0>
   void Draw() { Wrapper<First>::Draw(); }
 
   /**
-   * \brief Construct object from arguments.
+   * \brief Copies what is drawn from the plane.
+   *
+   */
+  void Refresh() { Wrapper<First>::Refresh(); }
+
+  /**
+   * \brief Binds arguments to a change of the plane.
    *
    * \tparam Args Argument types.
    * \param arguments Already received arguments.
+   *
+   * \return Change, which constructs object from arguments.
    */
   template <class... Args>
-  void PassArguments(Args&&... arguments);
+  std::function<void(Plane&)> Bind(Args... arguments);
 };
 
 template <ButtonElement First, class... Rest>
 template <class... Args>
-void ButtonImplementation<First, Rest...>::PassArguments(Args&&... arguments)
+std::function<void(Plane&)> ButtonImplementation<First, Rest...>::Bind(
+    Args... arguments)
 {
-  ButtonImplementation<Rest...>::PassArguments(
-      std::forward<Args>(arguments)...,
-      Wrapper<First, sizeof...(Rest)>::operator()());
+  return ButtonImplementation<Rest...>::Bind(
+      arguments..., Wrapper<First, sizeof...(Rest)>::operator()());
 }
 
 template <ButtonElement First>
 template <class... Args>
-void ButtonImplementation<First>::PassArguments(Args&&... arguments)
+std::function<void(Plane&)> ButtonImplementation<First>::Bind(
+    Args... arguments)
 {
-  Wrapper<First, 0>::operator()(std::forward<Args>(arguments)...);
+  return [this, arguments...](Plane& plane)
+  {
+    // Objects may be removed by changes, which are applied before
+    const auto& implementation = plane.GetImplementation();
+    if (((arguments && !implementation.IsContained(arguments)) || ...))
+    {
+      return;
+    }
+
+    Wrapper<First, 0>::operator()(arguments...);
+  };
 }
 }  // namespace HomoGebra
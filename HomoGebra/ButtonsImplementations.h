@@ -30,12 +30,15 @@ class WindowButton : public ButtonClass
 
   /**
    * @brief Draws the button inside an ImGui window.
+   *
+   * @return True if the apply button is pressed.
    */
-  void Draw()
+  bool Draw()
   {
     ImGui::Begin(name_.data());
-    ButtonClass::Draw();
+    const auto applied = ButtonClass::Draw();
     ImGui::End();
+    return applied;
   }
 
  private:
@@ -0,0 +1,145 @@
+#include "Camera.h"
+
+#include <cmath>
+
+#include "DistanceUtilities.h"
+
+namespace HomoGebra
+{
+template <class Event>
+void ObservableCamera::Notify(const Event& event) const
+{
+  Observable::Notify(event);
+}
+
+template void ObservableCamera::Notify<CameraEvent::ViewChanged>(
+    const CameraEvent::ViewChanged& event) const;
+
+Camera::Camera(const sf::View& view, const sf::Vector2u& size)
+    : view_(view),
+      home_(view),
+      size_(size),
+      goal_center_(view.getCenter()),
+      goal_size_(view.getSize())
+{}
+
+void Camera::HandleEvent(const sf::Event& event)
+{
+  auto is_drag_button = [](const sf::Mouse::Button button)
+  { return button == sf::Mouse::Right || button == sf::Mouse::Middle; };
+
+  switch (event.type)
+  {
+    case sf::Event::MouseWheelScrolled:
+    {
+      const auto& [wheel, delta, x, y] = event.mouseWheelScroll;
+      if (wheel != sf::Mouse::VerticalWheel) break;
+
+      Zoom(std::pow(kZoomStep, delta), {x, y});
+      break;
+    }
+    case sf::Event::MouseButtonPressed:
+    {
+      if (is_drag_button(event.mouseButton.button))
+      {
+        drag_pixel_ = sf::Vector2i{event.mouseButton.x, event.mouseButton.y};
+      }
+      break;
+    }
+    case sf::Event::MouseButtonReleased:
+    {
+      if (is_drag_button(event.mouseButton.button)) drag_pixel_.reset();
+      break;
+    }
+    case sf::Event::MouseMoved:
+    {
+      if (!drag_pixel_) break;
+
+      // Point under the cursor follows it
+      const sf::Vector2i pixel{event.mouseMove.x, event.mouseMove.y};
+      const auto shift =
+          MapPixelToCoords(drag_pixel_.value(), view_.getCenter(),
+                           view_.getSize()) -
+          MapPixelToCoords(pixel, view_.getCenter(), view_.getSize());
+      drag_pixel_ = pixel;
+
+      goal_center_ += shift;
+      SetView(view_.getCenter() + shift, view_.getSize());
+      break;
+    }
+    case sf::Event::KeyPressed:
+    {
+      if (event.key.code == sf::Keyboard::Home)
+      {
+        MoveTo(home_.getCenter(), home_.getSize());
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+void Camera::Update(const float seconds)
+{
+  if (!IsAnimating()) return;
+
+  // Exponential approach doesn't depend on frame rate
+  const auto part = 1.f - std::exp(-kSmoothness * seconds);
+  auto center = view_.getCenter() + (goal_center_ - view_.getCenter()) * part;
+  auto size = view_.getSize() + (goal_size_ - view_.getSize()) * part;
+
+  // Finish transition, which isn't visible anymore
+  const auto precision = kPrecision * std::abs(goal_size_.x);
+  if (Length(goal_center_ - center) < precision &&
+      Length(goal_size_ - size) < precision)
+  {
+    center = goal_center_;
+    size = goal_size_;
+  }
+
+  SetView(center, size);
+}
+
+void Camera::Zoom(const float factor, const sf::Vector2i& pixel)
+{
+  // Point under the pixel stays there after the transition
+  const auto anchor = MapPixelToCoords(pixel, goal_center_, goal_size_);
+
+  goal_center_ = anchor + (goal_center_ - anchor) / factor;
+  goal_size_ /= factor;
+}
+
+void Camera::MoveTo(const sf::Vector2f& center, const sf::Vector2f& size)
+{
+  goal_center_ = center;
+  goal_size_ = size;
+}
+
+const sf::View& Camera::GetView() const { return view_; }
+
+bool Camera::IsAnimating() const
+{
+  return view_.getCenter() != goal_center_ || view_.getSize() != goal_size_;
+}
+
+sf::Vector2f Camera::MapPixelToCoords(const sf::Vector2i& pixel,
+                                      const sf::Vector2f& center,
+                                      const sf::Vector2f& size) const
+{
+  // Part of the render target from its center
+  const sf::Vector2f offset{
+      static_cast<float>(pixel.x) / static_cast<float>(size_.x) - 0.5f,
+      static_cast<float>(pixel.y) / static_cast<float>(size_.y) - 0.5f};
+
+  return center + sf::Vector2f{offset.x * size.x, offset.y * size.y};
+}
+
+void Camera::SetView(const sf::Vector2f& center, const sf::Vector2f& size)
+{
+  view_.setCenter(center);
+  view_.setSize(size);
+
+  Notify(CameraEvent::ViewChanged{view_, size_});
+}
+}  // namespace HomoGebra
@@ -0,0 +1,168 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <optional>
+
+#include "Observer.h"
+
+namespace HomoGebra
+{
+namespace CameraEvent
+{
+/**
+ * \brief Tag that shows that view of the camera has changed.
+ *
+ * \author nook0110
+ */
+struct ViewChanged
+{
+  sf::View view;      //!< New view.
+  sf::Vector2u size;  //!< Size of the render target in pixels.
+};
+}  // namespace CameraEvent
+
+class CameraObserver
+{
+ public:
+  /**
+   * \brief Default destructor.
+   */
+  virtual ~CameraObserver() = default;
+
+  /**
+   * \brief Update, because view has changed.
+   *
+   * \param view_changed Tag with the new view.
+   */
+  virtual void Update(const CameraEvent::ViewChanged& view_changed) = 0;
+};
+
+class ObservableCamera : public Observable<CameraObserver>
+{
+ public:
+  /**
+   * \brief Default destructor.
+   */
+  ~ObservableCamera() override = default;
+
+  /**
+   * \brief Notify all observers about event.
+   *
+   * \tparam Event Type of event.
+   * \param event Event to notify about.
+   */
+  template <class Event>
+  void Notify(const Event& event) const;
+};
+
+/**
+ * \brief Controls view of the plane.
+ *
+ * \details Wheel zooms around the cursor, dragging with the right or the
+ * middle button pans, Home returns to the initial view. Zoom and MoveTo()
+ * are animated: the view approaches its goal a bit every frame. Observers
+ * are notified on every change of the view, so they may update only what
+ * depends on it.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see CameraObserver
+ */
+class Camera final : public ObservableCamera
+{
+ public:
+  /**
+   * \brief Constructs camera with initial view.
+   *
+   * \param view Initial view.
+   * \param size Size of the render target in pixels.
+   */
+  Camera(const sf::View& view, const sf::Vector2u& size);
+
+  /**
+   * \brief Zooms or pans by an event of the window.
+   *
+   * \param event Event of the window.
+   */
+  void HandleEvent(const sf::Event& event);
+
+  /**
+   * \brief Moves view towards its goal.
+   *
+   * \param seconds Time since the previous update.
+   */
+  void Update(float seconds);
+
+  /**
+   * \brief Zooms keeping a point of the plane under a pixel.
+   *
+   * \param factor How many times objects become bigger.
+   * \param pixel Pixel, which stays over the same point.
+   */
+  void Zoom(float factor, const sf::Vector2i& pixel);
+
+  /**
+   * \brief Starts animated transition to a view.
+   *
+   * \param center Center of the view.
+   * \param size Size of the view.
+   */
+  void MoveTo(const sf::Vector2f& center, const sf::Vector2f& size);
+
+  /**
+   * \brief Gets current view.
+   *
+   * \return View.
+   */
+  [[nodiscard]] const sf::View& GetView() const;
+
+  /**
+   * \brief Checks if view is still moving towards its goal.
+   *
+   * \return True if transition isn't finished.
+   */
+  [[nodiscard]] bool IsAnimating() const;
+
+ private:
+  /**
+   * \brief Maps pixel to the plane.
+   *
+   * \param pixel Pixel of the render target.
+   * \param center Center of the view.
+   * \param size Size of the view.
+   *
+   * \return Point of the plane.
+   */
+  [[nodiscard]] sf::Vector2f MapPixelToCoords(const sf::Vector2i& pixel,
+                                              const sf::Vector2f& center,
+                                              const sf::Vector2f& size) const;
+
+  /**
+   * \brief Sets current view and notifies observers.
+   *
+   * \param center Center of the view.
+   * \param size Size of the view.
+   */
+  void SetView(const sf::Vector2f& center, const sf::Vector2f& size);
+
+  /**
+   * Member data.
+   */
+  static constexpr float kZoomStep = 1.2f;    //!< Zoom of a wheel notch.
+  static constexpr float kSmoothness = 12.f;  //!< Rate of transitions (1/s).
+  static constexpr float kPrecision =
+      1e-3f;  //!< Transition ends closer than this part of the view.
+
+  sf::View view_;             //!< Current view.
+  sf::View home_;             //!< Initial view.
+  sf::Vector2u size_;         //!< Size of the render target in pixels.
+  sf::Vector2f goal_center_;  //!< Center, which view moves to.
+  sf::Vector2f goal_size_;    //!< Size, which view moves to.
+
+  std::optional<sf::Vector2i>
+      drag_pixel_;  //!< Last pixel of the cursor while dragging.
+};
+}  // namespace HomoGebra
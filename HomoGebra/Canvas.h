@@ -0,0 +1,68 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <span>
+#include <string>
+
+namespace HomoGebra
+{
+/**
+ * \brief Interface of a surface, which bodies draw to.
+ *
+ * \details All coordinates are given in coordinates of the plane. Canvas
+ * maps them to pixels itself.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see SfmlCanvas
+ * \see SoftwareCanvas
+ */
+class Canvas
+{
+ public:
+  /**
+   * \brief Default destructor.
+   */
+  virtual ~Canvas() = default;
+
+  /**
+   * \brief Draws filled circle.
+   *
+   * \param center Center of the circle.
+   * \param radius Radius of the circle.
+   * \param color Color of the circle.
+   */
+  virtual void DrawCircle(const sf::Vector2f& center, float radius,
+                          const sf::Color& color) = 0;
+
+  /**
+   * \brief Draws thin segments.
+   *
+   * \param vertices Pairs of vertices, each pair is a segment.
+   */
+  virtual void DrawLines(std::span<const sf::Vertex> vertices) = 0;
+
+  /**
+   * \brief Draws thick polyline.
+   *
+   * \param vertices Vertices of the polyline.
+   * \param thickness Thickness of the polyline.
+   */
+  virtual void DrawPolyline(std::span<const sf::Vertex> vertices,
+                            float thickness) = 0;
+
+  /**
+   * \brief Draws text.
+   *
+   * \param text Text to draw.
+   * \param position Top left corner of the text.
+   * \param height Height of the text.
+   * \param color Color of the text.
+   */
+  virtual void DrawText(const std::string& text, const sf::Vector2f& position,
+                        float height, const sf::Color& color) = 0;
+};
+}  // namespace HomoGebra
@@ -0,0 +1,216 @@
+#include "Clipping.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace HomoGebra::Clipping
+{
+namespace
+{
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+/**
+ * \brief Parameters, where a line crosses a slab between two parallel
+ * boundaries.
+ */
+struct Slab
+{
+  float enter;  //!< Parameter, where the line enters the slab.
+  float leave;  //!< Parameter, where the line leaves the slab.
+};
+
+/**
+ * \brief Intersects line p + t * d with a slab lo <= x <= hi.
+ *
+ * \details Only selects are used, so the function is inlined into a loop,
+ * which compiler can vectorize. Quotients are computed even for a parallel
+ * line, where they are infinite or NaN, and then are discarded: a division
+ * under a condition might trap, so it would stay a branch.
+ *
+ * \param p Coordinate of a point of the line.
+ * \param d Coordinate of a direction of the line.
+ * \param lo Lower boundary of the slab.
+ * \param hi Upper boundary of the slab.
+ *
+ * \return Parameters of the intersection.
+ */
+inline Slab IntersectSlab(const float p, const float d, const float lo,
+                          const float hi)
+{
+  const auto first = (lo - p) / d;
+  const auto second = (hi - p) / d;
+  const auto low = std::min(first, second);
+  const auto high = std::max(first, second);
+
+  // Parallel line is either inside the slab entirely or outside of it
+  const auto is_parallel = d == 0.f;
+  const auto is_inside = (lo <= p) & (p <= hi);
+  const auto parallel_enter = is_inside ? -kInfinity : kInfinity;
+
+  return {is_parallel ? parallel_enter : low,
+          is_parallel ? -parallel_enter : high};
+}
+
+/**
+ * \brief Clips lines a * x + b * y + c = 0 with bounds.
+ *
+ * \details Outputs are restricted, otherwise the loop would need too many
+ * checks of aliasing to be vectorized.
+ *
+ * \param a Coefficients of x.
+ * \param b Coefficients of y.
+ * \param c Constants.
+ * \param size Amount of lines.
+ * \param bounds Bounds to clip with.
+ * \param x0 Abscissas of first ends.
+ * \param y0 Ordinates of first ends.
+ * \param x1 Abscissas of second ends.
+ * \param y1 Ordinates of second ends.
+ * \param visible Does line cross the bounds?
+ */
+void ClipLineArrays(const float* a, const float* b, const float* c,
+                    const size_t size, const Bounds bounds,
+                    float* __restrict x0, float* __restrict y0,
+                    float* __restrict x1, float* __restrict y1,
+                    std::uint8_t* __restrict visible)
+{
+  for (size_t i = 0; i < size; ++i)
+  {
+    // Closest point of the line to the origin and direction along the line.
+    // Line at infinity gets NaN, but it is invisible anyway
+    const auto length = a[i] * a[i] + b[i] * b[i];
+    const auto is_finite = length > 0.f;
+    const auto factor = -c[i] / length;
+    const auto px = a[i] * factor;
+    const auto py = b[i] * factor;
+    const auto dx = -b[i];
+    const auto dy = a[i];
+
+    const auto [enter_x, leave_x] =
+        IntersectSlab(px, dx, bounds.left, bounds.right);
+    const auto [enter_y, leave_y] =
+        IntersectSlab(py, dy, bounds.top, bounds.bottom);
+    const auto enter = std::max(enter_x, enter_y);
+    const auto leave = std::min(leave_x, leave_y);
+
+    x0[i] = px + enter * dx;
+    y0[i] = py + enter * dy;
+    x1[i] = px + leave * dx;
+    y1[i] = py + leave * dy;
+    visible[i] = is_finite & (enter <= leave);
+  }
+}
+
+/**
+ * \brief Clips rays origin + t * direction, t >= 0 with bounds.
+ *
+ * \details Outputs are restricted, otherwise the loop would need too many
+ * checks of aliasing to be vectorized.
+ *
+ * \param origin_x Abscissas of origins.
+ * \param origin_y Ordinates of origins.
+ * \param direction_x Abscissas of directions.
+ * \param direction_y Ordinates of directions.
+ * \param size Amount of rays.
+ * \param bounds Bounds to clip with.
+ * \param x0 Abscissas of first ends.
+ * \param y0 Ordinates of first ends.
+ * \param x1 Abscissas of second ends.
+ * \param y1 Ordinates of second ends.
+ * \param visible Does ray cross the bounds?
+ */
+void ClipRayArrays(const float* origin_x, const float* origin_y,
+                   const float* direction_x, const float* direction_y,
+                   const size_t size, const Bounds bounds,
+                   float* __restrict x0, float* __restrict y0,
+                   float* __restrict x1, float* __restrict y1,
+                   std::uint8_t* __restrict visible)
+{
+  for (size_t i = 0; i < size; ++i)
+  {
+    const auto px = origin_x[i];
+    const auto py = origin_y[i];
+    const auto dx = direction_x[i];
+    const auto dy = direction_y[i];
+
+    const auto [enter_x, leave_x] =
+        IntersectSlab(px, dx, bounds.left, bounds.right);
+    const auto [enter_y, leave_y] =
+        IntersectSlab(py, dy, bounds.top, bounds.bottom);
+    const auto enter = std::max(0.f, std::max(enter_x, enter_y));
+    const auto leave = std::min(leave_x, leave_y);
+
+    x0[i] = px + enter * dx;
+    y0[i] = py + enter * dy;
+    x1[i] = px + leave * dx;
+    y1[i] = py + leave * dy;
+    visible[i] = ((dx != 0.f) | (dy != 0.f)) & (enter <= leave);
+  }
+}
+}  // namespace
+
+void Lines::Clear()
+{
+  a.clear();
+  b.clear();
+  c.clear();
+}
+
+void Lines::Push(const float a_value, const float b_value,
+                 const float c_value)
+{
+  a.push_back(a_value);
+  b.push_back(b_value);
+  c.push_back(c_value);
+}
+
+size_t Lines::GetSize() const { return a.size(); }
+
+void Rays::Clear()
+{
+  origin_x.clear();
+  origin_y.clear();
+  direction_x.clear();
+  direction_y.clear();
+}
+
+void Rays::Push(const float x, const float y, const float dx, const float dy)
+{
+  origin_x.push_back(x);
+  origin_y.push_back(y);
+  direction_x.push_back(dx);
+  direction_y.push_back(dy);
+}
+
+size_t Rays::GetSize() const { return origin_x.size(); }
+
+void Segments::Resize(const size_t size)
+{
+  x0.resize(size);
+  y0.resize(size);
+  x1.resize(size);
+  y1.resize(size);
+  visible.resize(size);
+}
+
+void ClipLines(const Lines& lines, const Bounds& bounds, Segments& segments)
+{
+  const auto size = lines.GetSize();
+  segments.Resize(size);
+
+  ClipLineArrays(lines.a.data(), lines.b.data(), lines.c.data(), size, bounds,
+                 segments.x0.data(), segments.y0.data(), segments.x1.data(),
+                 segments.y1.data(), segments.visible.data());
+}
+
+void ClipRays(const Rays& rays, const Bounds& bounds, Segments& segments)
+{
+  const auto size = rays.GetSize();
+  segments.Resize(size);
+
+  ClipRayArrays(rays.origin_x.data(), rays.origin_y.data(),
+                rays.direction_x.data(), rays.direction_y.data(), size, bounds,
+                segments.x0.data(), segments.y0.data(), segments.x1.data(),
+                segments.y1.data(), segments.visible.data());
+}
+}  // namespace HomoGebra::Clipping
@@ -0,0 +1,162 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace HomoGebra::Clipping
+{
+/**
+ * \brief Axis-aligned rectangle, which everything is clipped with.
+ */
+struct Bounds
+{
+  float left;    //!< Minimal x.
+  float top;     //!< Minimal y.
+  float right;   //!< Maximal x.
+  float bottom;  //!< Maximal y.
+};
+
+/**
+ * \brief Lines a*x + b*y + c = 0, stored by coefficients.
+ *
+ * \details Every coefficient is kept in its own array, so a kernel reads
+ * them sequentially and compiler may vectorize it.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+struct Lines
+{
+  /**
+   * \brief Removes all lines.
+   */
+  void Clear();
+
+  /**
+   * \brief Adds a line.
+   *
+   * \param a_value Coefficient of x.
+   * \param b_value Coefficient of y.
+   * \param c_value Constant.
+   */
+  void Push(float a_value, float b_value, float c_value);
+
+  /**
+   * \brief Gets amount of lines.
+   *
+   * \return Amount of lines.
+   */
+  [[nodiscard]] size_t GetSize() const;
+
+  /**
+   * Member data.
+   */
+  std::vector<float> a;  //!< Coefficients of x.
+  std::vector<float> b;  //!< Coefficients of y.
+  std::vector<float> c;  //!< Constants.
+};
+
+/**
+ * \brief Rays origin + t * direction, t >= 0.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+struct Rays
+{
+  /**
+   * \brief Removes all rays.
+   */
+  void Clear();
+
+  /**
+   * \brief Adds a ray.
+   *
+   * \param x Abscissa of the origin.
+   * \param y Ordinate of the origin.
+   * \param dx Abscissa of the direction.
+   * \param dy Ordinate of the direction.
+   */
+  void Push(float x, float y, float dx, float dy);
+
+  /**
+   * \brief Gets amount of rays.
+   *
+   * \return Amount of rays.
+   */
+  [[nodiscard]] size_t GetSize() const;
+
+  /**
+   * Member data.
+   */
+  std::vector<float> origin_x;     //!< Abscissas of origins.
+  std::vector<float> origin_y;     //!< Ordinates of origins.
+  std::vector<float> direction_x;  //!< Abscissas of directions.
+  std::vector<float> direction_y;  //!< Ordinates of directions.
+};
+
+/**
+ * \brief Segments, which are results of clipping.
+ *
+ * \details Segment i is meaningful only if visible[i] isn't zero. For a ray
+ * the first end is its origin clipped to the bounds and the second end is
+ * the point, where the ray leaves them.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+struct Segments
+{
+  /**
+   * \brief Sets amount of segments.
+   *
+   * \param size Amount of segments.
+   */
+  void Resize(size_t size);
+
+  /**
+   * Member data.
+   */
+  std::vector<float> x0;  //!< Abscissas of first ends.
+  std::vector<float> y0;  //!< Ordinates of first ends.
+  std::vector<float> x1;  //!< Abscissas of second ends.
+  std::vector<float> y1;  //!< Ordinates of second ends.
+  std::vector<std::uint8_t>
+      visible;  //!< Does segment cross the bounds at all?
+};
+
+/**
+ * \brief Clips lines with a rectangle.
+ *
+ * \details Liang-Barsky algorithm without branches: a line parallel to an
+ * axis gets an infinite or an empty slab instead of a division by zero, so
+ * vertical and horizontal lines are clipped as any other. Line with
+ * a = b = 0 is the line at infinity and isn't visible.
+ *
+ * \param lines Lines to clip.
+ * \param bounds Rectangle to clip with.
+ * \param segments Visible parts of the lines.
+ */
+void ClipLines(const Lines& lines, const Bounds& bounds, Segments& segments);
+
+/**
+ * \brief Clips rays with a rectangle.
+ *
+ * \details Same algorithm as ClipLines(), parameter of rays is bounded
+ * from below by zero. Ray with zero direction isn't visible.
+ *
+ * \param rays Rays to clip.
+ * \param bounds Rectangle to clip with.
+ * \param segments Visible parts of the rays.
+ */
+void ClipRays(const Rays& rays, const Bounds& bounds, Segments& segments);
+}  // namespace HomoGebra::Clipping
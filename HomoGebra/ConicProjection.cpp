@@ -0,0 +1,209 @@
+#include "ConicProjection.h"
+
+#include <array>
+#include <cmath>
+
+#include "Polynomial.h"
+
+namespace HomoGebra::ConicProjection
+{
+namespace
+{
+/**
+ * \brief Finds the nearest of feet, for which I + tM is singular.
+ *
+ * \details If the gradient at the position is orthogonal to an eigenvector v
+ * of M (eigenvalue lambda), feet q = s * v + r * w with t = -1 / lambda are
+ * missed by the quartic. Here w is the other eigenvector (eigenvalue mu),
+ * r = g_w / (lambda - mu) and s is found from the equation of the conic.
+ *
+ * \param conic Conic, which is moved so the position is the origin.
+ *
+ * \return The nearest of such points relative to the position, std::nullopt
+ * if there is none.
+ */
+std::optional<Foot> ProjectOnAxes(const Conic& conic)
+{
+  const auto& [a, b, c, d, e, f] = conic;
+
+  // Eigenvalues of [a b/2; b/2 c]
+  const auto half_sum = (a + c) / 2;
+  const auto radius = std::hypot((a - c) / 2, b / 2);
+  const std::array eigenvalues{half_sum + radius, half_sum - radius};
+
+  std::optional<Foot> nearest;
+  for (size_t index = 0; index < eigenvalues.size(); ++index)
+  {
+    const auto eigenvalue = eigenvalues[index];
+    const auto other = eigenvalues[1 - index];
+    if (eigenvalue == 0) continue;
+
+    // Eigenvector of two forms, the longer one isn't zero
+    auto vector_x = b / 2;
+    auto vector_y = eigenvalue - a;
+    if (std::hypot(eigenvalue - c, b / 2) > std::hypot(vector_x, vector_y))
+    {
+      vector_x = eigenvalue - c;
+      vector_y = b / 2;
+    }
+
+    // Every direction is an axis of a circle
+    auto length = std::hypot(vector_x, vector_y);
+    if (length == 0)
+    {
+      vector_x = index == 0 ? 1 : 0;
+      vector_y = index == 0 ? 0 : 1;
+      length = 1;
+    }
+    vector_x /= length;
+    vector_y /= length;
+
+    // Half of the gradient along v and along w = (-v_y, v_x)
+    const auto along = (d * vector_x + e * vector_y) / 2;
+    const auto across = (e * vector_x - d * vector_y) / 2;
+
+    constexpr long double kAxisTolerance = 1e-9L;
+    if (std::abs(along) > kAxisTolerance * std::hypot(d, e)) continue;
+
+    long double offset = 0;
+    if (across != 0)
+    {
+      if (eigenvalue == other) continue;
+      offset = across / (eigenvalue - other);
+    }
+
+    const auto square =
+        -(other * offset * offset + 2 * across * offset + f) / eigenvalue;
+    if (!(square >= 0)) continue;
+
+    const auto shift = std::sqrt(square);
+    const auto distance = std::hypot(shift, offset);
+    if (!nearest || distance < nearest->distance)
+    {
+      nearest = Foot{shift * vector_x - offset * vector_y,
+                     shift * vector_y + offset * vector_x, distance};
+    }
+  }
+
+  return nearest;
+}
+
+/**
+ * \brief Moves a foot from the position back to the origin.
+ *
+ * \param foot Foot relative to the position.
+ * \param x Abscissa of the position.
+ * \param y Ordinate of the position.
+ *
+ * \return Foot with absolute coordinates.
+ */
+std::optional<Foot> Shift(std::optional<Foot> foot, const long double x,
+                          const long double y)
+{
+  if (foot)
+  {
+    foot->x += x;
+    foot->y += y;
+  }
+  return foot;
+}
+}  // namespace
+
+std::optional<Foot> Project(const Conic& conic, const long double x,
+                            const long double y)
+{
+  // Ax^2 + Bxy + Cy^2 + Dx + Ey + F = 0
+  const auto [a, b, c, linear_x, linear_y, constant] = conic;
+
+  // Move origin to the position, so the foot is just a vector
+  const auto d = 2 * a * x + b * y + linear_x;
+  const auto e = b * x + 2 * c * y + linear_y;
+  const auto f = a * x * x + b * x * y + c * y * y + linear_x * x +
+                 linear_y * y + constant;
+
+  // Quartic misses feet on an axis through the position
+  auto nearest = ProjectOnAxes(Conic{a, b, c, d, e, f});
+
+  // Position is the center of the conic, so the quartic vanishes
+  if (d == 0 && e == 0) return Shift(nearest, x, y);
+
+  /*
+   * Foot q satisfies (I + tM)q = -t*g, where
+   * M = [A   B/2]  g = [D/2]
+   *     [B/2   C]      [E/2]
+   * So q = u(t) / det(t), where u(t) = -t * adj(I + tM) * g.
+   */
+  const Polynomial det{
+      {Complex{1}, Complex{a + c}, Complex{a * c - b * b / 4}}};
+  const Polynomial u_x{
+      {Complex{}, Complex{-d / 2}, Complex{-(c * d / 2 - b * e / 4)}}};
+  const Polynomial u_y{
+      {Complex{}, Complex{-e / 2}, Complex{-(a * e / 2 - b * d / 4)}}};
+
+  // Substitute q into the equation and multiply by det^2
+  const auto quartic =
+      u_x * u_x * Complex{a} + u_x * u_y * Complex{b} + u_y * u_y * Complex{c} +
+      (u_x * Complex{d} + u_y * Complex{e}) * det + det * det * Complex{f};
+
+  auto value = [a, b, c, d, e, f](const long double foot_x,
+                                  const long double foot_y)
+  {
+    return a * foot_x * foot_x + b * foot_x * foot_y + c * foot_y * foot_y +
+           d * foot_x + e * foot_y + f;
+  };
+
+  for (const auto& root : quartic.GetRoots())
+  {
+    // Foot must be real
+    constexpr long double kImaginaryTolerance = 1e-6L;
+    if (std::abs(root.imag()) >
+        kImaginaryTolerance * (1 + std::abs(root.real())))
+    {
+      continue;
+    }
+
+    const Complex t{root.real()};
+
+    const auto denominator = det(t).real();
+    if (denominator == 0) continue;
+
+    auto foot_x = u_x(t).real() / denominator;
+    auto foot_y = u_y(t).real() / denominator;
+
+    /*
+     * Polish foot with Newton's method for system:
+     * Q(q) = 0 (foot is on the conic)
+     * q x grad(Q) = 0 (normal goes through the position)
+     */
+    constexpr size_t kPolishIterations = 3;
+    for (size_t iteration = 0; iteration < kPolishIterations; ++iteration)
+    {
+      const auto gradient_x = 2 * a * foot_x + b * foot_y + d;
+      const auto gradient_y = b * foot_x + 2 * c * foot_y + e;
+
+      const auto on_conic = value(foot_x, foot_y);
+      const auto on_normal = foot_x * gradient_y - foot_y * gradient_x;
+
+      const auto normal_x = gradient_y + foot_x * b - foot_y * 2 * a;
+      const auto normal_y = foot_x * 2 * c - gradient_x - foot_y * b;
+
+      const auto jacobian = gradient_x * normal_y - gradient_y * normal_x;
+      if (jacobian == 0) break;
+
+      foot_x -= (on_conic * normal_y - on_normal * gradient_y) / jacobian;
+      foot_y -= (gradient_x * on_normal - normal_x * on_conic) / jacobian;
+    }
+
+    if (!std::isfinite(foot_x) || !std::isfinite(foot_y)) continue;
+
+    const auto distance = std::hypot(foot_x, foot_y);
+
+    if (!nearest || distance < nearest->distance)
+    {
+      nearest = Foot{foot_x, foot_y, distance};
+    }
+  }
+
+  return Shift(nearest, x, y);
+}
+}  // namespace HomoGebra::ConicProjection
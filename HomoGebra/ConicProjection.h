@@ -0,0 +1,63 @@
+#pragma once
+#include <optional>
+
+namespace HomoGebra::ConicProjection
+{
+/**
+ * \brief Real conic a*x^2 + b*x*y + c*y^2 + d*x + e*y + f = 0.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+struct Conic
+{
+  long double a;  //!< Coefficient of x^2.
+  long double b;  //!< Coefficient of x*y.
+  long double c;  //!< Coefficient of y^2.
+  long double d;  //!< Coefficient of x.
+  long double e;  //!< Coefficient of y.
+  long double f;  //!< Constant.
+};
+
+/**
+ * \brief The nearest point of a conic.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+struct Foot
+{
+  long double x;         //!< Abscissa of the foot.
+  long double y;         //!< Ordinate of the foot.
+  long double distance;  //!< Distance from the position to the foot.
+};
+
+/**
+ * \brief Finds the nearest point of a conic.
+ *
+ * \details The nearest point q satisfies q - p + t * grad(q) / 2 = 0,
+ * which gives q as a rational function of t. Substitution into the
+ * equation of the conic gives a quartic in t. Real roots of the quartic are
+ * polished by Newton's method and the nearest foot is taken.
+ *
+ * If the position lies on an axis of the conic, some feet are at t where
+ * q can't be found from the equation above, so they are found on the line
+ * through the position parallel to the other axis. At the center the
+ * quartic vanishes and only such feet are left.
+ *
+ * \param conic Conic.
+ * \param x Abscissa of the position.
+ * \param y Ordinate of the position.
+ *
+ * \return The nearest point, std::nullopt if the conic has no real points
+ * or the quartic degenerates.
+ */
+[[nodiscard]] std::optional<Foot> Project(const Conic& conic, long double x,
+                                          long double y);
+}  // namespace HomoGebra::ConicProjection
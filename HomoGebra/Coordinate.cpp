@@ -33,8 +33,17 @@ std::optional<TransformationMatrix> TransformationMatrix::GetInverse() const
   // Compute the determinant
   const auto det = Determinant();
 
+  // Determinant is compared with the product of lengths of rows, which
+  // bounds it, so scale of the matrix doesn't matter
+  long double bound = 1;
+  for (const auto& row : matrix_)
+  {
+    bound *= std::sqrt(std::norm(row[0]) + std::norm(row[1]) +
+                       std::norm(row[2]));
+  }
+
   // Compute the inverse if the determinant is not zero
-  if (det == Complex{0}) return std::nullopt;
+  if (bound == 0 || (det / Complex{bound}).IsZero()) return std::nullopt;
 
   // Return the inverse
   return TransformationMatrix(
@@ -135,6 +144,24 @@ Transformation::Transformation(
     const PointEquation& first_image, const PointEquation& second_image,
     const PointEquation& third_image,
     const PointEquation& fourth_image) noexcept(false)
+{
+  const auto transformation =
+      Fit(first_preimage, second_preimage, third_preimage, fourth_preimage,
+          first_image, second_image, third_image, fourth_image);
+
+  // Check if transformation exists
+  Assert(transformation.has_value(),
+         "Matrix has no solution (no suitable transform)!");
+
+  // Init transformation
+  transformation_ = transformation->transformation_;
+}
+
+std::optional<Transformation> Transformation::Fit(
+    const PointEquation& first_preimage, const PointEquation& second_preimage,
+    const PointEquation& third_preimage, const PointEquation& fourth_preimage,
+    const PointEquation& first_image, const PointEquation& second_image,
+    const PointEquation& third_image, const PointEquation& fourth_image)
 {
   // Get equation of all images and preimages
   auto& first_preimage_equation = first_preimage.GetEquation();
@@ -210,7 +237,8 @@ Transformation::Transformation(
            second_preimage_equation.z, 0, 0, 0, 0, 0, 0, 0,
            -second_image_equation.x, 0},
           {0, 0, 0, second_preimage_equation.x, second_preimage_equation.y,
-           second_image_equation.z, 0, 0, 0, 0, -second_image_equation.y, 0},
+           second_preimage_equation.z, 0, 0, 0, 0, -second_image_equation.y,
+           0},
           {0, 0, 0, 0, 0, 0, second_preimage_equation.x,
            second_preimage_equation.y, second_preimage_equation.z, 0,
            -second_image_equation.z, 0},
@@ -242,14 +270,17 @@ Transformation::Transformation(
   const auto solution = matrix.GetSolution();
 
   // Check if solution exists
-  Assert(solution.has_value(),
-         "Matrix has no solution (no suitable transform)!");
+  if (!solution) return std::nullopt;
 
-  // Init transformation
-  transformation_ = TransformationMatrix(
+  const TransformationMatrix transformation(
       solution.value()[0], solution.value()[1], solution.value()[2],
       solution.value()[3], solution.value()[4], solution.value()[5],
       solution.value()[6], solution.value()[7], solution.value()[8]);
+
+  // If three preimages are on a line, solution maps them to a point
+  if (!transformation.GetInverse()) return std::nullopt;
+
+  return Transformation(transformation);
 }
 
 std::optional<Transformation> Transformation::GetInverse() const
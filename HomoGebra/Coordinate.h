@@ -171,6 +171,29 @@ class Transformation
       const PointEquation& first_image, const PointEquation& second_image,
       const PointEquation& third_image, const PointEquation& fourth_image);
 
+  /**
+   * \brief Finds transformation from movement of 4 points.
+   *
+   * \details Unlike the constructor, doesn't assert if points degenerate, so
+   * points may come from the user.
+   *
+   * \param first_preimage First point preimage position
+   * \param second_preimage Second point preimage position
+   * \param third_preimage Third point preimage position
+   * \param fourth_preimage Fourth point preimage position
+   * \param first_image First point image position
+   * \param second_image Second point image position
+   * \param third_image Third point image position
+   * \param fourth_image Fourth point image position
+   *
+   * \return Transformation or std::nullopt if points degenerate.
+   */
+  [[nodiscard]] static std::optional<Transformation> Fit(
+      const PointEquation& first_preimage, const PointEquation& second_preimage,
+      const PointEquation& third_preimage, const PointEquation& fourth_preimage,
+      const PointEquation& first_image, const PointEquation& second_image,
+      const PointEquation& third_image, const PointEquation& fourth_image);
+
   /**
    * \brief Calculate inverse of transformation.
    *
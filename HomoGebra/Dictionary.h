@@ -60,26 +60,15 @@ bool Dictionary<Item>::AddItem(const Item& item)
 template <class Item>
 bool Dictionary<Item>::DeleteItem(const Item& item)
 {
-  // Check if item is used
-  if (!used_items_.count(item))
-  {
-    return false;
-  }
-
-  // Delete item
-  return used_items_.erase(item);
+  // Delete item if it is used
+  return used_items_.erase(item) > 0;
 }
 
 template <class Item>
 bool Dictionary<Item>::IsItemUsed(const Item& item) const
 {
   // Check if item is used
-  if (!used_items_.count(item))
-  {
-    return false;
-  }
-
-  // Check if sub item is used
-  return used_items_.at(item);
+  const auto found = used_items_.find(item);
+  return found != used_items_.end() && found->second;
 }
 }  // namespace HomoGebra
\ No newline at end of file
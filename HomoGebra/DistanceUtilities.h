@@ -1,11 +1,21 @@
 #pragma once
 #include <SFML/System/Vector2.hpp>
+#include <algorithm>
 #include <cmath>
 
 namespace HomoGebra
 {
 using Distance = float;
 
+/**
+ * \brief The nearest point of an object to some position.
+ */
+struct Projection
+{
+  sf::Vector2f foot;  //!< The nearest point of the object.
+  Distance distance;  //!< Distance from the position to the foot.
+};
+
 inline Distance Length(const sf::Vector2f& vector)
 {
   return std::hypot(vector.x, vector.y);
@@ -17,4 +27,22 @@ inline Distance DistanceToLine(const sf::Vector2f& position, const float a,
   return std::abs(a * position.x + b * position.y + c) /
          (std::sqrt(a * a + b * b));
 }
+
+inline Distance DistanceToSegment(const sf::Vector2f& position,
+                                  const sf::Vector2f& from,
+                                  const sf::Vector2f& to)
+{
+  const auto direction = to - from;
+  const auto squared_length =
+      direction.x * direction.x + direction.y * direction.y;
+  if (squared_length == 0.f) return Length(position - from);
+
+  // Parameter of the nearest point, which is clamped to the segment
+  const auto offset = position - from;
+  const auto parameter = std::clamp(
+      (offset.x * direction.x + offset.y * direction.y) / squared_length, 0.f,
+      1.f);
+
+  return Length(offset - direction * parameter);
+}
 }  // namespace HomoGebra
\ No newline at end of file
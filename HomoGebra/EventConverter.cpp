@@ -19,29 +19,72 @@ void EventConverter::Update(const sf::Event& event)
   actionMap_.invokeCallbacks(system_, window_);
 }
 
+void EventConverter::Flush()
+{
+  if (!drag_position_) return;
+
+  Notify(UserEvent::Drag{drag_position_.value()});
+  drag_position_.reset();
+}
+
 void EventConverter::InitActionMap()
 {
   actionMap_[Action::Click] =
       thor::Action{sf::Mouse::Left, thor::Action::PressOnce};
   actionMap_[Action::Unclick] =
       thor::Action{sf::Mouse::Left, thor::Action::ReleaseOnce};
+  actionMap_[Action::Move] = thor::Action{sf::Event::MouseMoved};
 }
 void EventConverter::InitCallbackSystem()
 {
   system_.connect(Action::Click, [this](ActionContext context)
                   { OnClick(std::move(context)); });
+  system_.connect(Action::Unclick, [this](ActionContext context)
+                  { OnUnclick(std::move(context)); });
+  system_.connect(Action::Move, [this](ActionContext context)
+                  { OnMove(std::move(context)); });
 }
 
-void EventConverter::OnClick(ActionContext context) const
+void EventConverter::OnClick(ActionContext context)
 {
   const auto& [window, event, action_id] = context;
   Assert(action_id == Action::Click);
-  Assert(dynamic_cast<sf::RenderWindow*>(window));
+  Assert(window == window_);
+
+  // Click may miss by a few pixels at any zoom
+  const auto tolerance = kClickTolerance * window_->getView().getSize().x /
+                         static_cast<float>(window_->getSize().x);
+
+  is_pressed_ = true;
+  Notify(UserEvent::Click{MapPixel(event->mouseButton.x, event->mouseButton.y),
+                          tolerance});
+}
+
+void EventConverter::OnUnclick(ActionContext context)
+{
+  const auto& [window, event, action_id] = context;
+  Assert(action_id == Action::Unclick);
 
-  auto click_position =
-      static_cast<sf::RenderWindow*>(window)->mapPixelToCoords(
-          sf::Vector2i{event->mouseButton.x, event->mouseButton.y});
+  // Drag is finished before the release
+  Flush();
 
-  Notify(UserEvent::Click{click_position});
+  is_pressed_ = false;
+  Notify(
+      UserEvent::Unclick{MapPixel(event->mouseButton.x, event->mouseButton.y)});
+}
+
+void EventConverter::OnMove(ActionContext context)
+{
+  const auto& [window, event, action_id] = context;
+  Assert(action_id == Action::Move);
+
+  if (!is_pressed_) return;
+
+  drag_position_ = MapPixel(event->mouseMove.x, event->mouseMove.y);
+}
+
+sf::Vector2f EventConverter::MapPixel(const int x, const int y) const
+{
+  return window_->mapPixelToCoords(sf::Vector2i{x, y});
 }
 }  // namespace HomoGebra
\ No newline at end of file
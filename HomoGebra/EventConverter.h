@@ -1,6 +1,7 @@
 #pragma once
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <Thor/Input.hpp>
+#include <optional>
 
 #include "EventNotifier.h"
 
@@ -31,16 +32,28 @@ class EventConverter : public EventNotifier
    */
   void Update(const sf::Event& event);
 
+  /**
+   * @brief Notifies about the latest drag since the previous flush.
+   *
+   * Moves of the mouse are coalesced, so listeners get at most one drag per
+   * flush, e.g. per frame, always with the latest position.
+   */
+  void Flush();
+
   /**
    * @brief The Action enum class represents the custom actions that can be
    * triggered by events.
    */
   enum class Action
   {
-    Click,  /**< Represents a click action. */
-    Unclick /**< Represents an unclick action. */
+    Click,   /**< Represents a click action. */
+    Unclick, /**< Represents an unclick action. */
+    Move     /**< Represents a move of the mouse. */
   };
 
+  static constexpr float kClickTolerance =
+      8.f; /**< Distance in pixels, which a click may miss by. */
+
  private:
   using ActionMap = thor::ActionMap<Action>;
   using ActionContext = thor::ActionContext<Action>;
@@ -61,11 +74,38 @@ class EventConverter : public EventNotifier
    *
    * @param context The action context for the click action.
    */
-  void OnClick(ActionContext context) const;
+  void OnClick(ActionContext context);
+
+  /**
+   * @brief Handles the unclick action.
+   *
+   * @param context The action context for the unclick action.
+   */
+  void OnUnclick(ActionContext context);
+
+  /**
+   * @brief Handles the move action, which is a drag if the button is pressed.
+   *
+   * @param context The action context for the move action.
+   */
+  void OnMove(ActionContext context);
+
+  /**
+   * @brief Maps a pixel of the window to the plane.
+   *
+   * @param x Horizontal coordinate of the pixel.
+   * @param y Vertical coordinate of the pixel.
+   *
+   * @return Position on the plane.
+   */
+  [[nodiscard]] sf::Vector2f MapPixel(int x, int y) const;
 
   ActionMap actionMap_; /**< The action map for handling custom actions. */
   CallbackSystem
       system_; /**< The callback system for handling custom actions. */
   sf::RenderWindow* window_; /**< A pointer to the SFML render window. */
+  bool is_pressed_ = false;  /**< Is the button pressed after a click? */
+  std::optional<sf::Vector2f>
+      drag_position_; /**< The latest position of a drag, which isn't sent. */
 };
 }  // namespace HomoGebra
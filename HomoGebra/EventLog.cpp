@@ -0,0 +1,102 @@
+#include "EventLog.h"
+
+#include <thread>
+#include <type_traits>
+
+namespace HomoGebra
+{
+static_assert(std::is_trivially_copyable_v<EventRecord>,
+              "Records are written as they are in memory");
+
+EventRecorder::EventRecorder(const std::filesystem::path& path)
+    : output_(path, std::ios::binary)
+{
+  const EventLogHeader header;
+  output_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+bool EventRecorder::IsGood() const { return output_.good(); }
+
+void EventRecorder::Record(const sf::Event& event)
+{
+  EventRecord record{};
+  record.kind = EventRecord::Kind::kEvent;
+  record.event = event;
+  Write(record);
+}
+
+void EventRecorder::EndFrame(const float frame_time)
+{
+  EventRecord record{};
+  record.kind = EventRecord::Kind::kFrame;
+  record.frame_time = frame_time;
+  Write(record);
+}
+
+void EventRecorder::Write(EventRecord record)
+{
+  record.time = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                            start_)
+          .count());
+  output_.write(reinterpret_cast<const char*>(&record), sizeof(record));
+}
+
+EventPlayer::EventPlayer(const std::filesystem::path& path, const Speed speed)
+    : input_(path, std::ios::binary), speed_(speed)
+{
+  EventLogHeader header;
+  if (!input_.read(reinterpret_cast<char*>(&header), sizeof(header))) return;
+
+  const EventLogHeader expected;
+  is_good_ = header.magic == expected.magic &&
+             header.version == expected.version &&
+             header.record_size == expected.record_size;
+  if (!is_good_) return;
+
+  next_ = Take();
+}
+
+bool EventPlayer::IsGood() const { return is_good_; }
+
+bool EventPlayer::IsFinished() const { return !next_.has_value(); }
+
+bool EventPlayer::PollEvent(sf::Event& event)
+{
+  // Frame record isn't taken, so the frame ends only in EndFrame()
+  if (!next_ || next_->kind != EventRecord::Kind::kEvent) return false;
+
+  event = next_->event;
+  next_ = Take();
+  return true;
+}
+
+float EventPlayer::EndFrame()
+{
+  while (next_ && next_->kind == EventRecord::Kind::kEvent)
+  {
+    next_ = Take();
+  }
+  if (!next_) return 0.f;
+
+  // Events of a frame were taken at once, so only ends of frames are timed
+  if (speed_ == Speed::kRecorded)
+  {
+    std::this_thread::sleep_until(start_ +
+                                  std::chrono::microseconds(next_->time));
+  }
+
+  const auto frame_time = next_->frame_time;
+  next_ = Take();
+  return frame_time;
+}
+
+std::optional<EventRecord> EventPlayer::Take()
+{
+  EventRecord record;
+  if (!input_.read(reinterpret_cast<char*>(&record), sizeof(record)))
+    return std::nullopt;
+
+  return record;
+}
+}  // namespace HomoGebra
@@ -0,0 +1,198 @@
+#pragma once
+#include <SFML/Window/Event.hpp>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+
+namespace HomoGebra
+{
+/**
+ * \brief Record of an event log.
+ *
+ * \details Log is a header followed by records. Every frame is written as
+ * its events followed by a frame record. Event is written as it is in
+ * memory, so a log can be replayed only by the same build of the
+ * application.
+ */
+struct EventRecord
+{
+  /**
+   * \brief Kind of a record.
+   */
+  enum class Kind : std::uint32_t
+  {
+    kEvent,  //!< Event of the window.
+    kFrame   //!< End of a frame.
+  };
+
+  std::uint64_t time;  //!< Microseconds since the start of recording.
+  Kind kind;           //!< Kind of the record.
+  float frame_time;    //!< Duration of the frame in seconds, frame only.
+  sf::Event event;     //!< Event of the window, event only.
+};
+
+/**
+ * \brief Header of an event log.
+ */
+struct EventLogHeader
+{
+  static constexpr std::array<char, 4> kMagic{'H', 'G', 'E', 'V'};  //!< Tag.
+  static constexpr std::uint32_t kVersion = 1;  //!< Version of the format.
+
+  std::array<char, 4> magic = kMagic;  //!< Tag of the format.
+  std::uint32_t version = kVersion;    //!< Version of the format.
+  std::uint32_t record_size =
+      sizeof(EventRecord);  //!< Size of a record, it depends on the build.
+};
+
+/**
+ * \brief Writes events of the window frame by frame.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see EventPlayer
+ */
+class EventRecorder
+{
+ public:
+  /**
+   * \brief Creates log.
+   *
+   * \param path Path to the log.
+   */
+  explicit EventRecorder(const std::filesystem::path& path);
+
+  /**
+   * \brief Checks if log is written without errors.
+   *
+   * \return True if log is good.
+   */
+  [[nodiscard]] bool IsGood() const;
+
+  /**
+   * \brief Writes event of the current frame.
+   *
+   * \param event Event, which the application has taken.
+   */
+  void Record(const sf::Event& event);
+
+  /**
+   * \brief Writes end of the current frame.
+   *
+   * \param frame_time Duration of the frame in seconds, which the
+   * application has used.
+   */
+  void EndFrame(float frame_time);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * \brief Writes record stamped with the current time.
+   *
+   * \param record Record to write.
+   */
+  void Write(EventRecord record);
+
+  /**
+   * Member data.
+   */
+  std::ofstream output_;                    //!< Log.
+  Clock::time_point start_ = Clock::now();  //!< Start of recording.
+};
+
+/**
+ * \brief Reads events of a log frame by frame.
+ *
+ * \details Application takes events of a frame with PollEvent() instead of
+ * the window, then ends the frame with EndFrame(), which gives the recorded
+ * duration of the frame. So everything, which depends only on events and
+ * durations of frames, happens as it was recorded.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see EventRecorder
+ */
+class EventPlayer
+{
+ public:
+  /**
+   * \brief Speed of the replay.
+   */
+  enum class Speed
+  {
+    kRecorded,  //!< Records are given at the time they were recorded.
+    kMaximal    //!< Records are given without waiting.
+  };
+
+  /**
+   * \brief Opens log.
+   *
+   * \param path Path to the log.
+   * \param speed Speed of the replay.
+   */
+  EventPlayer(const std::filesystem::path& path, Speed speed);
+
+  /**
+   * \brief Checks if log is opened and was written by this build.
+   *
+   * \return True if log can be replayed.
+   */
+  [[nodiscard]] bool IsGood() const;
+
+  /**
+   * \brief Checks if all frames are replayed.
+   *
+   * \return True if log has ended.
+   */
+  [[nodiscard]] bool IsFinished() const;
+
+  /**
+   * \brief Takes the next event of the current frame.
+   *
+   * \param event Event to write to.
+   *
+   * \return False if the frame has no more events.
+   */
+  bool PollEvent(sf::Event& event);
+
+  /**
+   * \brief Skips events, which weren't taken, and ends the frame.
+   *
+   * \details At the recorded speed waits until the time the frame has ended.
+   *
+   * \return Recorded duration of the frame in seconds.
+   */
+  float EndFrame();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * \brief Reads the next record.
+   *
+   * \return Record or std::nullopt if log has ended.
+   */
+  std::optional<EventRecord> Take();
+
+  /**
+   * Member data.
+   */
+  std::ifstream input_;                     //!< Log.
+  Speed speed_;                             //!< Speed of the replay.
+  bool is_good_ = false;                    //!< Is header right?
+  std::optional<EventRecord> next_;         //!< Record to give next.
+  Clock::time_point start_ = Clock::now();  //!< Start of the replay.
+};
+}  // namespace HomoGebra
@@ -27,4 +27,8 @@ void EventNotifier::Notify(const Event& event) const
 
 template void EventNotifier::Notify<UserEvent::Click>(
     const UserEvent::Click& event) const;
+template void EventNotifier::Notify<UserEvent::Drag>(
+    const UserEvent::Drag& event) const;
+template void EventNotifier::Notify<UserEvent::Unclick>(
+    const UserEvent::Unclick& event) const;
 }  // namespace HomoGebra
\ No newline at end of file
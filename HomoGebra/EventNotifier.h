@@ -12,8 +12,20 @@ namespace UserEvent
 struct Click
 {
   sf::Vector2f position;  //!< Position of the click.
+  float tolerance{};      //!< Distance on the plane, which a click may miss by.
 };
 
+/**
+ * \brief Tag that shows that user moved the mouse with the button pressed.
+ */
+struct Drag
+{
+  sf::Vector2f position;  //!< The latest position of the mouse.
+};
+
+/**
+ * \brief Tag that shows that user released the button.
+ */
 struct Unclick
 {
   sf::Vector2f position;  //!< Position of the unclick.
@@ -44,6 +56,20 @@ class EventListener
    * \see UserEvent::clicked_event
    */
   virtual void Update(const UserEvent::Click& clicked_event) = 0;
+
+  /**
+   * \brief Update, because user dragged the mouse after a click.
+   *
+   * \param drag_event Tag with the latest position.
+   */
+  virtual void Update(const UserEvent::Drag& drag_event) = 0;
+
+  /**
+   * \brief Update, because user released the button.
+   *
+   * \param unclick_event Tag with the position.
+   */
+  virtual void Update(const UserEvent::Unclick& unclick_event) = 0;
 };
 
 /**
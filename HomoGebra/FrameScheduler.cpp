@@ -0,0 +1,31 @@
+#include "FrameScheduler.h"
+
+#include <algorithm>
+
+namespace HomoGebra
+{
+void FrameScheduler::Invalidate(const Source source, const size_t frames)
+{
+  auto& source_frames = frames_[static_cast<size_t>(source)];
+  source_frames = std::max(source_frames, frames);
+}
+
+bool FrameScheduler::IsInvalid() const
+{
+  return std::ranges::any_of(frames_,
+                             [](const size_t frames) { return frames > 0; });
+}
+
+bool FrameScheduler::IsInvalid(const Source source) const
+{
+  return frames_[static_cast<size_t>(source)] > 0;
+}
+
+void FrameScheduler::EndFrame()
+{
+  for (auto& frames : frames_)
+  {
+    if (frames > 0) --frames;
+  }
+}
+}  // namespace HomoGebra
@@ -0,0 +1,72 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+namespace HomoGebra
+{
+/**
+ * \brief Decides whether the next frame should be drawn.
+ *
+ * \details Frame is valid until something, which is drawn, changes. Each
+ * source of changes invalidates the frame for as many frames as it needs to
+ * be shown, e.g. ImGui needs a few frames to settle after an input. While
+ * the frame is valid, the loop doesn't draw and waits for an event instead.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+class FrameScheduler
+{
+ public:
+  /**
+   * \brief Source of changes.
+   */
+  enum class Source
+  {
+    kInput,   //!< Event of the window.
+    kScene,   //!< New snapshot of the plane.
+    kCamera,  //!< Animation of the camera.
+    kGui      //!< Settling of ImGui.
+  };
+
+  /**
+   * \brief Invalidates frames.
+   *
+   * \param source Source of the change.
+   * \param frames Amount of the next frames to draw.
+   */
+  void Invalidate(Source source, size_t frames = 1);
+
+  /**
+   * \brief Checks if the next frame should be drawn.
+   *
+   * \return True if any source has invalidated it.
+   */
+  [[nodiscard]] bool IsInvalid() const;
+
+  /**
+   * \brief Checks if a source has invalidated the next frame.
+   *
+   * \param source Source of changes.
+   *
+   * \return True if the source needs the next frame.
+   */
+  [[nodiscard]] bool IsInvalid(Source source) const;
+
+  /**
+   * \brief Marks, that a frame is drawn.
+   */
+  void EndFrame();
+
+ private:
+  static constexpr size_t kSourceCount = 4;  //!< Amount of sources.
+
+  /**
+   * Member data.
+   */
+  std::array<size_t, kSourceCount> frames_{};  //!< Frames to draw by source.
+};
+}  // namespace HomoGebra
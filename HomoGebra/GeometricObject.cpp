@@ -1,6 +1,5 @@
 #include "GeometricObject.h"
 
-#include <numbers>
 #include <utility>
 
 #include "Equation.h"
@@ -41,11 +40,6 @@ const PointEquation& Point::GetEquation() const
   return implementation_.GetEquation();
 }
 
-Distance Point::GetDistance(const sf::Vector2f& position) const
-{
-  return body_.GetDistance(position);
-}
-
 void Point::Attach(GeometricObjectObserver* observer)
 {
   // Call implementation method
@@ -57,24 +51,17 @@ void Point::Detach(const GeometricObjectObserver* observer)
   implementation_.Detach(observer);
 }
 
-void Point::UpdateBody(const sf::RenderTarget& target)
-{
-  // Update body
-  body_.Update(target, implementation_.GetEquation());
-}
-
-void Point::draw(sf::RenderTarget& target, sf::RenderStates states) const
+const std::list<GeometricObjectObserver*>& Point::GetObservers() const
 {
-  // Draw body
-  target.draw(body_, states);
+  return implementation_.GetObservers();
 }
 
 void Point::SetName(std::string name)
 {
-  const ObjectEvent::Renamed renamed{this, body_.GetName(), name};
+  const ObjectEvent::Renamed renamed{this, name_, name};
 
-  // Set name in body
-  body_.SetName(std::move(name));
+  // Set name
+  name_ = std::move(name);
 
   // Notify observers that object was renamed
   Notify(renamed);
@@ -83,7 +70,7 @@ void Point::SetName(std::string name)
 const std::string& Point::GetName() const
 {
   // Return name
-  return body_.GetName();
+  return name_;
 }
 
 Line::Line(LineEquation equation) : implementation_(std::move(equation)) {}
@@ -106,24 +93,12 @@ const LineEquation& Line::GetEquation() const
   return implementation_.GetEquation();
 }
 
-void Line::UpdateBody(const sf::RenderTarget& target)
-{
-  // Update body
-  body_.Update(implementation_.GetEquation());
-}
-
-void Line::draw(sf::RenderTarget& target, sf::RenderStates states) const
-{
-  // Draw body
-  target.draw(body_, states);
-}
-
 void Line::SetName(std::string name)
 {
-  const ObjectEvent::Renamed renamed{this, body_.GetName(), name};
+  const ObjectEvent::Renamed renamed{this, name_, name};
 
-  // Set name in body
-  body_.SetName(std::move(name));
+  // Set name
+  name_ = std::move(name);
 
   // Notify observers that object was renamed
   Notify(renamed);
@@ -132,7 +107,7 @@ void Line::SetName(std::string name)
 const std::string& Line::GetName() const
 {
   // Return name
-  return body_.GetName();
+  return name_;
 }
 
 void Line::Attach(GeometricObjectObserver* observer)
@@ -146,11 +121,6 @@ void Line::Detach(const GeometricObjectObserver* observer)
   implementation_.Detach(observer);
 }
 
-Distance Line::GetDistance(const sf::Vector2f& position) const
-{
-  return body_.GetDistance(position);
-}
-
 template <class Event>
 void Line::Notify(const Event& event) const
 {
@@ -178,24 +148,18 @@ void Conic::SetEquation(ConicEquation equation)
   implementation_.SetEquation(std::move(equation));
 }
 
-void Conic::UpdateBody(const sf::RenderTarget& target)
-{
-  // Update body
-  body_.Update(target, implementation_.GetEquation());
-}
-
-void Conic::draw(sf::RenderTarget& target, sf::RenderStates states) const
+const ConicEquation& Conic::GetEquation() const
 {
-  // Draw body
-  target.draw(body_, states);
+  // Return equation
+  return implementation_.GetEquation();
 }
 
 void Conic::SetName(std::string name)
 {
-  const ObjectEvent::Renamed renamed{this, body_.GetName(), name};
+  const ObjectEvent::Renamed renamed{this, name_, name};
 
-  // Set name in body
-  body_.SetName(std::move(name));
+  // Set name
+  name_ = std::move(name);
 
   // Notify observers that object was renamed
   Notify(renamed);
@@ -204,7 +168,7 @@ void Conic::SetName(std::string name)
 const std::string& Conic::GetName() const
 {
   // Return name
-  return body_.GetName();
+  return name_;
 }
 
 void Conic::Attach(GeometricObjectObserver* observer)
@@ -217,11 +181,6 @@ void Conic::Detach(const GeometricObjectObserver* observer)
   implementation_.Detach(observer);
 }
 
-Distance Conic::GetDistance(const sf::Vector2f& position) const
-{
-  return body_.GetDistance(position);
-}
-
 template <class Event>
 void Conic::Notify(const Event& event) const
 {
@@ -234,4 +193,4 @@ template void Conic::Notify<ObjectEvent::GoingToBeDestroyed>(
 
 template void Conic::Notify<ObjectEvent::Renamed>(
     const ObjectEvent::Renamed& event) const;
-}  // namespace HomoGebra
\ No newline at end of file
+}  // namespace HomoGebra
@@ -1,8 +1,7 @@
 #pragma once
+#include <list>
+#include <string>
 
-#include <SFML/Graphics.hpp>
-
-#include "GeometricObjectBody.h"
 #include "GeometricObjectImplementation.h"
 #include "PlaneImplementation.h"
 
@@ -11,6 +10,9 @@ namespace HomoGebra
 /**
  * \brief Base class for geometric objects.
  *
+ * \details Objects know only their equations and names. They are drawn by
+ * views of the plane, which observe them.
+ *
  * \author nook0110
  *
  * \version 1.0
@@ -21,8 +23,7 @@ namespace HomoGebra
  * \see Line
  * \see Conic
  */
-class GeometricObject : public sf::Drawable,
-                        public ObservableInterface<GeometricObjectObserver>
+class GeometricObject : public ObservableInterface<GeometricObjectObserver>
 {
  public:
   /**
@@ -36,22 +37,6 @@ class GeometricObject : public sf::Drawable,
    */
   virtual void AlertDestruction() const = 0;
 
-  /**
-   * \brief Update the body of the object.
-   *
-   * \param target Render target to draw to.
-   */
-  virtual void UpdateBody(const sf::RenderTarget& target) = 0;
-
-  /**
-   * \brief Draw the point.
-   *
-   * \param target Render target to draw to.
-   * \param states Current render states.
-   */
-  void draw(sf::RenderTarget& target,
-            sf::RenderStates states) const override = 0;
-
   /**
    * \brief Sets new name of object.
    *
@@ -66,16 +51,6 @@ class GeometricObject : public sf::Drawable,
    */
   [[nodiscard]] virtual const std::string& GetName() const = 0;
 
-  /**
-   * \brief Gets distance from object to position.
-   *
-   * \param position Position to calculate distance.
-   *
-   * \return Distance from object to position.
-   */
-  [[nodiscard]] virtual Distance GetDistance(
-      const sf::Vector2f& position) const = 0;
-
  protected:
   /**
    * \brief Default constructor.
@@ -92,7 +67,6 @@ class GeometricObject : public sf::Drawable,
  *
  * \date February 2023
  *
- * \see PointBody
  * \see PointImplementation
  */
 class Point final : public GeometricObject
@@ -137,34 +111,24 @@ class Point final : public GeometricObject
    */
   [[nodiscard]] const PointEquation& GetEquation() const;
 
-  [[nodiscard]] Distance GetDistance(
-      const sf::Vector2f& position) const override;
-
   void Attach(GeometricObjectObserver* observer) override;
 
   void Detach(const GeometricObjectObserver* observer) override;
-  ///@}
-
-  /**
-   *  \brief Body interface.
-   */
-  ///@{
-  /* */
 
   /**
-   * \brief Update the body of the point.
+   * \brief Gets observers of point.
    *
-   * \param target Render target to draw to.
+   * \return Observers in order of attachment.
    */
-  void UpdateBody(const sf::RenderTarget& target) override;
+  [[nodiscard]] const std::list<GeometricObjectObserver*>& GetObservers()
+      const;
+  ///@}
 
   /**
-   * \brief Draw the point.
-   *
-   * \param target Render target to draw to.
-   * \param states Current render states.
+   *  \brief Name interface.
    */
-  void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+  ///@{
+  /* */
 
   /**
    * \brief Sets new name of object.
@@ -194,13 +158,10 @@ class Point final : public GeometricObject
   /*
    * Member data
    */
-  PointBody body_;                      //!< Body, which you can draw.
   PointImplementation implementation_;  //!< Implementation.
+  std::string name_;                    //!< Name of the point.
 };
 
-class LineImplementation;
-class LineBody;
-
 /**
  * \brief Line on a plane.
  *
@@ -210,7 +171,6 @@ class LineBody;
  *
  * \date February 2023
  *
- * \see LineBody
  * \see LineImplementation
  */
 class Line final : public GeometricObject
@@ -248,21 +208,6 @@ class Line final : public GeometricObject
    */
   [[nodiscard]] const LineEquation& GetEquation() const;
 
-  /**
-   * \brief Update the body of the line.
-   *
-   * \param target Render target to draw to.
-   */
-  void UpdateBody(const sf::RenderTarget& target) override;
-
-  /**
-   * \brief Draw the line.
-   *
-   * \param target Render target to draw to.
-   * \param states Current render states.
-   */
-  void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
-
   /**
    * \brief Sets new name of object.
    *
@@ -286,9 +231,6 @@ class Line final : public GeometricObject
 
   void Detach(const GeometricObjectObserver* observer) override;
 
-  [[nodiscard]] Distance GetDistance(
-      const sf::Vector2f& position) const override;
-
  private:
   /**
    * \brief Notify observers about event.
@@ -302,13 +244,10 @@ class Line final : public GeometricObject
   /*
    * Member data
    */
-  LineBody body_;                      //!< Body, which you can draw.
   LineImplementation implementation_;  //!< Implementation.
+  std::string name_;                   //!< Name of the line.
 };
 
-class ConicImplementation;
-class ConicBody;
-
 /**
  * \brief Conic on a plane.
  *
@@ -318,7 +257,6 @@ class ConicBody;
  *
  * \date February 2023
  *
- * \see ConicBody
  * \see ConicImplementation
  */
 class Conic final : public GeometricObject
@@ -345,19 +283,11 @@ class Conic final : public GeometricObject
   void SetEquation(ConicEquation equation);
 
   /**
-   * \brief Update the body of the conic.
+   * \brief Return current equation of conic.
    *
-   * \param target Render target to draw to.
+   * \return Equation of conic.
    */
-  void UpdateBody(const sf::RenderTarget& target) override;
-
-  /**
-   * \brief Draw the conic.
-   *
-   * \param target Render target to draw to.
-   * \param states Current render states.
-   */
-  void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+  [[nodiscard]] const ConicEquation& GetEquation() const;
 
   /**
    * \brief Sets new name of object.
@@ -382,9 +312,6 @@ class Conic final : public GeometricObject
 
   void Detach(const GeometricObjectObserver* observer) override;
 
-  [[nodiscard]] Distance GetDistance(
-      const sf::Vector2f& position) const override;
-
  private:
   /**
    * \brief Notify observers about event.
@@ -398,7 +325,7 @@ class Conic final : public GeometricObject
   /*
    * Member data
    */
-  ConicBody body_;                      //!< Body, which you can draw.
   ConicImplementation implementation_;  //!< Implementation.
+  std::string name_;                    //!< Name of the conic.
 };
 }  // namespace HomoGebra
\ No newline at end of file
@@ -1,13 +1,13 @@
 #include "GeometricObjectBody.h"
 
 #include <SFML/Graphics.hpp>
-#include <Thor/Shapes.hpp>
 #include <numbers>
 #include <utility>
 
 #include "Assert.h"
-#include "Matrix.h"
-#include "ThickLineDrawer.h"
+#include "Clipping.h"
+#include "ConicProjection.h"
+#include "SfmlCanvas.h"
 
 namespace HomoGebra
 {
@@ -25,50 +25,62 @@ extern float CalculateSizeOfPixel(const sf::RenderTarget& target)
 
   return pixel_size;
 }
-}  // namespace HomoGebra
 
-namespace HomoGebra
+extern sf::FloatRect CalculateViewRectangle(const sf::RenderTarget& target)
 {
-ObjectName::ObjectName(std::string name)
-{
-  // Load font
-  font_.loadFromFile(kFontPath);
+  const auto& view = target.getView();
 
-  // Set font
-  text_.setFont(font_);
-  text_.setCharacterSize(kCharacterSize);
+  return {view.getCenter() - view.getSize() / 2.f, view.getSize()};
+}
 
-  // Set color
-  text_.setFillColor(kTextColor);
+namespace
+{
+/**
+ * \brief Calculates bounds of the view to clip with.
+ *
+ * \param target Render target to draw to.
+ *
+ * \return Bounds of the view.
+ */
+Clipping::Bounds CalculateViewBounds(const sf::RenderTarget& target)
+{
+  const auto rectangle = CalculateViewRectangle(target);
 
-  // Set name
-  SetName(std::move(name));
+  return {rectangle.left, rectangle.top, rectangle.left + rectangle.width,
+          rectangle.top + rectangle.height};
 }
+}  // namespace
+}  // namespace HomoGebra
+
+namespace HomoGebra
+{
+ObjectName::ObjectName(std::string name) : name_(std::move(name)) {}
 
 void ObjectName::SetName(std::string name)
 {
   // Set name
   name_ = std::move(name);
-
-  // Set text
-  text_.setString(name_);
 }
 
 const std::string& ObjectName::GetName() const { return name_; }
 
-void ObjectName::SetSize(const float size)
+void ObjectName::SetPosition(const sf::Vector2f& position)
+{
+  position_ = position;
+}
+
+void ObjectName::SetSize(const float size) { size_ = size; }
+
+sf::FloatRect ObjectName::GetBounds() const
 {
-  const auto height = text_.getLocalBounds().height;
-  auto factor = size / height;
-  text_.setScale({factor, factor});
+  return {position_,
+          {size_ * kCharacterAspect * static_cast<float>(name_.size()),
+           size_}};
 }
 
-void ObjectName::draw(sf::RenderTarget& target, sf::RenderStates states) const
+void ObjectName::Draw(Canvas& canvas) const
 {
-  // Apply transform
-  states.transform *= getTransform();
-  // Draw
-  target.draw(text_, states);
+  canvas.DrawText(name_, position_, size_, kTextColor);
 }
 
 void ObjectBody::SetName(std::string name)
@@ -86,7 +98,7 @@ const std::string& ObjectBody::GetName() const
 void ObjectBody::SetNamePosition(const sf::Vector2f& position)
 {
   // Set position
-  text_.setPosition(position);
+  text_.SetPosition(position);
 }
 
 void ObjectBody::SetNameSize(const float size)
@@ -95,13 +107,27 @@ void ObjectBody::SetNameSize(const float size)
   text_.SetSize(size);
 }
 
+sf::FloatRect ObjectBody::GetNameBounds() const { return text_.GetBounds(); }
+
+void ObjectBody::SetDetail(const Detail detail) { detail_ = detail; }
+
+ObjectBody::Detail ObjectBody::GetDetail() const { return detail_; }
+
 void ObjectBody::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+  SfmlCanvas canvas{target, states};
+  Draw(canvas);
+}
+
+void ObjectBody::Draw(Canvas& canvas) const
 {
   // Draw name
-  target.draw(text_, states);
+  if (detail_ == Detail::kFull) text_.Draw(canvas);
 }
 
-PointBody::PointBody() { body_.setFillColor(sf::Color::Red); }
+bool ObjectBody::IsVisible() const { return visible_; }
+
+void ObjectBody::SetVisible(const bool visible) { visible_ = visible; }
 
 void PointBody::Update(const sf::RenderTarget& target,
                        const PointEquation& equation)
@@ -109,96 +135,137 @@ void PointBody::Update(const sf::RenderTarget& target,
   // Calculate position
   position_ = CalculatePosition(equation);
 
-  // Point is in real projective plane
-  if (position_)
+  UpdateView(target);
+}
+
+void PointBody::UpdateView(const sf::RenderTarget& target)
+{
+  // Point isn't in real projective plane
+  if (!position_)
   {
-    body_.setPosition(position_.value().position);
-    SetNamePosition(position_.value().position);
+    SetVisible(false);
+    return;
   }
 
   // Calculate size of body
   const auto size = CalculateSizeOfBody(target);
 
   // Set size
+  radius_ = size;
+
   constexpr auto kTextFactor = 2.f;
-  SetNameSize(size * kTextFactor);
+  const auto name_size = size * kTextFactor;
 
-  // Set size
-  body_.setRadius(size);
-  body_.setOrigin(size, size);
+  if (const auto& [position, is_at_infinity] = position_.value();
+      !is_at_infinity)
+  {
+    // Body and name (name is at most a square per character)
+    const auto name_width = name_size * static_cast<float>(GetName().size());
+    const sf::FloatRect bounds{
+        position - sf::Vector2f{radius_, radius_},
+        sf::Vector2f{std::max(2 * radius_, radius_ + name_width),
+                     std::max(2 * radius_, radius_ + name_size)}};
+
+    SetVisible(bounds.intersects(CalculateViewRectangle(target)));
+  }
+  else
+  {
+    UpdateArrow(target);
+    SetVisible(arrow_.has_value());
+  }
+
+  // Don't update name of invisible point
+  if (!IsVisible()) return;
+
+  SetNamePosition(arrow_ ? arrow_.value()[1].position
+                         : position_.value().position);
+  SetNameSize(name_size);
 }
 
-void PointBody::draw(sf::RenderTarget& target, sf::RenderStates states) const
+void PointBody::UpdateArrow(const sf::RenderTarget& target)
 {
-  // Point is not on a real plane
-  if (!position_) return;
+  arrow_ = std::nullopt;
+
+  const auto& [direction, is_at_infinity] = position_.value();
+  if (!is_at_infinity) return;
+
+  // Find where the ray from the center leaves the view
+  const auto& center = target.getView().getCenter();
+  Clipping::Rays ray;
+  ray.Push(center.x, center.y, direction.x, direction.y);
+  Clipping::Segments exit;
+  Clipping::ClipRays(ray, CalculateViewBounds(target), exit);
+
+  if (!exit.visible.front()) return;
+
+  const sf::Vector2f intersection{exit.x1.front(), exit.y1.front()};
+
+  // Coefficient for start of line.
+  constexpr auto kStartShift = 0.9f;
+  const auto arrow_start =
+      intersection * kStartShift + center * (1.f - kStartShift);
+  constexpr auto kEndShift = 0.95f;
+  const auto arrow_end = intersection * kEndShift + center * (1.f - kEndShift);
+
+  // Wings of the head are the shaft turned back by an angle
+  constexpr auto kHeadAngle = std::numbers::pi_v<float> / 6;
+  const auto head_length = 3 * radius_;
+  const auto back = (arrow_start - arrow_end) / Length(arrow_start - arrow_end);
+  auto rotate = [&back](const float angle)
+  {
+    return sf::Vector2f{back.x * std::cos(angle) - back.y * std::sin(angle),
+                        back.x * std::sin(angle) + back.y * std::cos(angle)};
+  };
+
+  arrow_ = {sf::Vertex{arrow_start, kColor}, sf::Vertex{arrow_end, kColor},
+            sf::Vertex{arrow_end + rotate(kHeadAngle) * head_length, kColor},
+            sf::Vertex{arrow_end, kColor},
+            sf::Vertex{arrow_end + rotate(-kHeadAngle) * head_length, kColor}};
+}
+
+void PointBody::Draw(Canvas& canvas) const
+{
+  // Point is not on a real plane or is drawn as a part of a cluster
+  if (!position_ || GetDetail() == Detail::kAggregated) return;
 
   if (const auto& [position, is_at_infinity] = position_.value();
       is_at_infinity)
   {
     // Draw point at infinity
-    // DrawArrow(target, states);
+    if (!arrow_) return;
+
+    const std::span<const sf::Vertex> arrow = arrow_.value();
+    constexpr auto kShaft = 2;
+    canvas.DrawPolyline(arrow.first(kShaft), radius_ / 2);
+    canvas.DrawPolyline(arrow.subspan(kShaft), radius_ / 2);
   }
   else
   {
     // Draw point
-    target.draw(body_, states);
-    ObjectBody::draw(target, states);
+    canvas.DrawCircle(position, radius_, kColor);
+    ObjectBody::Draw(canvas);
   }
 }
 
-[[nodiscard]] inline std::optional<sf::Vector2f> IntersectRayWithRectangle(
-    const sf::Vector2f& point, const sf::Vector2f& direction,
-    const sf::FloatRect& rectangle)
+Footprint PointBody::GetFootprint() const
 {
-  if (!rectangle.contains(point))
+  // Point is not on the screen
+  if (!IsVisible() || !position_ || position_.value().is_at_infinity)
   {
-    return std::nullopt;
+    return {};
   }
 
-  // TODO: Intersect line with rect.
-
-  struct Line
-  {
-    Line(sf::Vector2f first_point, sf::Vector2f second_point)
-    {
-      const HomoGebra::FloatSquaredMatrix matrix(
-          {{first_point.x, first_point.y, 1},
-           {second_point.x, second_point.y, 1},
-           {1, 1, 1}},
-          {0, 0, 1});
-      auto solution = matrix.GetSolution();
-    }
-  };
+  const auto& position = position_.value().position;
+  return {{sf::FloatRect{position - sf::Vector2f{radius_, radius_},
+                         sf::Vector2f{2 * radius_, 2 * radius_}}},
+          {}};
 }
 
-void PointBody::DrawArrow(sf::RenderTarget& target,
-                          sf::RenderStates states) const
+std::optional<sf::Vector2f> PointBody::GetPosition() const
 {
-  Assert(position_, "Point has no 'real' position");
-
-  const auto& [position, is_at_infinity] =
-      position_.value();  // NOLINT(bugprone-unchecked-optional-access)
-
-  Expect(is_at_infinity, "Drawing arrow, but point isn't at infinity?!");
-
-  const auto& view = target.getView();
-  const auto intersection = std::optional<sf::Vector2f>{};
-
-  Assert(intersection.has_value(),
-         "Couldn't find an intersection with a screen!");
-
-  // Coefficient for start of line.
-  constexpr auto kStartShift = 0.9f;
-  const auto arrow_start = intersection.value() * kStartShift +
-                           view.getCenter() * (1.f - kStartShift);
-  constexpr auto kEndShift = 0.95f;
-  const auto arrow_end =
-      intersection.value() * kEndShift + view.getCenter() * (1.f - kEndShift);
-
-  thor::Arrow arrow{arrow_start, arrow_end, sf::Color::Black, 10};
+  if (!position_ || position_.value().is_at_infinity) return std::nullopt;
 
-  target.draw(arrow, states);
+  return position_.value().position;
 }
 
 Distance PointBody::GetDistance(const sf::Vector2f& position) const
@@ -257,82 +324,101 @@ float PointBody::CalculateSizeOfBody(const sf::RenderTarget& target)
   return size;
 }
 
-void LineBody::Update(const LineEquation& equation)
+void LineBody::Update(const sf::RenderTarget& target,
+                      const LineEquation& equation)
 {
-  // Normalize equation
-  const auto normalized_equation = equation.equation.GetNormalized();
+  UpdateEquation(equation);
+  UpdateView(target);
+}
 
-  // Check if line is in 'real' plane
-  if (!(normalized_equation.x.IsReal() && normalized_equation.y.IsReal()))
+void LineBody::UpdateView(const sf::RenderTarget& target)
+{
+  LineBody* body = this;
+  UpdateViews({&body, 1}, target);
+}
+
+void LineBody::UpdateViews(const std::span<LineBody* const> bodies,
+                           const sf::RenderTarget& target)
+{
+  // Buffers are kept between calls to not allocate every frame
+  thread_local Clipping::Lines lines;
+  thread_local Clipping::Segments segments;
+
+  // Line, which isn't in 'real' plane, is clipped as the line at infinity
+  lines.Clear();
+  for (const auto* body : bodies)
   {
-    equation_ = std::nullopt;
+    const auto [a, b, c] = body->equation_.value_or(Equation{0.f, 0.f, 1.f});
+    lines.Push(a, b, c);
   }
 
-  // Set equation
-  Equation body_equation{
-      static_cast<float>(static_cast<long double>(normalized_equation.x)),
-      static_cast<float>(static_cast<long double>(normalized_equation.y)),
-      static_cast<float>(static_cast<long double>(normalized_equation.z))};
+  Clipping::ClipLines(lines, CalculateViewBounds(target), segments);
 
-  equation_ = body_equation;
+  for (size_t i = 0; i < bodies.size(); ++i)
+  {
+    auto& body = *bodies[i];
+    body.SetVisible(segments.visible[i]);
+
+    if (!body.IsVisible())
+    {
+      body.segment_ = std::nullopt;
+      continue;
+    }
+
+    body.segment_ = {
+        sf::Vertex{{segments.x0[i], segments.y0[i]}, sf::Color::Black},
+        sf::Vertex{{segments.x1[i], segments.y1[i]}, sf::Color::Black}};
+  }
 }
 
-void LineBody::draw(sf::RenderTarget& target, sf::RenderStates states) const
+void LineBody::Draw(Canvas& canvas) const
 {
-  // Check ig line is in 'real' plane
-  if (!equation_)
+  // Check if line is on the screen
+  if (!segment_)
   {
     return;
   }
-  const auto& a = equation_.value().a;
-  const auto& b = equation_.value().b;
-  const auto& c = equation_.value().c;
 
-  const auto& center = target.getView().getCenter();
-  const auto& size = target.getView().getSize();
-
-  const auto left = center.x - size.x / 2.f;
-  const auto right = center.x + size.x / 2.f;
-  const auto up = center.y + size.y / 2.f;
-  const auto down = center.y - size.y / 2.f;
+  canvas.DrawLines(segment_.value());
+}
 
-  std::array<sf::Vertex, 2> line_vertices;
+Footprint LineBody::GetFootprint() const
+{
+  if (!segment_) return {};
 
-  std::ranges::for_each(line_vertices, [](sf::Vertex& vertex)
-                        { vertex.color = sf::Color::Black; });
+  return {{}, {segment_.value()}};
+}
 
-  constexpr size_t first = 0;
-  constexpr size_t second = 1;
+void LineBody::UpdateEquation(const LineEquation& equation)
+{
+  // Normalize equation
+  const auto normalized_equation = equation.equation.GetNormalized();
 
-  if (abs(a / b) > size.y / size.x)
-  {
-    line_vertices[first].position.y = down;
-    line_vertices[second].position.y = up;
-    line_vertices[first].position.x =
-        -(line_vertices[first].position.y * b + c) / a;
-    line_vertices[second].position.x =
-        -(line_vertices[second].position.y * b + c) / a;
-  }
-  else
+  // Check if line is in 'real' plane
+  if (!(normalized_equation.x.IsReal() && normalized_equation.y.IsReal()))
   {
-    line_vertices[first].position.x = left;
-    line_vertices[second].position.x = right;
-    line_vertices[first].position.y =
-        -(line_vertices[first].position.x * a + c) / b;
-    line_vertices[second].position.y =
-        -(line_vertices[second].position.x * a + c) / b;
+    equation_ = std::nullopt;
+    return;
   }
 
-  target.draw(line_vertices.data(), 2, sf::Lines);
+  // Set equation
+  Equation body_equation{
+      static_cast<float>(static_cast<long double>(normalized_equation.x)),
+      static_cast<float>(static_cast<long double>(normalized_equation.y)),
+      static_cast<float>(static_cast<long double>(normalized_equation.z))};
+
+  equation_ = body_equation;
 }
 
 Distance LineBody::GetDistance(const sf::Vector2f& position) const
 {
-  if (!equation_) return std::numeric_limits<Distance>::max();
+  // Only the segment in the view is indexed, so the distance to it is never
+  // less than distance to cells, which index skips
+  if (!segment_) return std::numeric_limits<Distance>::max();
 
-  const auto& [a, b, c] = equation_.value();
+  const auto& [from, to] = segment_.value();
 
-  return DistanceToLine(position, a, b, c);
+  return DistanceToSegment(position, from.position, to.position);
 }
 
 float LineBody::Equation::Solve(const Var var, const float another) const
@@ -356,42 +442,72 @@ void ConicBody::Update(const sf::RenderTarget& target,
   UpdateBodyLines(target);
 }
 
-void ConicBody::draw(sf::RenderTarget& target, sf::RenderStates states) const
+void ConicBody::UpdateView(const sf::RenderTarget& target)
+{
+  UpdateBodyLines(target);
+}
+
+void ConicBody::Draw(Canvas& canvas) const
 {
   // Draw lines
-  std::ranges::for_each(body_lines.lines_x, [&target](const auto& line)
-                        { ThickLineDrawer{}.Draw(target, line, 3.f); });
+  std::ranges::for_each(body_lines.lines_x, [this, &canvas](const auto& line)
+                        { canvas.DrawPolyline(line, body_lines.thickness); });
+
+  std::ranges::for_each(body_lines.lines_y, [this, &canvas](const auto& line)
+                        { canvas.DrawPolyline(line, body_lines.thickness); });
+}
 
-  std::ranges::for_each(body_lines.lines_y, [&target](const auto& line)
-                        { ThickLineDrawer{}.Draw(target, line, 3.f); });
+Footprint ConicBody::GetFootprint() const
+{
+  Footprint footprint;
+
+  // Conic is covered by its lines
+  std::ranges::for_each(body_lines.lines_x, [&footprint](const auto& line)
+                        { footprint.polylines.emplace_back(line); });
+
+  std::ranges::for_each(body_lines.lines_y, [&footprint](const auto& line)
+                        { footprint.polylines.emplace_back(line); });
+
+  return footprint;
 }
 
 Distance ConicBody::GetDistance(const sf::Vector2f& position) const
 {
-  Distance distance = std::numeric_limits<Distance>::max();
-  std::ranges::for_each(
-      body_lines.lines_x,
-      [&distance, &position](const auto& line)
-      {
-        std::ranges::for_each(
-            line,
-            [&distance, &position](const auto& vertex) {
-              distance = std::min(distance, Length(vertex.position - position));
-            });
-      });
-
-  std::ranges::for_each(
-      body_lines.lines_y,
-      [&distance, &position](const auto& line)
-      {
-        std::ranges::for_each(
-            line,
-            [&distance, &position](const auto& vertex) {
-              distance = std::min(distance, Length(vertex.position - position));
-            });
-      });
+  const auto projection = GetProjection(position);
+
+  if (!projection) return std::numeric_limits<Distance>::max();
 
-  return distance;
+  return projection.value().distance;
+}
+
+std::optional<Projection> ConicBody::GetProjection(
+    const sf::Vector2f& position) const
+{
+  if (!equation_) return std::nullopt;
+
+  // Solve equation of the conic
+  if (auto projection = equation_.value().Project(position)) return projection;
+
+  // Take the nearest vertex of the body
+  std::optional<Projection> nearest;
+  auto check_line = [&nearest, &position](const auto& line)
+  {
+    std::ranges::for_each(
+        line,
+        [&nearest, &position](const auto& vertex)
+        {
+          const auto distance = Length(vertex.position - position);
+          if (!nearest || distance < nearest.value().distance)
+          {
+            nearest = Projection{vertex.position, distance};
+          }
+        });
+  };
+
+  std::ranges::for_each(body_lines.lines_x, check_line);
+  std::ranges::for_each(body_lines.lines_y, check_line);
+
+  return nearest;
 }
 
 void ConicBody::UpdateEquation(const ConicEquation& equation)
@@ -417,6 +533,7 @@ void ConicBody::UpdateEquation(const ConicEquation& equation)
       equation.squares[static_cast<size_t>(Var::kX)] * normalizer;
   if (!normalized_square_x.IsReal())
   {
+    if (equation_) ++equation_version_;
     equation_ = std::nullopt;
     return;
   }
@@ -441,7 +558,11 @@ void ConicBody::UpdateEquation(const ConicEquation& equation)
   constant = equation.squares[static_cast<size_t>(Var::kZ)] * Complex{1} *
              Complex{1} * normalizer;
 
-  equation_ = Equation{squares, pair_product, linears, constant};
+  const Equation updated{squares, pair_product, linears, constant};
+
+  // Cached tessellation is valid until the equation changes
+  if (equation_ != updated) ++equation_version_;
+  equation_ = updated;
 }
 
 void ConicBody::UpdateBodyLines(const sf::RenderTarget& target)
@@ -452,6 +573,7 @@ void ConicBody::UpdateBodyLines(const sf::RenderTarget& target)
 
   if (!equation_)
   {
+    SetVisible(false);
     return;
   }
 
@@ -467,78 +589,203 @@ void ConicBody::UpdateBodyLines(const sf::RenderTarget& target)
 
   const sf::FloatRect rendering_region{corner, render_region_size};
 
-  // Calculate amount of steps needed and their size
-  const size_t steps = std::max(target.getSize().x, target.getSize().y) / 2;
-  const auto step_size = render_region_size / static_cast<float>(steps);
+  // Don't calculate lines of invisible conic
+  SetVisible(equation_.value().MayIntersect(rendering_region));
+  if (!IsVisible()) return;
+
+  // Samples are about 2 pixels apart, the step is the same within a level
+  const auto scale_level =
+      static_cast<int>(std::floor(std::log2(CalculateSizeOfPixel(target))));
+  tessellation_.Validate(equation_version_, scale_level);
 
   lines_x.reserve(4);
   lines_y.reserve(4);
-  lines_x.resize(2);
-  lines_y.resize(2);
 
-  for (size_t step = 0; step < steps; ++step)
+  // Assemble lines of a variable from roots at visible samples
+  auto assemble = [this, &rendering_region](const Var var, auto& lines)
   {
-    // Calculate position of current step
-    const auto pos = corner + step_size * static_cast<float>(step);
+    const bool is_x = var == Var::kX;
 
-    // Calculate roots of equation
-    // Check if roots are real and add them to line
-    auto roots_x = equation_.value().Solve(
-        Var::kX, Complex{static_cast<long double>(pos.y)});
+    // Samples of x are values of y and vice versa
+    const auto region_start = is_x ? rendering_region.top
+                                   : rendering_region.left;
+    const auto region_size = is_x ? rendering_region.height
+                                  : rendering_region.width;
+    const auto first = static_cast<long long>(
+        std::floor(region_start / tessellation_.step));
+    const auto last = static_cast<long long>(
+        std::ceil((region_start + region_size) / tessellation_.step));
 
-    for (size_t root_number = 0; root_number < roots_x.size(); ++root_number)
+    lines.resize(2);
+
+    for (auto sample = first; sample <= last; ++sample)
     {
-      auto& root = roots_x[root_number];
-      if (root && root.value().IsReal() &&
-          rendering_region.contains({static_cast<float>(root.value()), pos.y}))
+      const auto another = tessellation_.GetCoordinate(sample);
+      const auto& roots =
+          tessellation_.GetRoots(equation_.value(), var, sample);
+
+      // Check if roots are in the region and add them to line
+      for (size_t root_number = 0; root_number < roots.size(); ++root_number)
       {
-        lines_x[lines_x.size() - 1 - root_number].emplace_back(sf::Vertex(
-            {static_cast<float>(root.value()), pos.y}, sf::Color::Black));
+        const auto& root = roots[root_number];
+        if (!root) continue;
+
+        const auto position = is_x ? sf::Vector2f{root.value(), another}
+                                   : sf::Vector2f{another, root.value()};
+        if (rendering_region.contains(position))
+        {
+          lines[lines.size() - 1 - root_number].emplace_back(
+              sf::Vertex(position, sf::Color::Black));
+        }
       }
-    }
 
-    if (std::ranges::all_of(roots_x,
-                            [](const auto& root)
-                            {
-                              return !root.has_value() ||
-                                     !root.value().IsReal();
-                            }) /*check for discontinuity*/
-        && !lines_x.back().empty() /*check if need to resize*/)
-    {
-      lines_x.resize(lines_x.size() + roots_x.size());
+      if (std::ranges::none_of(roots, [](const auto& root)
+                               { return root.has_value(); })
+          /*check for discontinuity*/
+          && !lines.back().empty() /*check if need to resize*/)
+      {
+        lines.resize(lines.size() + roots.size());
+      }
     }
 
-    // Calculate roots of equation
-    // Check if roots are real and add them to line
-    auto roots_y = equation_.value().Solve(
-        Var::kY, Complex{static_cast<long double>(pos.x)});
+    tessellation_.Evict(var, first, last);
+  };
 
-    for (size_t root_number = 0; root_number < roots_y.size(); ++root_number)
-    {
-      auto& root = roots_y[root_number];
+  assemble(Var::kX, lines_x);
+  assemble(Var::kY, lines_y);
 
-      if (root && root.value().IsReal() &&
-          rendering_region.contains({pos.x, static_cast<float>(root.value())}))
+  Expect(lines_x.size() <= 4);
+  Expect(lines_y.size() <= 4);
+
+  // Vertices closer than half of a pixel to the line aren't visible
+  const auto tolerance = CalculateSizeOfPixel(target) / 2.f;
+  std::ranges::for_each(lines_x, [tolerance](auto& line)
+                        { SimplifyLine(line, tolerance); });
+  std::ranges::for_each(lines_y, [tolerance](auto& line)
+                        { SimplifyLine(line, tolerance); });
+}
+
+void ConicBody::SimplifyLine(BodyLines::Line& line, const float tolerance)
+{
+  if (line.size() < 3) return;
+
+  std::vector<bool> is_kept(line.size(), false);
+  is_kept.front() = true;
+  is_kept.back() = true;
+
+  // Ranges of vertices, where the farthest vertex from the chord is searched
+  std::vector<std::pair<size_t, size_t>> ranges{{0, line.size() - 1}};
+  while (!ranges.empty())
+  {
+    const auto [first, last] = ranges.back();
+    ranges.pop_back();
+
+    const auto& from = line[first].position;
+    const auto chord = line[last].position - from;
+    const auto chord_length = Length(chord);
+
+    Distance farthest_distance = 0;
+    auto farthest = first;
+    for (auto vertex = first + 1; vertex < last; ++vertex)
+    {
+      const auto offset = line[vertex].position - from;
+      const auto distance =
+          chord_length > 0
+              ? std::abs(chord.x * offset.y - chord.y * offset.x) /
+                    chord_length
+              : Length(offset);
+
+      if (distance > farthest_distance)
       {
-        lines_y[lines_y.size() - 1 - root_number].emplace_back(sf::Vertex(
-            {pos.x, static_cast<float>(root.value())}, sf::Color::Black));
+        farthest_distance = distance;
+        farthest = vertex;
       }
     }
 
-    if (std::ranges::all_of(roots_y,
-                            [](const auto& root)
-                            {
-                              return !root.has_value() ||
-                                     !root.value().IsReal();
-                            }) /*check for discontinuity*/
-        && !lines_y.back().empty() /*check if need to resize*/)
+    if (farthest_distance > tolerance)
     {
-      lines_y.resize(lines_y.size() + roots_y.size());
+      is_kept[farthest] = true;
+      ranges.emplace_back(first, farthest);
+      ranges.emplace_back(farthest, last);
     }
   }
 
-  Expect(lines_x.size() <= 4);
-  Expect(lines_y.size() <= 4);
+  // Move kept vertices to the front
+  size_t kept = 0;
+  for (size_t vertex = 0; vertex < line.size(); ++vertex)
+  {
+    if (is_kept[vertex]) line[kept++] = line[vertex];
+  }
+  line.resize(kept);
+}
+
+void ConicBody::TessellationCache::Validate(const size_t equation_version,
+                                            const int scale_level)
+{
+  if (version == equation_version && level == scale_level && step > 0.f)
+  {
+    return;
+  }
+
+  version = equation_version;
+  level = scale_level;
+  step = std::ldexp(2.f, scale_level);
+  std::ranges::for_each(tiles, [](auto& var_tiles) { var_tiles.clear(); });
+}
+
+const ConicBody::TessellationCache::Roots&
+ConicBody::TessellationCache::GetRoots(const Equation& equation,
+                                       const Var var, const long long sample)
+{
+  const auto tile_index = GetTile(sample);
+  auto [iterator, inserted] =
+      tiles[static_cast<size_t>(var)].try_emplace(tile_index);
+  auto& tile = iterator->second;
+
+  // Solve all samples of a new tile
+  if (inserted)
+  {
+    const auto first = tile_index * kTileSamples;
+    for (long long index = 0; index < kTileSamples; ++index)
+    {
+      const auto solution = equation.Solve(
+          var, Complex{static_cast<long double>(GetCoordinate(first + index))});
+
+      // Only real roots are drawn
+      std::ranges::transform(
+          solution, tile[static_cast<size_t>(index)].begin(),
+          [](const auto& root) -> std::optional<float>
+          {
+            if (!root || !root.value().IsReal()) return std::nullopt;
+            return static_cast<float>(root.value());
+          });
+    }
+  }
+
+  return tile[static_cast<size_t>(sample - tile_index * kTileSamples)];
+}
+
+void ConicBody::TessellationCache::Evict(const Var var, const long long first,
+                                         const long long last)
+{
+  const auto first_kept = GetTile(first) - 1;
+  const auto last_kept = GetTile(last) + 1;
+
+  std::erase_if(tiles[static_cast<size_t>(var)],
+                [first_kept, last_kept](const auto& tile)
+                { return tile.first < first_kept || tile.first > last_kept; });
+}
+
+float ConicBody::TessellationCache::GetCoordinate(const long long sample) const
+{
+  return static_cast<float>(sample) * step;
+}
+
+long long ConicBody::TessellationCache::GetTile(const long long sample)
+{
+  // Round down for negative samples too
+  return sample >= 0 ? sample / kTileSamples
+                     : (sample - kTileSamples + 1) / kTileSamples;
 }
 
 float ConicBody::CalculateSizeOfBody(const sf::RenderTarget& target)
@@ -612,4 +859,83 @@ ConicBody::Equation::Solution ConicBody::Equation::Solve(
   return SolveQuadraticEquation(quadratic_coefficient, linear_coefficient,
                                 constant_coefficient);
 }
-}  // namespace HomoGebra
\ No newline at end of file
+
+std::optional<Projection> ConicBody::Equation::Project(
+    const sf::Vector2f& position) const
+{
+  // Conic must lie on the real plane
+  if (!squares[0].IsReal() || !squares[1].IsReal() || !pair_product.IsReal() ||
+      !linears[0].IsReal() || !linears[1].IsReal() || !constant.IsReal())
+  {
+    return std::nullopt;
+  }
+
+  const ConicProjection::Conic conic{
+      squares[static_cast<size_t>(Var::kX)].real(),
+      pair_product.real(),
+      squares[static_cast<size_t>(Var::kY)].real(),
+      linears[static_cast<size_t>(Var::kX)].real(),
+      linears[static_cast<size_t>(Var::kY)].real(),
+      constant.real()};
+
+  const auto foot = ConicProjection::Project(conic, position.x, position.y);
+  if (!foot) return std::nullopt;
+
+  return Projection{
+      sf::Vector2f{static_cast<float>(foot->x), static_cast<float>(foot->y)},
+      static_cast<Distance>(foot->distance)};
+}
+
+bool ConicBody::Equation::MayIntersect(const sf::FloatRect& rectangle) const
+{
+  // Only real conics are checked
+  if (!squares[0].IsReal() || !squares[1].IsReal() || !pair_product.IsReal() ||
+      !linears[0].IsReal() || !linears[1].IsReal() || !constant.IsReal())
+  {
+    return true;
+  }
+
+  // Ax^2 + Bxy + Cy^2 + Dx + Ey + F = 0
+  const auto a = squares[static_cast<size_t>(Var::kX)].real();
+  const auto b = pair_product.real();
+  const auto c = squares[static_cast<size_t>(Var::kY)].real();
+  const auto d = linears[static_cast<size_t>(Var::kX)].real();
+  const auto e = linears[static_cast<size_t>(Var::kY)].real();
+  const auto f = constant.real();
+
+  // Only ellipses are bounded
+  const auto discriminant = b * b - 4 * a * c;
+  if (discriminant >= 0) return true;
+
+  /*
+   * Conic has a point with abscissa x if the equation, as a quadratic in y,
+   * has real roots: (B^2 - 4AC)x^2 + (2BE - 4CD)x + (E^2 - 4CF) >= 0.
+   * For an ellipse it holds between the roots. The same for ordinates.
+   */
+  auto range = [discriminant](const long double linear,
+                              const long double free_term)
+      -> std::optional<std::pair<long double, long double>>
+  {
+    const auto range_discriminant =
+        linear * linear - 4 * discriminant * free_term;
+
+    // Ellipse is imaginary
+    if (range_discriminant < 0) return std::nullopt;
+
+    const auto root = std::sqrt(range_discriminant);
+    const auto first = (-linear + root) / (2 * discriminant);
+    const auto second = (-linear - root) / (2 * discriminant);
+    return std::pair{std::min(first, second), std::max(first, second)};
+  };
+
+  const auto x_range = range(2 * b * e - 4 * c * d, e * e - 4 * c * f);
+  const auto y_range = range(2 * b * d - 4 * a * e, d * d - 4 * a * f);
+
+  if (!x_range || !y_range) return false;
+
+  return x_range.value().first <= rectangle.left + rectangle.width &&
+         x_range.value().second >= rectangle.left &&
+         y_range.value().first <= rectangle.top + rectangle.height &&
+         y_range.value().second >= rectangle.top;
+}
+}  // namespace HomoGebra
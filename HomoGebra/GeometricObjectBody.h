@@ -1,10 +1,13 @@
 ﻿#pragma once
 
 #include <SFML/Graphics.hpp>
+#include <unordered_map>
 
+#include "Canvas.h"
 #include "DistanceUtilities.h"
 #include "GeometricObjectImplementation.h"
 #include "NameGenerator.h"
+#include "SpatialIndex.h"
 
 namespace HomoGebra
 {
@@ -17,7 +20,7 @@ namespace HomoGebra
  *
  * \date April 2023
  */
-class ObjectName final : public sf::Drawable, public sf::Transformable
+class ObjectName final
 {
  public:
   /**
@@ -26,11 +29,6 @@ class ObjectName final : public sf::Drawable, public sf::Transformable
    * \param name Name of the object.
    */
   explicit ObjectName(std::string name = {});
-  /**
-   * \brief Destructor.
-   *
-   */
-  ~ObjectName() override = default;
 
   /**
    * \brief Sets name of the object.
@@ -45,31 +43,43 @@ class ObjectName final : public sf::Drawable, public sf::Transformable
    */
   [[nodiscard]] const std::string& GetName() const;
 
+  /**
+   * \brief Sets position of the object name.
+   *
+   * \param position Top left corner of the name.
+   */
+  void SetPosition(const sf::Vector2f& position);
+
   /**
    * \brief Sets size of the object name.
    *
    * \param size Size of the object name.
    */
   void SetSize(float size);
+
   /**
-   * \brief Draw the object name to a render target.
+   * \brief Estimates rectangle, which the name covers.
    *
-   * \param target Render target to draw to.
-   * \param states States of the render.
+   * \return Bounds of the name.
    */
-  void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+  [[nodiscard]] sf::FloatRect GetBounds() const;
+
+  /**
+   * \brief Draw the object name to a canvas.
+   *
+   * \param canvas Canvas to draw to.
+   */
+  void Draw(Canvas& canvas) const;
 
  private:
-  inline static const std::string kFontPath =
-      "Resources/font.ttf";                       //!< Path to font
-  static constexpr unsigned kCharacterSize = 50;  //!< Character size
   inline static const sf::Color kTextColor =
       sf::Color{0, 0, 0};  //!< Color of the text
+  static constexpr float kCharacterAspect =
+      0.8f;  //!< Estimated ratio of width of a character to its height
 
-  std::string name_;  //!< Name of the object
-
-  sf::Font font_;  //!< Font of the text
-  sf::Text text_;  //!< Text of the name
+  std::string name_;       //!< Name of the object
+  sf::Vector2f position_;  //!< Top left corner of the name
+  float size_{};           //!< Height of the name
 };
 
 /**
@@ -84,6 +94,16 @@ class ObjectName final : public sf::Drawable, public sf::Transformable
 class ObjectBody : public sf::Drawable
 {
  public:
+  /**
+   * \brief How much of a body is drawn.
+   */
+  enum class Detail
+  {
+    kFull,         //!< Body and its name.
+    kWithoutName,  //!< Body without name.
+    kAggregated    //!< Nothing, body is drawn as a part of a cluster.
+  };
+
   /**
    * \brief Set name of the point.
    *
@@ -112,13 +132,51 @@ class ObjectBody : public sf::Drawable
    */
   void SetNameSize(float size);
 
+  /**
+   * \brief Estimates rectangle, which the name covers.
+   *
+   * \return Bounds of the name.
+   */
+  [[nodiscard]] sf::FloatRect GetNameBounds() const;
+
+  /**
+   * \brief Sets how much of the body is drawn.
+   *
+   * \param detail Level of detail.
+   */
+  void SetDetail(Detail detail);
+
+  /**
+   * \brief Gets how much of the body is drawn.
+   *
+   * \return Level of detail.
+   */
+  [[nodiscard]] Detail GetDetail() const;
+
   /**
    * \brief Draw the object body to a render target.
    *
    * \param target Render target to draw to.
    * \param states Current render states.
    */
-  void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+  void draw(sf::RenderTarget& target, sf::RenderStates states) const final;
+
+  /**
+   * \brief Updates state, which depends only on the view.
+   *
+   * \details Equation isn't read again, so after a change of the view it is
+   * cheaper than a full update. Body must have been fully updated before.
+   *
+   * \param target Render target with the view.
+   */
+  virtual void UpdateView(const sf::RenderTarget& target) = 0;
+
+  /**
+   * \brief Draw the object body to a canvas.
+   *
+   * \param canvas Canvas to draw to.
+   */
+  virtual void Draw(Canvas& canvas) const;
 
   /**
    * \brief Gets distance from object to position.
@@ -130,8 +188,34 @@ class ObjectBody : public sf::Drawable
   [[nodiscard]] virtual Distance GetDistance(
       const sf::Vector2f& position) const = 0;
 
+  /**
+   * \brief Gets shape, which body covers.
+   *
+   * \return Footprint of the body.
+   */
+  [[nodiscard]] virtual Footprint GetFootprint() const = 0;
+
+  /**
+   * \brief Checks if body was in the view on the last update.
+   *
+   * \details Invisible bodies are neither drawn nor fully updated.
+   *
+   * \return False if body is surely out of the view, true otherwise.
+   */
+  [[nodiscard]] bool IsVisible() const;
+
+ protected:
+  /**
+   * \brief Sets result of the visibility check.
+   *
+   * \param visible Is body in the view?
+   */
+  void SetVisible(bool visible);
+
  private:
-  ObjectName text_;  //!< Name of the name.
+  ObjectName text_;                //!< Name of the name.
+  bool visible_ = true;            //!< Was body in the view on the last update?
+  Detail detail_ = Detail::kFull;  //!< How much of the body is drawn.
 };
 
 /**
@@ -150,7 +234,7 @@ class PointBody final : public ObjectBody
    * \brief Default constructor.
    *
    */
-  PointBody();
+  PointBody() = default;
 
   /**
    * \brief Destructor.
@@ -166,23 +250,25 @@ class PointBody final : public ObjectBody
    */
   void Update(const sf::RenderTarget& target, const PointEquation& equation);
 
+  void UpdateView(const sf::RenderTarget& target) override;
+
   /**
-   * \brief Draw the point to a render target.
+   * \brief Draw the point to a canvas.
    *
-   * \param target Render target to draw to.
-   * \param states Current render states.
+   * \param canvas Canvas to draw to.
    */
-  void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+  void Draw(Canvas& canvas) const override;
+
+  Distance GetDistance(const sf::Vector2f& position) const override;
+
+  Footprint GetFootprint() const override;
 
   /**
-   * \brief Draw arrow to a render target.
+   * \brief Gets position of the point on the plane.
    *
-   * \param target Render target to draw to.
-   * \param states Current render states.
+   * \return Position, std::nullopt if the point isn't real or is at infinity.
    */
-  void DrawArrow(sf::RenderTarget& target, sf::RenderStates states) const;
-
-  Distance GetDistance(const sf::Vector2f& position) const override;
+  [[nodiscard]] std::optional<sf::Vector2f> GetPosition() const;
 
  private:
   /**
@@ -226,9 +312,23 @@ class PointBody final : public ObjectBody
    */
   static float CalculateSizeOfBody(const sf::RenderTarget& target);
 
+  /**
+   * \brief Places an arrow, which points to the point at infinity.
+   *
+   * \details Arrow lies on the ray from the center of the view in the
+   * direction of the point, near the boundary of the view.
+   *
+   * \param target Render target to draw to.
+   */
+  void UpdateArrow(const sf::RenderTarget& target);
+
+  inline static const sf::Color kColor = sf::Color::Red;  //!< Color of body.
+
   std::optional<ProjectivePosition>
-      position_;          //!< Projective position of the point.
-  sf::CircleShape body_;  //!< Body of the point.
+      position_;    //!< Projective position of the point.
+  float radius_{};  //!< Radius of the body.
+  std::optional<std::array<sf::Vertex, 5>>
+      arrow_;  //!< Shaft and head of the arrow to the point at infinity.
 };
 
 /**
@@ -258,20 +358,44 @@ class LineBody final : public ObjectBody
   /**
    * \brief Updates the line body.
    *
+   * \param target Render target to draw to.
    * \param equation Equation of the line.
    */
-  void Update(const LineEquation& equation);
+  void Update(const sf::RenderTarget& target, const LineEquation& equation);
+
+  void UpdateView(const sf::RenderTarget& target) override;
 
   /**
-   * \brief Draw line to a render target.
+   * \brief Reads new equation of the line.
+   *
+   * \param equation Equation of the line.
+   */
+  void UpdateEquation(const LineEquation& equation);
+
+  /**
+   * \brief Updates visible parts of many lines at once.
+   *
+   * \details All lines are clipped with the view in one pass.
    *
+   * \param bodies Bodies of the lines.
    * \param target Render target to draw to.
-   * \param states Current render states.
+   *
+   * \see Clipping::ClipLines
+   */
+  static void UpdateViews(std::span<LineBody* const> bodies,
+                          const sf::RenderTarget& target);
+
+  /**
+   * \brief Draw line to a canvas.
+   *
+   * \param canvas Canvas to draw to.
    */
-  void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+  void Draw(Canvas& canvas) const override;
 
   Distance GetDistance(const sf::Vector2f& position) const override;
 
+  Footprint GetFootprint() const override;
+
  private:
   /**
    * \brief Equation of a line.
@@ -304,6 +428,8 @@ class LineBody final : public ObjectBody
   };
 
   std::optional<Equation> equation_;  //!< Equation of the line.
+  std::optional<std::array<sf::Vertex, 2>>
+      segment_;  //!< Visible part of the line.
 };
 
 /**
@@ -337,16 +463,33 @@ class ConicBody : public ObjectBody
    */
   void Update(const sf::RenderTarget& target, const ConicEquation& equation);
 
+  void UpdateView(const sf::RenderTarget& target) override;
+
   /**
-   * \brief Draw conic to a render target.
+   * \brief Draw conic to a canvas.
    *
-   * \param target Render target to draw to.
-   * \param states Current render states.
+   * \param canvas Canvas to draw to.
    */
-  void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+  void Draw(Canvas& canvas) const override;
 
   Distance GetDistance(const sf::Vector2f& position) const override;
 
+  /**
+   * \brief Finds the nearest point of the conic.
+   *
+   * \details Solves the equation of the conic if it is possible, otherwise
+   * takes the nearest vertex of the body.
+   *
+   * \param position Position to find the nearest point to.
+   *
+   * \return Projection of the position, std::nullopt if the conic isn't
+   * on the real plane.
+   */
+  [[nodiscard]] std::optional<Projection> GetProjection(
+      const sf::Vector2f& position) const;
+
+  Footprint GetFootprint() const override;
+
  private:
   /**
    * \brief Body of lines.
@@ -388,6 +531,40 @@ class ConicBody : public ObjectBody
      */
     [[nodiscard]] Solution Solve(Var var, const Complex& another) const;
 
+    /**
+     * \brief Finds the nearest point of the conic.
+     *
+     * \param position Position to find the nearest point to.
+     *
+     * \return Projection of the position, std::nullopt if the conic isn't
+     * real or the quartic degenerates.
+     *
+     * \see ConicProjection::Project
+     */
+    [[nodiscard]] std::optional<Projection> Project(
+        const sf::Vector2f& position) const;
+
+    /**
+     * \brief Cheaply checks if conic may have points in a rectangle.
+     *
+     * \details Bounding box is known only for ellipses, other real conics
+     * may always have points in the rectangle.
+     *
+     * \param rectangle Rectangle to check.
+     *
+     * \return False if conic surely has no real points in the rectangle.
+     */
+    [[nodiscard]] bool MayIntersect(const sf::FloatRect& rectangle) const;
+
+    /**
+     * \brief Compares coefficients of equations.
+     *
+     * \param other Equation to compare with.
+     *
+     * \return True if all coefficients are equal.
+     */
+    [[nodiscard]] bool operator==(const Equation& other) const = default;
+
     std::array<Complex, 2>
         squares;           //!< Coefficient of the squares of the variables.
     Complex pair_product;  //!< Coefficient of the product of the variables.
@@ -395,9 +572,99 @@ class ConicBody : public ObjectBody
     Complex constant;                //!< Constant coefficient.
   };
 
+  /**
+   * \brief Real roots of the equation at samples of a grid on the plane.
+   *
+   * \details Samples of a variable are values of another variable, which are
+   * multiples of the step. They are grouped in tiles and a tile is solved
+   * when one of its samples is needed for the first time. So panning solves
+   * only newly exposed tiles and zooming within one scale level (where the
+   * step is the same) solves nothing. Cache is keyed by version of the
+   * equation and the scale level, so it is dropped when one of them changes.
+   *
+   * \author nook0110
+   *
+   * \version 1.0
+   *
+   * \date May 2024
+   */
+  struct TessellationCache
+  {
+    static constexpr long long kTileSamples = 64;  //!< Samples in a tile.
+
+    using Roots = std::array<std::optional<float>, 2>;  //!< Real roots.
+    using Tile = std::array<Roots, kTileSamples>;       //!< Roots of samples.
+
+    /**
+     * \brief Drops all tiles if they were solved for another key.
+     *
+     * \param equation_version Version of the equation.
+     * \param scale_level Scale level, the step is 2^(level + 1).
+     */
+    void Validate(size_t equation_version, int scale_level);
+
+    /**
+     * \brief Gets real roots at a sample, solves its tile if needed.
+     *
+     * \param equation Equation to solve.
+     * \param var Variable to solve for.
+     * \param sample Index of the sample.
+     *
+     * \return Real roots.
+     */
+    [[nodiscard]] const Roots& GetRoots(const Equation& equation, Var var,
+                                        long long sample);
+
+    /**
+     * \brief Removes tiles, which are far from needed samples.
+     *
+     * \details Tiles next to the needed ones are kept, as they are likely
+     * to be exposed by the next pan.
+     *
+     * \param var Variable, which tiles are removed of.
+     * \param first First needed sample.
+     * \param last Last needed sample.
+     */
+    void Evict(Var var, long long first, long long last);
+
+    /**
+     * \brief Gets value of another variable at a sample.
+     *
+     * \param sample Index of the sample.
+     *
+     * \return Value of another variable.
+     */
+    [[nodiscard]] float GetCoordinate(long long sample) const;
+
+    /**
+     * \brief Gets index of the tile of a sample.
+     *
+     * \param sample Index of the sample.
+     *
+     * \return Index of the tile.
+     */
+    [[nodiscard]] static long long GetTile(long long sample);
+
+    size_t version{};  //!< Version of the equation, which tiles are for.
+    int level{};       //!< Scale level, which tiles are for.
+    float step{};      //!< Distance between samples.
+    std::array<std::unordered_map<long long, Tile>, 2>
+        tiles;  //!< Tiles by index for each variable to solve for.
+  };
+
   void UpdateEquation(const ConicEquation& equation);
   void UpdateBodyLines(const sf::RenderTarget& target);
 
+  /**
+   * \brief Removes vertices, which are closer than tolerance to the line.
+   *
+   * \details Uses Ramer-Douglas-Peucker algorithm.
+   *
+   * \param line Line to simplify.
+   * \param tolerance Maximum distance from a removed vertex to the line.
+   */
+  static void SimplifyLine(BodyLines::Line& line, float tolerance);
+
   /**
    * \brief Calculates size of a body
    *
@@ -412,5 +679,8 @@ class ConicBody : public ObjectBody
   BodyLines body_lines;  //!< Body of the conic.
 
   std::optional<Equation> equation_;  //!< Equation of the conic.
+  size_t equation_version_{};         //!< Incremented on every change.
+
+  TessellationCache tessellation_;  //!< Roots, which lines are made of.
 };
 }  // namespace HomoGebra
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 #include "Assert.h"
 #include "GeometricObject.h"
-#include "Plane.h"
+#include "PlaneImplementation.h"
 
 namespace HomoGebra
 {
@@ -17,7 +17,10 @@ class PointOnPlaneFactory
    *
    * \param plane The plane on which the points will be constructed.
    */
-  explicit PointOnPlaneFactory(Plane* plane) : plane_(plane) { Assert(plane); }
+  explicit PointOnPlaneFactory(PlaneImplementation* plane) : plane_(plane)
+  {
+    Assert(plane);
+  }
 
   /**
    * \brief Constructs a point with the given coordinates.
@@ -29,7 +32,7 @@ class PointOnPlaneFactory
   Point* operator()(PointEquation equation) const;
 
  private:
-  Plane* plane_{};
+  PlaneImplementation* plane_{};
 };
 
 /**
@@ -43,7 +46,7 @@ struct PointProjectionFactory
    *
    * \param plane The plane on which the points will be projected.
    */
-  explicit PointProjectionFactory(Plane* plane) : plane_(plane)
+  explicit PointProjectionFactory(PlaneImplementation* plane) : plane_(plane)
   {
     Assert(plane);
   }
@@ -59,7 +62,7 @@ struct PointProjectionFactory
   Point* operator()(Point* from, Line* to) const;
 
  private:
-  Plane* plane_{};
+  PlaneImplementation* plane_{};
 };
 
 /**
@@ -73,7 +76,10 @@ struct LineOnPlaneFactory
    *
    * \param plane The plane on which the lines will be constructed.
    */
-  explicit LineOnPlaneFactory(Plane* plane) : plane_(plane) { Assert(plane); }
+  explicit LineOnPlaneFactory(PlaneImplementation* plane) : plane_(plane)
+  {
+    Assert(plane);
+  }
 
   /**
    * \brief Constructs a line with the given equation.
@@ -85,7 +91,7 @@ struct LineOnPlaneFactory
   Line* operator()(LineEquation equation) const;
 
  private:
-  Plane* plane_{};
+  PlaneImplementation* plane_{};
 };
 
 /**
@@ -99,7 +105,7 @@ struct LineByTwoPointsFactory
    *
    * \param plane The plane on which the lines will be constructed.
    */
-  explicit LineByTwoPointsFactory(Plane* plane) : plane_(plane)
+  explicit LineByTwoPointsFactory(PlaneImplementation* plane) : plane_(plane)
   {
     Assert(plane);
   }
@@ -115,7 +121,7 @@ struct LineByTwoPointsFactory
   Line* operator()(Point* first, Point* second) const;
 
  private:
-  Plane* plane_{};
+  PlaneImplementation* plane_{};
 };
 
 /**
@@ -129,7 +135,10 @@ struct ConicOnPlaneFactory
    *
    * \param plane The plane on which the conics will be constructed.
    */
-  explicit ConicOnPlaneFactory(Plane* plane) : plane_(plane) { Assert(plane); }
+  explicit ConicOnPlaneFactory(PlaneImplementation* plane) : plane_(plane)
+  {
+    Assert(plane);
+  }
 
   /**
    * \brief Constructs a conic with the given equation.
@@ -141,6 +150,6 @@ struct ConicOnPlaneFactory
   Conic* operator()(ConicEquation equation) const;
 
  private:
-  Plane* plane_{};
+  PlaneImplementation* plane_{};
 };
 }  // namespace HomoGebra
\ No newline at end of file
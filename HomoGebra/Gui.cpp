@@ -15,6 +15,17 @@ void Global::Update(sf::RenderWindow& window)
   ImGui::SFML::Update(window, delta_clock_.restart());
 }
 
+void Global::Update(sf::RenderWindow& window,
+                    const sf::Vector2i& mouse_position, const sf::Time delta)
+{
+  // Clock is restarted to continue when live input is back
+  delta_clock_.restart();
+  ImGui::SFML::Update(mouse_position,
+                      sf::Vector2f{static_cast<float>(window.getSize().x),
+                                   static_cast<float>(window.getSize().y)},
+                      delta);
+}
+
 void Global::Render(sf::RenderWindow& window)
 {
   // Just calls ImGui ImGui::SFML::Render method
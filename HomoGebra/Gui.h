@@ -29,6 +29,18 @@ class Global
    * \param window sf::RenderWindow where to update Dear ImGui windows.
    */
   static void Update(sf::RenderWindow& window);
+  /**
+   * \brief Updates Dear ImGui windows with the given input.
+   *
+   * \details Mouse position and time aren't taken from the system, so
+   * replayed frames are the same as recorded ones.
+   *
+   * \param window sf::RenderWindow where to update Dear ImGui windows.
+   * \param mouse_position Position of the mouse in pixels.
+   * \param delta Time since the previous update.
+   */
+  static void Update(sf::RenderWindow& window,
+                     const sf::Vector2i& mouse_position, sf::Time delta);
   /**
    * \brief Renders all Dear ImGui windows in sf::RenderWindow instance.
    *
@@ -1,6 +1,7 @@
 #include "Input.h"
 
 #include "GeometricObject.h"
+#include "ObjectConstruction.h"
 
 namespace HomoGebra
 {
@@ -38,6 +39,14 @@ void NearbyObjectGetter<GeometricObjectType>::Update(
   FindNearestObject(event.position);
 }
 
+template <class GeometricObjectType>
+void NearbyObjectGetter<GeometricObjectType>::Update(const UserEvent::Drag&)
+{}
+
+template <class GeometricObjectType>
+void NearbyObjectGetter<GeometricObjectType>::Update(const UserEvent::Unclick&)
+{}
+
 template <class GeometricObjectType>
 void NearbyObjectGetter<GeometricObjectType>::FindNearestObject(
     const sf::Vector2f& position)
@@ -50,4 +59,65 @@ template class NearbyObjectGetter<GeometricObject>;
 template class NearbyObjectGetter<Point>;
 template class NearbyObjectGetter<Line>;
 template class NearbyObjectGetter<Conic>;
+
+PointDragger::PointDragger(Plane* plane) : plane_(plane), finder_(plane)
+{
+  plane->Attach(static_cast<EventListener*>(this));
+  plane->Attach(static_cast<PlaneObserver*>(this));
+}
+
+Point* PointDragger::GetPoint() const
+{
+  return construction_ ? construction_->GetPoint() : nullptr;
+}
+
+void PointDragger::Update(const UserEvent::Click& event)
+{
+  const auto* point =
+      finder_.GetNearestObject<Point>(event.position, event.tolerance);
+  construction_ = point ? FindConstruction(point) : nullptr;
+}
+
+void PointDragger::Update(const UserEvent::Drag& event)
+{
+  if (!construction_) return;
+
+  // Point stays at the last good position, if a line through it degenerates
+  const PointEquation equation{
+      HomogeneousCoordinate{event.position.x, event.position.y}};
+  if (!construction_->CanMove(equation)) return;
+
+  construction_->Move(equation);
+}
+
+void PointDragger::Update(const UserEvent::Unclick&)
+{
+  construction_ = nullptr;
+}
+
+void PointDragger::Update(const PlaneEvent::ObjectAdded&)
+{
+  /*
+   * New objects aren't grabbed
+   */
+}
+
+void PointDragger::Update(const PlaneEvent::ObjectRemoved& object_removed)
+{
+  if (object_removed.removed_object == GetPoint()) construction_ = nullptr;
+}
+
+PointOnPlane* PointDragger::FindConstruction(const Point* point) const
+{
+  // Point is grabbed once per click, so constructions are just searched
+  for (const auto& construction :
+       plane_->GetImplementation().GetConstructions())
+  {
+    if (construction->GetObject() != point) continue;
+
+    return dynamic_cast<PointOnPlane*>(construction.get());
+  }
+
+  return nullptr;
+}
 }  // namespace HomoGebra
\ No newline at end of file
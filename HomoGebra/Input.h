@@ -4,6 +4,8 @@
 
 namespace HomoGebra
 {
+class PointOnPlane;
+
 /**
  * \brief Class to get the last object that user clicked on.
  *
@@ -49,6 +51,20 @@ class NearbyObjectGetter final : public EventListener
 
   void Update(const UserEvent::Click& event) override;
 
+  /**
+   * \brief Does nothing, dragging doesn't change the object.
+   *
+   * \param event Tag with the position.
+   */
+  void Update(const UserEvent::Drag& event) override;
+
+  /**
+   * \brief Does nothing, releasing doesn't change the object.
+   *
+   * \param event Tag with the position.
+   */
+  void Update(const UserEvent::Unclick& event) override;
+
  private:
   /**
    * \brief Finds the nearest object to the mouse.
@@ -61,4 +77,87 @@ class NearbyObjectGetter final : public EventListener
 
   ObjectProvider finder_;  //!< Helper to find objects.
 };
+
+/**
+ * \brief Moves a free point by dragging it.
+ *
+ * \details Click near a point, which is constructed on the plane, grabs it.
+ * Every drag moves it to the mouse, so objects, which depend on it, are
+ * recalculated. Unclick releases it.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see PointOnPlane
+ */
+class PointDragger final : public EventListener, public PlaneObserver
+{
+ public:
+  /**
+   * \brief Constructor.
+   *
+   * \param plane Plane, where points are dragged.
+   */
+  explicit PointDragger(Plane* plane);
+
+  /**
+   * \brief Gets the dragged point.
+   *
+   * \return Dragged point or nullptr.
+   */
+  [[nodiscard]] Point* GetPoint() const;
+
+  /**
+   * \brief Grabs the nearest free point, if it is within the tolerance.
+   *
+   * \param event Tag with the position.
+   */
+  void Update(const UserEvent::Click& event) override;
+
+  /**
+   * \brief Moves the grabbed point to the mouse.
+   *
+   * \details Move is skipped, if a line through the point would go through
+   * coincident points.
+   *
+   * \param event Tag with the position.
+   */
+  void Update(const UserEvent::Drag& event) override;
+
+  /**
+   * \brief Releases the grabbed point.
+   *
+   * \param event Tag with the position.
+   */
+  void Update(const UserEvent::Unclick& event) override;
+
+  void Update(const PlaneEvent::ObjectAdded& object_added) override;
+
+  /**
+   * \brief Releases the grabbed point, if it is removed.
+   *
+   * \param object_removed Tag with the object.
+   */
+  void Update(const PlaneEvent::ObjectRemoved& object_removed) override;
+
+ private:
+  /**
+   * \brief Finds construction of a free point.
+   *
+   * \param point Point to find.
+   *
+   * \return Construction or nullptr if the point isn't free.
+   */
+  [[nodiscard]] PointOnPlane* FindConstruction(const Point* point) const;
+
+  /**
+   * Member data.
+   */
+  Plane* plane_;                  //!< Plane, where points are dragged.
+  ObjectProvider finder_;         //!< Helper to find points.
+  PointOnPlane* construction_{};  //!< Construction of the grabbed point.
+};
 }  // namespace HomoGebra
@@ -0,0 +1,996 @@
+#include "JsonLines.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+
+#include "GeometricObject.h"
+#include "GeometricObjectFactory.h"
+#include "ObjectConstruction.h"
+#include "PlaneImplementation.h"
+
+namespace HomoGebra::JsonLines
+{
+namespace
+{
+/**
+ * \brief Array field of a record.
+ *
+ * \details Meaning of an array depends on a type of the record, so every
+ * element is kept both as a complex number and as an id.
+ */
+struct Field
+{
+  std::string key;               //!< Name of the field.
+  std::vector<Complex> numbers;  //!< Elements as numbers.
+  std::vector<std::string> ids;  //!< Elements as ids.
+  bool has_pairs = false;        //!< Is some element a pair of numbers?
+  bool has_strings = false;      //!< Is some element a string?
+};
+
+/**
+ * \brief Parsed line.
+ */
+struct Record
+{
+  /**
+   * \brief Finds an array field.
+   *
+   * \param key Name of the field.
+   *
+   * \return Field or nullptr if there is no such field.
+   */
+  [[nodiscard]] const Field* Find(std::string_view key) const
+  {
+    const auto found = std::ranges::find(fields, key, &Field::key);
+    return found != fields.end() ? &*found : nullptr;
+  }
+
+  std::string type;           //!< Type of the construction.
+  std::string id;             //!< Id of the object.
+  std::string name;           //!< Name of the object, may be empty.
+  std::vector<Field> fields;  //!< Array fields.
+};
+
+/**
+ * \brief Parser of one line.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+class LineParser
+{
+ public:
+  /**
+   * \brief Constructs parser of a line.
+   *
+   * \param text Line to parse.
+   */
+  explicit LineParser(const std::string_view text) : text_(text) {}
+
+  /**
+   * \brief Parses a record.
+   *
+   * \param record Parsed record.
+   *
+   * \return Error message, empty if the line is parsed.
+   */
+  std::string Parse(Record& record)
+  {
+    if (!ParseRecord(record)) return error_;
+
+    SkipSpaces();
+    if (position_ != text_.size())
+    {
+      Fail("unexpected characters after the record");
+      return error_;
+    }
+
+    return {};
+  }
+
+ private:
+  /**
+   * \brief Parses an object with fields of a record.
+   *
+   * \param record Parsed record.
+   *
+   * \return True if object is parsed.
+   */
+  bool ParseRecord(Record& record)
+  {
+    if (!Expect('{')) return false;
+    if (Consume('}')) return true;
+
+    std::string key;
+    do
+    {
+      if (!ParseString(key) || !Expect(':')) return false;
+
+      SkipSpaces();
+      bool is_parsed;
+      if (key == "type")
+        is_parsed = ParseString(record.type);
+      else if (key == "id")
+        is_parsed = ParseId(record.id);
+      else if (key == "name")
+        is_parsed = ParseString(record.name);
+      else if (Peek() == '[')
+        is_parsed = ParseField(key, record);
+      else
+        is_parsed = SkipValue();
+
+      if (!is_parsed) return false;
+    } while (Consume(','));
+
+    return Expect('}');
+  }
+
+  /**
+   * \brief Parses an array field.
+   *
+   * \param key Name of the field.
+   * \param record Record to add the field to.
+   *
+   * \return True if array is parsed.
+   */
+  bool ParseField(const std::string& key, Record& record)
+  {
+    auto& field = record.fields.emplace_back();
+    field.key = key;
+
+    Expect('[');
+    if (Consume(']')) return true;
+
+    do
+    {
+      SkipSpaces();
+      if (Peek() == '"')
+      {
+        field.has_strings = true;
+        field.numbers.emplace_back();
+        if (!ParseString(field.ids.emplace_back())) return false;
+      }
+      else if (Peek() == '[')
+      {
+        field.has_pairs = true;
+        field.ids.emplace_back();
+        if (!ParseComplex(field.numbers.emplace_back())) return false;
+      }
+      else
+      {
+        // Number may be both a value and an id
+        const auto start = position_;
+        long double value;
+        if (!ParseNumber(value)) return false;
+        field.numbers.emplace_back(value);
+        field.ids.emplace_back(text_.substr(start, position_ - start));
+      }
+    } while (Consume(','));
+
+    return Expect(']');
+  }
+
+  /**
+   * \brief Parses an id, which is a string or an integer.
+   *
+   * \param id Parsed id.
+   *
+   * \return True if id is parsed.
+   */
+  bool ParseId(std::string& id)
+  {
+    if (Peek() == '"') return ParseString(id);
+
+    const auto start = position_;
+    long double value;
+    if (!ParseNumber(value)) return false;
+
+    id = text_.substr(start, position_ - start);
+    return true;
+  }
+
+  /**
+   * \brief Parses a number or a pair [real, imaginary].
+   *
+   * \param value Parsed number.
+   *
+   * \return True if number is parsed.
+   */
+  bool ParseComplex(Complex& value)
+  {
+    long double real;
+    if (!Consume('['))
+    {
+      if (!ParseNumber(real)) return false;
+
+      value = Complex{real};
+      return true;
+    }
+
+    long double imaginary;
+    if (!ParseNumber(real) || !Expect(',') || !ParseNumber(imaginary) ||
+        !Expect(']'))
+    {
+      return false;
+    }
+
+    value = Complex{real, imaginary};
+    return true;
+  }
+
+  /**
+   * \brief Parses a number.
+   *
+   * \param value Parsed number.
+   *
+   * \return True if number is parsed.
+   */
+  bool ParseNumber(long double& value)
+  {
+    SkipSpaces();
+
+    double number;
+    const auto* first = text_.data() + position_;
+    const auto [last, error] =
+        std::from_chars(first, text_.data() + text_.size(), number);
+    if (error != std::errc{}) return Fail("expected a number");
+
+    // JSON has no nan and infinity, but from_chars reads them
+    if (!std::isfinite(number)) return Fail("expected a finite number");
+
+    position_ += static_cast<size_t>(last - first);
+    value = number;
+    return true;
+  }
+
+  /**
+   * \brief Parses a string.
+   *
+   * \param value Parsed string.
+   *
+   * \return True if string is parsed.
+   */
+  bool ParseString(std::string& value)
+  {
+    if (!Expect('"')) return false;
+
+    value.clear();
+    while (position_ < text_.size())
+    {
+      const auto character = text_[position_++];
+      if (character == '"') return true;
+      if (character != '\\')
+      {
+        value += character;
+        continue;
+      }
+
+      if (position_ == text_.size()) break;
+      switch (const auto escaped = text_[position_++])
+      {
+        case 'b':
+          value += '\b';
+          break;
+        case 'f':
+          value += '\f';
+          break;
+        case 'n':
+          value += '\n';
+          break;
+        case 'r':
+          value += '\r';
+          break;
+        case 't':
+          value += '\t';
+          break;
+        case 'u':
+          if (!ParseCodePoint(value)) return false;
+          break;
+        default:
+          value += escaped;
+      }
+    }
+
+    return Fail("unterminated string");
+  }
+
+  /**
+   * \brief Parses hexadecimal digits of \\u escape and appends the
+   * character in UTF-8.
+   *
+   * \param value String to append to.
+   *
+   * \return True if escape is valid.
+   */
+  bool ParseCodePoint(std::string& value)
+  {
+    auto parse_hex = [this](std::uint32_t& code)
+    {
+      constexpr size_t kDigits = 4;
+      if (text_.size() - position_ < kDigits) return false;
+
+      const auto* first = text_.data() + position_;
+      const auto [last, error] =
+          std::from_chars(first, first + kDigits, code, 16);
+      position_ += kDigits;
+      return error == std::errc{} && last == first + kDigits;
+    };
+
+    std::uint32_t code;
+    if (!parse_hex(code)) return Fail("invalid \\u escape");
+
+    // Surrogate pair
+    if (code >= 0xD800 && code < 0xDC00)
+    {
+      std::uint32_t low;
+      const auto has_low = text_.substr(position_).starts_with("\\u");
+      if (has_low) position_ += 2;
+      if (!has_low || !parse_hex(low) || low < 0xDC00 || low >= 0xE000)
+      {
+        return Fail("invalid surrogate pair");
+      }
+      code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+    }
+
+    if (code < 0x80)
+    {
+      value += static_cast<char>(code);
+    }
+    else if (code < 0x800)
+    {
+      value += static_cast<char>(0xC0 | code >> 6);
+      value += static_cast<char>(0x80 | (code & 0x3F));
+    }
+    else if (code < 0x10000)
+    {
+      value += static_cast<char>(0xE0 | code >> 12);
+      value += static_cast<char>(0x80 | (code >> 6 & 0x3F));
+      value += static_cast<char>(0x80 | (code & 0x3F));
+    }
+    else
+    {
+      value += static_cast<char>(0xF0 | code >> 18);
+      value += static_cast<char>(0x80 | (code >> 12 & 0x3F));
+      value += static_cast<char>(0x80 | (code >> 6 & 0x3F));
+      value += static_cast<char>(0x80 | (code & 0x3F));
+    }
+    return true;
+  }
+
+  /**
+   * \brief Skips a value of an unknown field.
+   *
+   * \return True if value is valid.
+   */
+  bool SkipValue()
+  {
+    SkipSpaces();
+
+    switch (Peek())
+    {
+      case '"':
+      {
+        std::string ignored;
+        return ParseString(ignored);
+      }
+      case '[':
+      case '{':
+      {
+        const auto close = Peek() == '[' ? ']' : '}';
+        ++position_;
+        if (Consume(close)) return true;
+
+        do
+        {
+          if (close == '}')
+          {
+            std::string ignored;
+            if (!ParseString(ignored) || !Expect(':')) return false;
+          }
+          if (!SkipValue()) return false;
+        } while (Consume(','));
+
+        return Expect(close);
+      }
+      default:
+      {
+        for (const std::string_view literal : {"true", "false", "null"})
+        {
+          if (text_.substr(position_).starts_with(literal))
+          {
+            position_ += literal.size();
+            return true;
+          }
+        }
+
+        long double ignored;
+        return ParseNumber(ignored);
+      }
+    }
+  }
+
+  /**
+   * \brief Skips whitespaces.
+   */
+  void SkipSpaces()
+  {
+    while (position_ < text_.size() &&
+           (text_[position_] == ' ' || text_[position_] == '\t' ||
+            text_[position_] == '\r'))
+    {
+      ++position_;
+    }
+  }
+
+  /**
+   * \brief Gets next character.
+   *
+   * \return Next character or '\0' at the end of the line.
+   */
+  [[nodiscard]] char Peek() const
+  {
+    return position_ < text_.size() ? text_[position_] : '\0';
+  }
+
+  /**
+   * \brief Skips a character if it is the next one.
+   *
+   * \param character Character to skip.
+   *
+   * \return True if character is skipped.
+   */
+  bool Consume(const char character)
+  {
+    SkipSpaces();
+    if (Peek() != character) return false;
+
+    ++position_;
+    return true;
+  }
+
+  /**
+   * \brief Skips a character, which must be the next one.
+   *
+   * \param character Character to skip.
+   *
+   * \return True if character is skipped.
+   */
+  bool Expect(const char character)
+  {
+    if (Consume(character)) return true;
+
+    return Fail(std::string("expected '") + character + '\'');
+  }
+
+  /**
+   * \brief Remembers an error.
+   *
+   * \param message What is wrong.
+   *
+   * \return Always false.
+   */
+  bool Fail(const std::string& message)
+  {
+    if (error_.empty())
+    {
+      error_ = message + " at column " + std::to_string(position_ + 1);
+    }
+    return false;
+  }
+
+  /**
+   * Member data.
+   */
+  std::string_view text_;  //!< Line to parse.
+  size_t position_ = 0;    //!< Position of the next character.
+  std::string error_;      //!< First error.
+};
+
+using Objects =
+    std::unordered_map<std::string, GeometricObject*>;  //!< Objects by ids.
+
+/**
+ * \brief Result of creation of an object by a record.
+ */
+struct Creation
+{
+  GeometricObject* object{};  //!< Created object.
+  std::string missing;        //!< Id, which isn't defined yet.
+  std::string error;          //!< What is wrong with the record.
+};
+
+/**
+ * \brief Reads complex numbers from an array field.
+ *
+ * \param record Record with the field.
+ * \param key Name of the field.
+ * \param numbers Read numbers, size of the field must be the same.
+ *
+ * \return Error message, empty if numbers are read.
+ */
+std::string ReadNumbers(const Record& record, const std::string_view key,
+                        const std::span<Complex> numbers)
+{
+  const auto* field = record.Find(key);
+  if (!field) return "no field '" + std::string(key) + '\'';
+
+  if (field->has_strings || field->numbers.size() != numbers.size())
+  {
+    return "field '" + std::string(key) + "' must have " +
+           std::to_string(numbers.size()) + " numbers";
+  }
+
+  std::ranges::copy(field->numbers, numbers.begin());
+  return {};
+}
+
+/**
+ * \brief Checks that numbers of a homogeneous coordinate are all zero.
+ *
+ * \details Such coordinate is neither a point nor a line, it can't be
+ * normalized.
+ *
+ * \param numbers x, y and z.
+ *
+ * \return True if all numbers are zero.
+ */
+bool IsZeroCoordinate(const std::array<Complex, 3>& numbers)
+{
+  return std::ranges::all_of(numbers, [](const Complex& number)
+                             { return number.IsZero(); });
+}
+
+/**
+ * \brief Creates a point by its equation.
+ *
+ * \param record Record of the point.
+ * \param plane Plane to add the point to.
+ *
+ * \return Creation of the point.
+ */
+Creation CreatePointOnPlane(const Record& record, PlaneImplementation& plane,
+                            const Objects&)
+{
+  std::array<Complex, 3> equation;
+  if (auto error = ReadNumbers(record, "equation", equation); !error.empty())
+  {
+    return {nullptr, {}, std::move(error)};
+  }
+
+  if (IsZeroCoordinate(equation))
+  {
+    return {nullptr, {}, "field 'equation' must not be zero"};
+  }
+
+  return {PointOnPlaneFactory{&plane}(PointEquation{HomogeneousCoordinate{
+              equation[0], equation[1], equation[2]}}),
+          {},
+          {}};
+}
+
+/**
+ * \brief Creates a line by its equation.
+ *
+ * \param record Record of the line.
+ * \param plane Plane to add the line to.
+ *
+ * \return Creation of the line.
+ */
+Creation CreateLineOnPlane(const Record& record, PlaneImplementation& plane,
+                           const Objects&)
+{
+  std::array<Complex, 3> equation;
+  if (auto error = ReadNumbers(record, "equation", equation); !error.empty())
+  {
+    return {nullptr, {}, std::move(error)};
+  }
+
+  if (IsZeroCoordinate(equation))
+  {
+    return {nullptr, {}, "field 'equation' must not be zero"};
+  }
+
+  return {LineOnPlaneFactory{&plane}(LineEquation{
+              HomogeneousCoordinate{equation[0], equation[1], equation[2]}}),
+          {},
+          {}};
+}
+
+/**
+ * \brief Creates a line through two points.
+ *
+ * \param record Record of the line.
+ * \param plane Plane to add the line to.
+ * \param objects Objects, which are already created.
+ *
+ * \return Creation of the line, id of a point, which isn't created yet, or
+ * error if points coincide.
+ */
+Creation CreateByTwoPoints(const Record& record, PlaneImplementation& plane,
+                           const Objects& objects)
+{
+  const auto* field = record.Find("points");
+  if (!field || field->has_pairs || field->ids.size() != 2)
+  {
+    return {nullptr, {}, "field 'points' must have 2 ids"};
+  }
+  if (field->ids[0] == field->ids[1])
+  {
+    return {nullptr, {}, "line goes through '" + field->ids[0] + "' twice"};
+  }
+
+  std::array<Point*, 2> points{};
+  for (size_t index = 0; index < points.size(); ++index)
+  {
+    const auto& id = field->ids[index];
+
+    const auto found = objects.find(id);
+    if (found == objects.end()) return {nullptr, id, {}};
+
+    points[index] = dynamic_cast<Point*>(found->second);
+    if (!points[index]) return {nullptr, {}, "'" + id + "' isn't a point"};
+  }
+
+  if (!ByTwoPoints::Fit(points[0]->GetEquation(), points[1]->GetEquation()))
+  {
+    return {nullptr,
+            {},
+            "points '" + field->ids[0] + "' and '" + field->ids[1] +
+                "' coincide"};
+  }
+
+  return {LineByTwoPointsFactory{&plane}(points[0], points[1]), {}, {}};
+}
+
+/**
+ * \brief Creates a conic by its equation.
+ *
+ * \param record Record of the conic.
+ * \param plane Plane to add the conic to.
+ *
+ * \return Creation of the conic.
+ */
+Creation CreateConicOnPlane(const Record& record, PlaneImplementation& plane,
+                            const Objects&)
+{
+  ConicEquation equation;
+  for (auto error :
+       {ReadNumbers(record, "squares", equation.squares),
+        ReadNumbers(record, "pair_products", equation.pair_products)})
+  {
+    if (!error.empty()) return {nullptr, {}, std::move(error)};
+  }
+
+  return {ConicOnPlaneFactory{&plane}(equation), {}, {}};
+}
+
+/**
+ * \brief Type of records.
+ *
+ * \details New construction is supported by adding its creator to
+ * kRecordTypes and its writing to Export().
+ */
+struct RecordType
+{
+  std::string_view name;  //!< Value of the type field.
+  Creation (*create)(const Record& record, PlaneImplementation& plane,
+                     const Objects& objects);  //!< Creates the object.
+  bool is_named_by_dependencies;  //!< Is default name made of their names?
+};
+
+constexpr std::array kRecordTypes = {
+    RecordType{"PointOnPlane", CreatePointOnPlane, false},
+    RecordType{"LineOnPlane", CreateLineOnPlane, false},
+    RecordType{"ByTwoPoints", CreateByTwoPoints, true},
+    RecordType{"ConicOnPlane", CreateConicOnPlane, false}};
+
+/**
+ * \brief Record, which can't be created yet.
+ */
+struct Pending
+{
+  size_t line;    //!< Number of the line.
+  Record record;  //!< Parsed record.
+};
+
+/**
+ * \brief Appends a string in quotes.
+ *
+ * \param line Line to append to.
+ * \param value String to append.
+ */
+void AppendString(std::string& line, const std::string_view value)
+{
+  line += '"';
+  for (const auto character : value)
+  {
+    switch (character)
+    {
+      case '"':
+        line += "\\\"";
+        break;
+      case '\\':
+        line += "\\\\";
+        break;
+      case '\n':
+        line += "\\n";
+        break;
+      default:
+        line += character;
+    }
+  }
+  line += '"';
+}
+
+/**
+ * \brief Appends the shortest representation of a number.
+ *
+ * \param line Line to append to.
+ * \param value Number to append.
+ */
+void AppendNumber(std::string& line, const long double value)
+{
+  std::array<char, 32> buffer;
+  const auto [last, error] = std::to_chars(
+      buffer.data(), buffer.data() + buffer.size(), static_cast<double>(value));
+  line.append(buffer.data(), last);
+}
+
+/**
+ * \brief Appends an array of complex numbers.
+ *
+ * \param line Line to append to.
+ * \param key Name of the field.
+ * \param numbers Numbers to append.
+ */
+void AppendNumbers(std::string& line, const std::string_view key,
+                   const std::span<const Complex> numbers)
+{
+  line += ", ";
+  AppendString(line, key);
+  line += ": [";
+  for (size_t index = 0; index < numbers.size(); ++index)
+  {
+    if (index != 0) line += ", ";
+
+    const auto& number = numbers[index];
+    if (number.imag() == 0)
+    {
+      AppendNumber(line, number.real());
+      continue;
+    }
+
+    line += '[';
+    AppendNumber(line, number.real());
+    line += ", ";
+    AppendNumber(line, number.imag());
+    line += ']';
+  }
+  line += ']';
+}
+
+/**
+ * \brief Gets numbers of a coordinate.
+ *
+ * \param coordinate Coordinate.
+ *
+ * \return x, y and z.
+ */
+std::array<Complex, 3> GetNumbers(const HomogeneousCoordinate& coordinate)
+{
+  return {coordinate[Var::kX], coordinate[Var::kY], coordinate[Var::kZ]};
+}
+}  // namespace
+
+ImportReport Import(std::istream& input, PlaneImplementation& plane)
+{
+  ImportReport report;
+
+  auto add_error = [&report](const size_t line, std::string message)
+  {
+    ++report.failed;
+    if (report.errors.size() < ImportReport::kMaxErrors)
+    {
+      report.errors.push_back({line, std::move(message)});
+    }
+  };
+
+  auto& objects = report.objects;
+  std::unordered_multimap<std::string, Pending>
+      pending;  // Records by the id they wait for
+  std::vector<Pending> ready;
+
+  // Names are assigned in batches, so collisions are resolved at once
+  std::vector<GeometricObject*> named_objects;
+  std::vector<std::string> names;
+  auto assign_names = [&]
+  {
+    plane.AssignNames(named_objects, names);
+    named_objects.clear();
+    names.clear();
+  };
+
+  auto create = [&](Pending item)
+  {
+    auto& [line, record] = item;
+
+    const auto type = std::ranges::find(kRecordTypes, record.type,
+                                        &RecordType::name);
+    if (type == kRecordTypes.end())
+    {
+      add_error(line, "unknown type '" + record.type + '\'');
+      return;
+    }
+    if (record.id.empty())
+    {
+      add_error(line, "no id");
+      return;
+    }
+    if (objects.contains(record.id))
+    {
+      add_error(line, "id '" + record.id + "' is already defined");
+      return;
+    }
+
+    // Default name of the object depends on final names
+    if (type->is_named_by_dependencies) assign_names();
+
+    auto [object, missing, error] = type->create(record, plane, objects);
+    if (!error.empty())
+    {
+      add_error(line, std::move(error));
+      return;
+    }
+    if (!missing.empty())
+    {
+      pending.emplace(std::move(missing), std::move(item));
+      return;
+    }
+
+    if (!record.name.empty())
+    {
+      named_objects.push_back(object);
+      names.push_back(std::move(record.name));
+    }
+    ++report.imported;
+
+    // Records, which waited for the object, may be created now
+    const auto [first, last] = pending.equal_range(record.id);
+    for (auto waiting = first; waiting != last; ++waiting)
+    {
+      ready.push_back(std::move(waiting->second));
+    }
+    pending.erase(first, last);
+
+    objects.emplace(std::move(record.id), object);
+  };
+
+  std::string text;
+  for (size_t line = 1; std::getline(input, text); ++line)
+  {
+    // Blank lines are allowed
+    if (std::ranges::all_of(text, [](const char character)
+                            { return character == ' ' || character == '\t' ||
+                                     character == '\r'; }))
+    {
+      continue;
+    }
+
+    Record record;
+    if (auto error = LineParser{text}.Parse(record); !error.empty())
+    {
+      add_error(line, std::move(error));
+      continue;
+    }
+
+    ready.push_back({line, std::move(record)});
+    while (!ready.empty())
+    {
+      auto item = std::move(ready.back());
+      ready.pop_back();
+      create(std::move(item));
+    }
+  }
+
+  assign_names();
+
+  // Records, which still wait, refer to objects that are never defined
+  std::vector<std::pair<size_t, std::string>> unresolved;
+  unresolved.reserve(pending.size());
+  for (const auto& [missing, item] : pending)
+  {
+    unresolved.emplace_back(item.line, missing);
+  }
+  std::ranges::sort(unresolved);
+
+  for (auto& [line, missing] : unresolved)
+  {
+    add_error(line, "'" + missing + "' is never defined");
+  }
+  std::ranges::sort(report.errors, {}, &ImportReport::Error::line);
+
+  return report;
+}
+
+bool Export(const PlaneImplementation& plane, std::ostream& output)
+{
+  std::unordered_map<const GeometricObject*, size_t> ids;
+  std::string line;
+  std::string fields;
+
+  for (const auto& construction : plane.GetConstructions())
+  {
+    const auto* object = construction->GetObject();
+    const auto id = ids.size();
+    ids.emplace(object, id);
+
+    std::string_view type;
+    fields.clear();
+
+    if (const auto* point =
+            dynamic_cast<const PointOnPlane*>(construction.get()))
+    {
+      type = "PointOnPlane";
+      AppendNumbers(fields, "equation",
+                    GetNumbers(point->GetPoint()->GetEquation().GetEquation()));
+    }
+    else if (const auto* line_on_plane =
+                 dynamic_cast<const LineOnPlane*>(construction.get()))
+    {
+      type = "LineOnPlane";
+      AppendNumbers(
+          fields, "equation",
+          GetNumbers(line_on_plane->GetLine()->GetEquation().equation));
+    }
+    else if (const auto* by_two_points =
+                 dynamic_cast<const ByTwoPoints*>(construction.get()))
+    {
+      type = "ByTwoPoints";
+      fields += ", \"points\": [";
+      fields += std::to_string(ids.at(by_two_points->GetFirstPoint()));
+      fields += ", ";
+      fields += std::to_string(ids.at(by_two_points->GetSecondPoint()));
+      fields += ']';
+    }
+    else if (const auto* conic =
+                 dynamic_cast<const ConicOnPlane*>(construction.get()))
+    {
+      const auto& equation = conic->GetConic()->GetEquation();
+      type = "ConicOnPlane";
+      AppendNumbers(fields, "squares", equation.squares);
+      AppendNumbers(fields, "pair_products", equation.pair_products);
+    }
+    else
+    {
+      // Construction isn't supported by the format
+      return false;
+    }
+
+    line.clear();
+    line += "{\"type\": ";
+    AppendString(line, type);
+    line += ", \"id\": ";
+    line += std::to_string(id);
+    if (!object->GetName().empty())
+    {
+      line += ", \"name\": ";
+      AppendString(line, object->GetName());
+    }
+    line += fields;
+    line += "}\n";
+
+    output << line;
+  }
+
+  return static_cast<bool>(output);
+}
+}  // namespace HomoGebra::JsonLines
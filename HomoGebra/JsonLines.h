@@ -0,0 +1,97 @@
+#pragma once
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace HomoGebra
+{
+class GeometricObject;
+class PlaneImplementation;
+
+/**
+ * \brief Text format of constructions, one JSON object per line.
+ *
+ * \details Every record has a type, an id, which other records refer to,
+ * an optional name and fields of its type:
+ * \code
+ * {"type": "PointOnPlane", "id": 0, "name": "A", "equation": [1, 2, 1]}
+ * {"type": "LineOnPlane", "id": 1, "equation": [1, [0, 1], 5]}
+ * {"type": "ByTwoPoints", "id": 2, "points": [0, 3]}
+ * {"type": "ConicOnPlane", "id": 4, "squares": [1, 1, -1],
+ *  "pair_products": [0, 0, 0]}
+ * \endcode
+ * Complex number is either a number or a pair [real, imaginary]. Record may
+ * refer to an object, which is defined later in the stream.
+ */
+namespace JsonLines
+{
+/**
+ * \brief Result of an import.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+struct ImportReport
+{
+  /**
+   * \brief Problem with a line.
+   */
+  struct Error
+  {
+    size_t line;          //!< Number of the line, starting from 1.
+    std::string message;  //!< What is wrong.
+  };
+
+  static constexpr size_t kMaxErrors =
+      100;  //!< Only first errors are kept, others are only counted.
+
+  size_t imported{};          //!< Amount of created objects.
+  size_t failed{};            //!< Amount of bad lines.
+  std::vector<Error> errors;  //!< First errors in order of lines.
+  std::unordered_map<std::string, GeometricObject*>
+      objects;  //!< Created objects by ids of their records.
+};
+
+/**
+ * \brief Reads constructions line by line and adds them to a plane.
+ *
+ * \details Objects are created by factories as soon as their line is read,
+ * so memory depends on amount of objects and not on size of the stream.
+ * Record, which refers to an object that isn't defined yet, waits in a
+ * pending table until the object appears. Bad lines are skipped and
+ * reported, records that still wait at the end of the stream are reported
+ * too. Point or line (0:0:0), line through coincident points and numbers,
+ * which aren't finite, are bad lines as well.
+ *
+ * Objects are created in order their references are resolved, so ids of
+ * records are kept only in the report.
+ *
+ * \param input Stream to read.
+ * \param plane Plane to add objects to.
+ *
+ * \return Report of the import.
+ */
+[[nodiscard]] ImportReport Import(std::istream& input,
+                                  PlaneImplementation& plane);
+
+/**
+ * \brief Writes constructions of a plane, one per line.
+ *
+ * \details Id of an object is its index among constructions.
+ *
+ * \param plane Plane to write.
+ * \param output Stream to write to.
+ *
+ * \return False if plane has constructions, which the format doesn't
+ * support, or stream failed.
+ */
+[[nodiscard]] bool Export(const PlaneImplementation& plane,
+                          std::ostream& output);
+}  // namespace JsonLines
+}  // namespace HomoGebra
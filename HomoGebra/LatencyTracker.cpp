@@ -0,0 +1,122 @@
+#include "LatencyTracker.h"
+
+#include <algorithm>
+
+namespace HomoGebra
+{
+namespace
+{
+/**
+ * \brief Calculates percentile of sorted values.
+ *
+ * \details Uses nearest rank as the profiler.
+ *
+ * \param values Sorted values, not empty.
+ * \param part Part of values, which are not greater than the result.
+ *
+ * \return Percentile.
+ */
+float GetPercentile(const std::vector<float>& values, const double part)
+{
+  const auto rank =
+      static_cast<size_t>(part * static_cast<double>(values.size() - 1));
+  return values[rank];
+}
+}  // namespace
+
+void LatencyTracker::Begin(const Kind kind, const std::uint64_t revision,
+                           const Clock::time_point input)
+{
+  std::scoped_lock lock(mutex_);
+
+  pending_.push_back(Change{kind, revision, input, {}});
+}
+
+void LatencyTracker::Mark(const Stage stage, const std::uint64_t revision)
+{
+  const auto now = Clock::now();
+  const auto stage_index = static_cast<size_t>(stage);
+
+  std::scoped_lock lock(mutex_);
+
+  for (auto& change : pending_)
+  {
+    // Changes are in order of revisions
+    if (change.revision > revision) break;
+    if (change.marked[stage_index]) continue;
+
+    change.marked[stage_index] = true;
+    milliseconds_[static_cast<size_t>(change.kind)][stage_index].push_back(
+        std::chrono::duration<float, std::milli>(now - change.input).count());
+  }
+
+  if (stage != Stage::kDrawn) return;
+
+  // Drawn changes are finished
+  while (!pending_.empty() && pending_.front().revision <= revision)
+  {
+    pending_.pop_front();
+  }
+}
+
+std::vector<LatencyTracker::Statistics> LatencyTracker::GetStatistics() const
+{
+  std::scoped_lock lock(mutex_);
+
+  std::vector<Statistics> statistics;
+  for (size_t kind = 0; kind < kKindCount; ++kind)
+  {
+    for (size_t stage = 0; stage < kStageCount; ++stage)
+    {
+      auto values = milliseconds_[kind][stage];
+      if (values.empty()) continue;
+
+      std::ranges::sort(values);
+      statistics.push_back({static_cast<Kind>(kind),
+                            static_cast<Stage>(stage), values.size(),
+                            GetPercentile(values, 0.5),
+                            GetPercentile(values, 0.95), values.back()});
+    }
+  }
+
+  return statistics;
+}
+
+void LatencyTracker::Write(std::ostream& output) const
+{
+  output << "kind,stage,count,median_ms,p95_ms,max_ms\n";
+  for (const auto& [kind, stage, count, median, p95, max] : GetStatistics())
+  {
+    output << GetName(kind) << ',' << GetName(stage) << ',' << count << ','
+           << median << ',' << p95 << ',' << max << '\n';
+  }
+}
+
+std::string_view LatencyTracker::GetName(const Kind kind)
+{
+  switch (kind)
+  {
+    case Kind::kClick:
+      return "click";
+    case Kind::kConstruction:
+      return "construction";
+    case Kind::kDrag:
+      return "drag";
+  }
+  return {};
+}
+
+std::string_view LatencyTracker::GetName(const Stage stage)
+{
+  switch (stage)
+  {
+    case Stage::kApplied:
+      return "applied";
+    case Stage::kPublished:
+      return "published";
+    case Stage::kDrawn:
+      return "drawn";
+  }
+  return {};
+}
+}  // namespace HomoGebra
@@ -0,0 +1,143 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace HomoGebra
+{
+/**
+ * \brief Measures time from an input to the stages of its change.
+ *
+ * \details Changes of the plane are numbered by revisions, which only grow.
+ * Input begins a change with the revision it has made. Stage is marked with
+ * the newest revision it has reached, so it is reached by all changes up to
+ * that revision. Change is finished when it is drawn.
+ *
+ * Thread-safe, stages may be marked from the worker thread.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see SceneWorker
+ */
+class LatencyTracker
+{
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * \brief Input, which changes the plane.
+   */
+  enum class Kind
+  {
+    kClick,         //!< Click on the plane, which picks or constructs.
+    kConstruction,  //!< Construction by a button.
+    kDrag           //!< Move of a dragged point.
+  };
+
+  /**
+   * \brief Stage of a change.
+   */
+  enum class Stage
+  {
+    kApplied,    //!< Worker has applied the change to the plane.
+    kPublished,  //!< Snapshot with the change is published.
+    kDrawn       //!< Snapshot with the change is displayed.
+  };
+
+  /**
+   * \brief Statistics of time from inputs of a kind to a stage.
+   */
+  struct Statistics
+  {
+    Kind kind;     //!< Kind of inputs.
+    Stage stage;   //!< Stage of changes.
+    size_t count;  //!< Amount of changes, which have reached the stage.
+    float median;  //!< Median time (ms).
+    float p95;     //!< 95th percentile of time (ms).
+    float max;     //!< Maximum time (ms).
+  };
+
+  /**
+   * \brief Begins change of the plane.
+   *
+   * \param kind Kind of the input.
+   * \param revision Revision, which the change has made.
+   * \param input Time of the input.
+   */
+  void Begin(Kind kind, std::uint64_t revision,
+             Clock::time_point input = Clock::now());
+
+  /**
+   * \brief Marks stage of all changes up to a revision.
+   *
+   * \param stage Stage, which is reached.
+   * \param revision The newest revision, which has reached the stage.
+   */
+  void Mark(Stage stage, std::uint64_t revision);
+
+  /**
+   * \brief Gets statistics of all kinds and stages.
+   *
+   * \return Statistics, kinds and stages without changes are skipped.
+   */
+  [[nodiscard]] std::vector<Statistics> GetStatistics() const;
+
+  /**
+   * \brief Writes statistics as CSV with a header.
+   *
+   * \param output Stream to write to.
+   */
+  void Write(std::ostream& output) const;
+
+  /**
+   * \brief Gets name of a kind.
+   *
+   * \param kind Kind of inputs.
+   *
+   * \return Name.
+   */
+  [[nodiscard]] static std::string_view GetName(Kind kind);
+
+  /**
+   * \brief Gets name of a stage.
+   *
+   * \param stage Stage of changes.
+   *
+   * \return Name.
+   */
+  [[nodiscard]] static std::string_view GetName(Stage stage);
+
+ private:
+  static constexpr size_t kKindCount = 3;   //!< Amount of kinds.
+  static constexpr size_t kStageCount = 3;  //!< Amount of stages.
+
+  /**
+   * \brief Change, which isn't drawn yet.
+   */
+  struct Change
+  {
+    Kind kind;                             //!< Kind of the input.
+    std::uint64_t revision;                //!< Revision of the change.
+    Clock::time_point input;               //!< Time of the input.
+    std::array<bool, kStageCount> marked;  //!< Which stages are reached.
+  };
+
+  /**
+   * Member data.
+   */
+  mutable std::mutex mutex_;  //!< Guards everything below.
+
+  std::deque<Change> pending_;  //!< Changes in order of revisions.
+  std::array<std::array<std::vector<float>, kStageCount>, kKindCount>
+      milliseconds_;  //!< Times from inputs to stages by kind and stage.
+};
+}  // namespace HomoGebra
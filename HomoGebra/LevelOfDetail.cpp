@@ -0,0 +1,269 @@
+#include "LevelOfDetail.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ranges>
+#include <string>
+#include <unordered_map>
+
+#include "ObjectView.h"
+
+namespace HomoGebra
+{
+extern float CalculateSizeOfPixel(const sf::RenderTarget& target);
+
+namespace
+{
+/**
+ * \brief Cells of the screen, which are occupied.
+ */
+class OccupancyGrid
+{
+ public:
+  /**
+   * \brief Constructs empty grid over the screen.
+   *
+   * \param size Size of the screen in pixels.
+   * \param cell_size Size of a cell in pixels.
+   */
+  OccupancyGrid(const sf::Vector2u& size, const int cell_size)
+      : cell_size_(cell_size),
+        columns_(static_cast<int>(size.x) / cell_size + 1),
+        rows_(static_cast<int>(size.y) / cell_size + 1),
+        cells_(static_cast<size_t>(columns_ * rows_), false)
+  {}
+
+  /**
+   * \brief Occupies cells of a rectangle if all of them are free.
+   *
+   * \details Parts of the rectangle outside the screen are free.
+   *
+   * \param rectangle Rectangle in pixels.
+   *
+   * \return True if rectangle was free.
+   */
+  bool TryOccupy(const sf::IntRect& rectangle)
+  {
+    const auto [first_column, first_row, last_column, last_row] =
+        GetCells(rectangle);
+
+    for (auto row = first_row; row <= last_row; ++row)
+    {
+      for (auto column = first_column; column <= last_column; ++column)
+      {
+        if (cells_[static_cast<size_t>(row * columns_ + column)]) return false;
+      }
+    }
+
+    Occupy(rectangle);
+    return true;
+  }
+
+  /**
+   * \brief Occupies cells of a rectangle.
+   *
+   * \param rectangle Rectangle in pixels.
+   */
+  void Occupy(const sf::IntRect& rectangle)
+  {
+    const auto [first_column, first_row, last_column, last_row] =
+        GetCells(rectangle);
+
+    for (auto row = first_row; row <= last_row; ++row)
+    {
+      for (auto column = first_column; column <= last_column; ++column)
+      {
+        cells_[static_cast<size_t>(row * columns_ + column)] = true;
+      }
+    }
+  }
+
+ private:
+  /**
+   * \brief Cells, which a rectangle covers.
+   */
+  struct CellRange
+  {
+    int first_column;  //!< The leftmost column.
+    int first_row;     //!< The topmost row.
+    int last_column;   //!< The rightmost column.
+    int last_row;      //!< The bottommost row.
+  };
+
+  /**
+   * \brief Finds cells of a rectangle, which are on the screen.
+   *
+   * \param rectangle Rectangle in pixels.
+   *
+   * \return Cells of the rectangle, empty range if it is off the screen.
+   */
+  [[nodiscard]] CellRange GetCells(const sf::IntRect& rectangle) const
+  {
+    auto to_cell = [this](const int pixel, const int cells)
+    { return std::clamp(pixel / cell_size_, 0, cells - 1); };
+
+    const auto right = rectangle.left + rectangle.width;
+    const auto bottom = rectangle.top + rectangle.height;
+
+    // Rectangle is off the screen
+    if (right < 0 || bottom < 0 || rectangle.left >= columns_ * cell_size_ ||
+        rectangle.top >= rows_ * cell_size_)
+    {
+      return {0, 0, -1, -1};
+    }
+
+    return {to_cell(rectangle.left, columns_), to_cell(rectangle.top, rows_),
+            to_cell(right, columns_), to_cell(bottom, rows_)};
+  }
+
+  /**
+   * Member data.
+   */
+  int cell_size_;            //!< Size of a cell in pixels.
+  int columns_;              //!< Amount of columns.
+  int rows_;                 //!< Amount of rows.
+  std::vector<bool> cells_;  //!< Is a cell occupied? Row by row.
+};
+
+/**
+ * \brief Maps rectangle on the plane to pixels.
+ *
+ * \param target Render target with the view.
+ * \param rectangle Rectangle on the plane.
+ *
+ * \return Rectangle in pixels.
+ */
+sf::IntRect MapToPixels(const sf::RenderTarget& target,
+                        const sf::FloatRect& rectangle)
+{
+  const auto first = target.mapCoordsToPixel({rectangle.left, rectangle.top});
+  const auto second =
+      target.mapCoordsToPixel({rectangle.left + rectangle.width,
+                               rectangle.top + rectangle.height});
+
+  // Axes may be flipped by the view
+  const sf::Vector2i corner{std::min(first.x, second.x),
+                            std::min(first.y, second.y)};
+  return {corner, sf::Vector2i{std::abs(second.x - first.x),
+                               std::abs(second.y - first.y)}};
+}
+}  // namespace
+
+void LevelOfDetail::Update(
+    const sf::RenderTarget& target,
+    const std::vector<std::unique_ptr<ObjectView>>& views)
+{
+  // Draw everything by default
+  std::ranges::for_each(
+      views, [](const std::unique_ptr<ObjectView>& view)
+      { view->GetBody().SetDetail(ObjectBody::Detail::kFull); });
+
+  AggregatePoints(target, views);
+  PlaceNames(target, views);
+}
+
+void LevelOfDetail::Draw(Canvas& canvas) const
+{
+  std::ranges::for_each(
+      clusters_,
+      [this, &canvas](const Cluster& cluster)
+      {
+        canvas.DrawCircle(cluster.position, cluster_radius_, kClusterColor);
+        canvas.DrawText(std::to_string(cluster.size),
+                        cluster.position +
+                            sf::Vector2f{cluster_radius_, -cluster_radius_},
+                        cluster_radius_, sf::Color::Black);
+      });
+}
+
+const std::vector<LevelOfDetail::Cluster>& LevelOfDetail::GetClusters() const
+{
+  return clusters_;
+}
+
+void LevelOfDetail::AggregatePoints(
+    const sf::RenderTarget& target,
+    const std::vector<std::unique_ptr<ObjectView>>& views)
+{
+  clusters_.clear();
+  cluster_radius_ =
+      CalculateSizeOfPixel(target) * static_cast<float>(kClusterCellPixels) /
+      2.f;
+
+  // Bodies of visible points by cell of the screen
+  std::unordered_map<long long, std::vector<PointBody*>> cells;
+  for (const auto& view : views)
+  {
+    auto* point = dynamic_cast<PointView*>(view.get());
+    if (!point || !point->GetBody().IsVisible()) continue;
+
+    auto& body = point->GetBody();
+    const auto position = body.GetPosition();
+    if (!position) continue;
+
+    const auto pixel = target.mapCoordsToPixel(position.value());
+
+    auto to_cell = [](const int coordinate)
+    {
+      return static_cast<long long>(std::floor(
+          static_cast<float>(coordinate) / kClusterCellPixels));
+    };
+
+    constexpr long long kRowSize = 1LL << 32;
+    cells[to_cell(pixel.y) * kRowSize + to_cell(pixel.x)].push_back(&body);
+  }
+
+  // Aggregate crowded cells
+  for (const auto& bodies : cells | std::views::values)
+  {
+    if (bodies.size() < kMinClusterSize) continue;
+
+    sf::Vector2f sum;
+    for (auto* body : bodies)
+    {
+      sum += body->GetPosition().value();
+      body->SetDetail(ObjectBody::Detail::kAggregated);
+    }
+
+    clusters_.push_back({sum / static_cast<float>(bodies.size()),
+                         bodies.size()});
+  }
+}
+
+void LevelOfDetail::PlaceNames(
+    const sf::RenderTarget& target,
+    const std::vector<std::unique_ptr<ObjectView>>& views) const
+{
+  OccupancyGrid grid(target.getSize(), kNameCellPixels);
+
+  // Clusters and their counts are always drawn
+  for (const auto& [position, size] : clusters_)
+  {
+    const sf::FloatRect glyph{
+        position - sf::Vector2f{cluster_radius_, 2 * cluster_radius_},
+        sf::Vector2f{2 * cluster_radius_ +
+                         cluster_radius_ *
+                             static_cast<float>(std::to_string(size).size()),
+                     3 * cluster_radius_}};
+    grid.Occupy(MapToPixels(target, glyph));
+  }
+
+  // Only points have names on the screen
+  for (const auto& view : views)
+  {
+    auto* point = dynamic_cast<PointView*>(view.get());
+    if (!point || !point->GetBody().IsVisible()) continue;
+
+    auto& body = point->GetBody();
+    if (body.GetDetail() != ObjectBody::Detail::kFull) continue;
+
+    const auto bounds = MapToPixels(target, body.GetNameBounds());
+
+    if (static_cast<float>(bounds.height) < kMinNamePixels ||
+        !grid.TryOccupy(bounds))
+    {
+      body.SetDetail(ObjectBody::Detail::kWithoutName);
+    }
+  }
+}
+}  // namespace HomoGebra
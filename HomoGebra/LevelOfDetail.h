@@ -0,0 +1,104 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+
+#include "Canvas.h"
+
+namespace HomoGebra
+{
+class ObjectView;
+
+/**
+ * \brief Chooses how much of every body is drawn.
+ *
+ * \details Keeps cost of a frame bounded by the screen, not by amount of
+ * objects:
+ * - points, which are crowded in a cell of the screen, are drawn as one
+ *   cluster with their count;
+ * - names are placed greedily in order of objects, a name overlapping
+ *   already placed one is hidden, too small names are hidden too.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see ObjectBody::Detail
+ */
+class LevelOfDetail
+{
+ public:
+  /**
+   * \brief Points, which are drawn as one glyph.
+   */
+  struct Cluster
+  {
+    sf::Vector2f position;  //!< Mean position of the points.
+    size_t size;            //!< Amount of the points.
+  };
+
+  /**
+   * \brief Chooses detail of updated bodies.
+   *
+   * \param target Render target, which bodies were updated for.
+   * \param views Views of objects to choose detail for.
+   */
+  void Update(const sf::RenderTarget& target,
+              const std::vector<std::unique_ptr<ObjectView>>& views);
+
+  /**
+   * \brief Draws clusters.
+   *
+   * \param canvas Canvas to draw to.
+   */
+  void Draw(Canvas& canvas) const;
+
+  /**
+   * \brief Gets clusters of the last update.
+   *
+   * \return Clusters.
+   */
+  [[nodiscard]] const std::vector<Cluster>& GetClusters() const;
+
+ private:
+  /**
+   * \brief Replaces crowded points with clusters.
+   *
+   * \param target Render target, which bodies were updated for.
+   * \param views Views of objects to aggregate.
+   */
+  void AggregatePoints(
+      const sf::RenderTarget& target,
+      const std::vector<std::unique_ptr<ObjectView>>& views);
+
+  /**
+   * \brief Hides names, which overlap other names or clusters.
+   *
+   * \param target Render target, which bodies were updated for.
+   * \param views Views of objects to place names of.
+   */
+  void PlaceNames(const sf::RenderTarget& target,
+                  const std::vector<std::unique_ptr<ObjectView>>& views)
+      const;
+
+  /**
+   * Member data.
+   */
+  static constexpr int kClusterCellPixels =
+      16;  //!< Size of a cell of the screen, where points are aggregated.
+  static constexpr size_t kMinClusterSize =
+      4;  //!< Minimum amount of points in a cell to aggregate them.
+  static constexpr int kNameCellPixels =
+      4;  //!< Size of a cell of the screen, which is occupied by names.
+  static constexpr float kMinNamePixels =
+      6.f;  //!< Names lower than this (in pixels) are hidden.
+
+  inline static const sf::Color kClusterColor =
+      sf::Color{160, 0, 0};  //!< Color of a cluster.
+
+  std::vector<Cluster> clusters_;  //!< Clusters of the last update.
+  float cluster_radius_{};         //!< Radius of a cluster on the plane.
+};
+}  // namespace HomoGebra
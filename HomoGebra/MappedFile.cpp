@@ -0,0 +1,102 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace HomoGebra
+{
+#ifdef _WIN32
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+  const auto file =
+      CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) return;
+
+  LARGE_INTEGER size{};
+  if (!GetFileSizeEx(file, &size))
+  {
+    CloseHandle(file);
+    return;
+  }
+  size_ = static_cast<size_t>(size.QuadPart);
+
+  // Empty file can't be mapped, but it is opened
+  if (size_ == 0)
+  {
+    CloseHandle(file);
+    is_open_ = true;
+    return;
+  }
+
+  const auto mapping =
+      CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping) return;
+
+  // View keeps the mapping alive
+  data_ = static_cast<const std::byte*>(
+      MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  CloseHandle(mapping);
+
+  is_open_ = data_ != nullptr;
+}
+
+MappedFile::~MappedFile()
+{
+  if (data_) UnmapViewOfFile(data_);
+}
+#else
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+  const auto file = open(path.c_str(), O_RDONLY);
+  if (file < 0) return;
+
+  struct stat status = {};
+  if (fstat(file, &status) != 0)
+  {
+    close(file);
+    return;
+  }
+  size_ = static_cast<size_t>(status.st_size);
+
+  // Empty file can't be mapped, but it is opened
+  if (size_ == 0)
+  {
+    close(file);
+    is_open_ = true;
+    return;
+  }
+
+  // Mapping stays valid after the file is closed
+  auto* const data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file);
+  if (data == MAP_FAILED) return;
+
+  data_ = static_cast<const std::byte*>(data);
+  is_open_ = true;
+}
+
+MappedFile::~MappedFile()
+{
+  if (data_) munmap(const_cast<std::byte*>(data_), size_);
+}
+#endif
+
+bool MappedFile::IsOpen() const { return is_open_; }
+
+std::span<const std::byte> MappedFile::GetBytes() const
+{
+  if (!data_) return {};
+
+  return {data_, size_};
+}
+}  // namespace HomoGebra
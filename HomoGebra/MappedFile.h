@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace HomoGebra
+{
+/**
+ * \brief Read-only view of a file mapped into memory.
+ *
+ * \details Pages are read by the system on the first access, so opening is
+ * cheap and bytes aren't copied into the process.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+class MappedFile
+{
+ public:
+  /**
+   * \brief Maps a file.
+   *
+   * \details IsOpen() is false if the file couldn't be mapped.
+   *
+   * \param path Path to the file.
+   */
+  explicit MappedFile(const std::filesystem::path& path);
+
+  /**
+   * \brief Unmaps the file.
+   */
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /**
+   * \brief Checks if the file is mapped.
+   *
+   * \return True if bytes of the file are available.
+   */
+  [[nodiscard]] bool IsOpen() const;
+
+  /**
+   * \brief Gets bytes of the file.
+   *
+   * \return Bytes of the file, start of them is aligned to a page.
+   */
+  [[nodiscard]] std::span<const std::byte> GetBytes() const;
+
+ private:
+  /**
+   * Member data.
+   */
+  const std::byte* data_{};  //!< Start of the mapping.
+  size_t size_{};            //!< Size of the file.
+  bool is_open_{};           //!< Is the file mapped?
+};
+}  // namespace HomoGebra
@@ -48,6 +48,9 @@ SquaredMatrix<UnderlyingType>::GetInverse() const
   // Construct copy of augmentation
   Column augmentation = augmentation_;
 
+  // Pivots are compared with the largest element, so scale doesn't matter
+  const auto scale = GetScale();
+
   // Gauss-Jordan elimination for matrix and augmentation
   for (size_t step = 0; step < size_; ++step)
   {
@@ -68,7 +71,7 @@ SquaredMatrix<UnderlyingType>::GetInverse() const
     std::swap(inverse_augmentation[step], inverse_augmentation[pivot]);
 
     // Check if matrix is singular with precision [epsilon]
-    if (IsZero(matrix[step][step]))
+    if (IsZero(matrix[step][step], scale))
     {
       return std::nullopt;
     }
@@ -114,6 +117,12 @@ UnderlyingType SquaredMatrix<UnderlyingType>::GetDeterminant() const
   // Construct copy of our matrix
   Matrix matrix = matrix_;
 
+  // Pivots are compared with the largest element, so scale doesn't matter
+  const auto scale = GetScale();
+
+  // Every swap of rows changes sign of determinant
+  bool is_negative = false;
+
   // Gauss-Jordan elimination for matrix and augmentation
   for (size_t step = 0; step < size_; ++step)
   {
@@ -128,10 +137,14 @@ UnderlyingType SquaredMatrix<UnderlyingType>::GetDeterminant() const
     }
 
     // Swap rows
-    std::swap(matrix[step], matrix[pivot]);
+    if (pivot != step)
+    {
+      std::swap(matrix[step], matrix[pivot]);
+      is_negative = !is_negative;
+    }
 
     // Check if matrix is singular with precision [epsilon]
-    if (IsZero(matrix[step][step]))
+    if (IsZero(matrix[step][step], scale))
     {
       return 0;
     }
@@ -154,7 +167,7 @@ UnderlyingType SquaredMatrix<UnderlyingType>::GetDeterminant() const
   }
 
   // Calculate determinant
-  UnderlyingType determinant = 1;
+  UnderlyingType determinant = is_negative ? -1 : 1;
   for (size_t i = 0; i < size_; ++i)
   {
     determinant *= matrix[i][i];
@@ -215,7 +228,7 @@ SquaredMatrix<UnderlyingType> SquaredMatrix<UnderlyingType>::operator*(
     const SquaredMatrix& other) const
 {
   // Check if matrices are compatible
-  Assert(size_ != other.size_, "Matrices sizes are different!");
+  Assert(size_ == other.size_, "Matrices sizes are different!");
 
   // Construct new matrix filled with zeros
   SquaredMatrix result(size_);
@@ -241,7 +254,7 @@ std::vector<UnderlyingType> SquaredMatrix<UnderlyingType>::operator*(
     const std::vector<UnderlyingType>& vector) const
 {
   // Check if vector is compatible
-  Assert(vector.size() != size_, "Vector size is incorrect!");
+  Assert(vector.size() == size_, "Vector size is incorrect!");
 
   // Construct new vector filled with zeros
   std::vector<UnderlyingType> result(size_);
@@ -273,6 +286,21 @@ SquaredMatrix<UnderlyingType>::operator[](const size_t row) const
   return matrix_[row];
 }
 
+template <typename UnderlyingType>
+long double SquaredMatrix<UnderlyingType>::GetScale() const
+{
+  long double scale = 0;
+  for (const auto& row : matrix_)
+  {
+    for (const auto& value : row)
+    {
+      scale = std::max(scale, static_cast<long double>(std::abs(value)));
+    }
+  }
+
+  return scale;
+}
+
 template <typename UnderlyingType>
 typename SquaredMatrix<UnderlyingType>::Matrix::const_iterator
 SquaredMatrix<UnderlyingType>::begin() const
@@ -293,26 +321,30 @@ SquaredMatrix<UnderlyingType>::end() const
  * \brief Explicit template specialization for complex numbers
  *
  * \param value Value to check
+ * \param scale Largest absolute value in the matrix
  *
  * \return True if value is zero, false otherwise
  */
 template <>
-bool SquaredMatrix<Complex>::IsZero(const Complex& value) const
+bool SquaredMatrix<Complex>::IsZero(const Complex& value,
+                                    const long double scale) const
 {
-  return value.IsZero();
+  return scale == 0 || (value / Complex{scale}).IsZero();
 }
 
 /**
  * \brief Explicit template specialization for float numbers
  *
  * \param value Value to check
+ * \param scale Largest absolute value in the matrix
  *
  * \return True if value is zero, false otherwise
  */
 template <>
-bool SquaredMatrix<float>::IsZero(const float& value) const
+bool SquaredMatrix<float>::IsZero(const float& value,
+                                  const long double scale) const
 {
-  return Complex{static_cast<long double>(value)}.IsZero();
+  return scale == 0 || Complex{value / scale}.IsZero();
 }
 
 template class SquaredMatrix<Complex>;
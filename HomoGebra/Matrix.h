@@ -41,6 +41,9 @@ class SquaredMatrix
   /**
    * \brief Finds inversion of matrix.
    *
+   * \details Matrix is singular, if a pivot is negligible compared to the
+   * largest element.
+   *
    * \return Inverse matrix if it exists, otherwise std::nullopt.
    */
   [[nodiscard]] std::optional<SquaredMatrix> GetInverse() const;
@@ -144,13 +147,25 @@ class SquaredMatrix
   SquaredMatrix() = default;
 
   /**
-   * \brief Checks if value is zero.
+   * \brief Finds the largest absolute value of elements.
+   *
+   * \return Largest absolute value, zero for zero matrix.
+   */
+  [[nodiscard]] long double GetScale() const;
+
+  /**
+   * \brief Checks if value is zero compared to elements of the matrix.
+   *
+   * \details Value is compared relatively, so a matrix and the same matrix
+   * multiplied by a number are both singular or both not.
    *
    * \param value Value.
+   * \param scale Largest absolute value of elements.
    *
    * \return True if value is zero, false otherwise.
    */
-  [[nodiscard]] bool IsZero(const UnderlyingType& value) const;
+  [[nodiscard]] bool IsZero(const UnderlyingType& value,
+                            long double scale) const;
 
   /**
    * Member data.
@@ -60,6 +60,152 @@ ParsedName::operator std::string() const
          static_cast<std::string>(parsed_subname);
 }
 
+bool NumberSet::Add(const size_t number)
+{
+  // Run after the number
+  auto next = runs_.upper_bound(number);
+
+  const auto previous =
+      next == runs_.begin() ? runs_.end() : std::prev(next);
+  if (previous != runs_.end() && previous->second >= number) return false;
+
+  const auto joins_previous =
+      previous != runs_.end() && previous->second + 1 == number;
+  const auto joins_next = next != runs_.end() && next->first == number + 1;
+
+  if (joins_previous && joins_next)
+  {
+    previous->second = next->second;
+    runs_.erase(next);
+  }
+  else if (joins_previous)
+  {
+    previous->second = number;
+  }
+  else if (joins_next)
+  {
+    const auto last = next->second;
+    runs_.erase(next);
+    runs_.emplace(number, last);
+  }
+  else
+  {
+    runs_.emplace(number, number);
+  }
+
+  return true;
+}
+
+bool NumberSet::Delete(const size_t number)
+{
+  const auto run = FindRun(number);
+  if (run == runs_.end()) return false;
+
+  const auto [first, last] = *run;
+  runs_.erase(run);
+
+  // Split the run around the number
+  if (first < number) runs_.emplace(first, number - 1);
+  if (number < last) runs_.emplace(number + 1, last);
+
+  return true;
+}
+
+bool NumberSet::Contains(const size_t number) const
+{
+  return FindRun(number) != runs_.end();
+}
+
+size_t NumberSet::GetLowestFree() const
+{
+  if (runs_.empty() || runs_.begin()->first != 0) return 0;
+
+  return runs_.begin()->second + 1;
+}
+
+bool NumberSet::IsEmpty() const { return runs_.empty(); }
+
+std::map<size_t, size_t>::const_iterator NumberSet::FindRun(
+    const size_t number) const
+{
+  const auto next = runs_.upper_bound(number);
+  if (next == runs_.begin()) return runs_.end();
+
+  const auto run = std::prev(next);
+  return run->second >= number ? run : runs_.end();
+}
+
+size_t NamePool::Hash(const std::string_view key)
+{
+  return std::hash<std::string_view>{}(key);
+}
+
+NamePool::Handle NamePool::Find(const std::string_view key,
+                                const size_t hash) const
+{
+  if (slots_.empty()) return kNone;
+
+  return slots_[FindSlot(key, hash)];
+}
+
+NamePool::Handle NamePool::Intern(const std::string_view key,
+                                  const size_t hash)
+{
+  // Load factor is kept not greater than a half
+  if (2 * (keys_.size() + 1) > slots_.size()) Grow();
+
+  auto& slot = slots_[FindSlot(key, hash)];
+  if (slot != kNone) return slot;
+
+  slot = static_cast<Handle>(keys_.size());
+  keys_.emplace_back(key);
+  hashes_.push_back(hash);
+  return slot;
+}
+
+std::string_view NamePool::GetKey(const Handle handle) const
+{
+  return keys_[handle];
+}
+
+size_t NamePool::GetSize() const { return keys_.size(); }
+
+size_t NamePool::FindSlot(const std::string_view key, const size_t hash) const
+{
+  // Amount of slots is a power of two
+  const auto mask = slots_.size() - 1;
+
+  for (auto slot = hash & mask;; slot = (slot + 1) & mask)
+  {
+    const auto handle = slots_[slot];
+    if (handle == kNone) return slot;
+    if (hashes_[handle] == hash && keys_[handle] == key) return slot;
+  }
+}
+
+void NamePool::Grow()
+{
+  slots_.assign(std::max<size_t>(16, 2 * slots_.size()), kNone);
+
+  const auto mask = slots_.size() - 1;
+  for (Handle handle = 0; handle < keys_.size(); ++handle)
+  {
+    auto slot = hashes_[handle] & mask;
+    while (slots_[slot] != kNone) slot = (slot + 1) & mask;
+    slots_[slot] = handle;
+  }
+}
+
+NameGenerator::NameGenerator()
+{
+  // All letters are free
+  letter_ranks_.fill(-1);
+  for (size_t index = 0; index < kAlphabet.size(); ++index)
+  {
+    letters_.emplace(-1, index);
+  }
+}
+
 bool NameGenerator::AddName(const std::string& name)
 {
   // Parse subname
@@ -75,7 +221,25 @@ bool NameGenerator::AddName(const ParsedName& name)
     return false;
   }
 
-  return used_names_.AddItem(name);
+  const auto key = GetBaseKey(name);
+  const auto handle = base_keys_.Intern(key, NamePool::Hash(key));
+  if (handle == bases_.size()) bases_.emplace_back();
+
+  auto& base = bases_[handle];
+
+  const auto& number = name.parsed_subname.number;
+  if (number.has_value())
+  {
+    if (!base.numbers.Add(number.value())) return false;
+  }
+  else
+  {
+    if (base.is_used) return false;
+    base.is_used = true;
+  }
+
+  UpdateLetter(handle);
+  return true;
 }
 
 bool NameGenerator::DeleteName(const std::string& name)
@@ -92,7 +256,26 @@ bool NameGenerator::DeleteName(const ParsedName& name)
   {
     return false;
   }
-  return used_names_.DeleteItem(name);
+
+  const auto key = GetBaseKey(name);
+  const auto handle = base_keys_.Find(key, NamePool::Hash(key));
+  if (handle == NamePool::kNone) return false;
+
+  auto& base = bases_[handle];
+
+  const auto& number = name.parsed_subname.number;
+  if (number.has_value())
+  {
+    if (!base.numbers.Delete(number.value())) return false;
+  }
+  else
+  {
+    if (!base.is_used) return false;
+    base.is_used = false;
+  }
+
+  UpdateLetter(handle);
+  return true;
 }
 
 bool NameGenerator::IsNameUsed(const std::string& name) const
@@ -106,7 +289,13 @@ bool NameGenerator::IsNameUsed(const ParsedName& name) const
   {
     return false;
   }
-  return used_names_.IsItemUsed(name);
+
+  const auto* base = FindBase(name);
+  if (!base) return false;
+
+  const auto& number = name.parsed_subname.number;
+  return number.has_value() ? base->numbers.Contains(number.value())
+                            : base->is_used;
 }
 
 bool NameGenerator::Rename(const std::string& old_name,
@@ -151,28 +340,13 @@ bool NameGenerator::Rename(const ParsedName& old_name,
 
 ParsedName NameGenerator::GenerateName() const
 {
-  // We will go through all alphabet
-  constexpr std::string_view kAlphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-  std::array<signed long long, kAlphabet.size()> amount_of_uses{};
-
-  // Going through all alphabet
-  for (size_t character = 0; character < kAlphabet.size(); ++character)
-  {
-    const auto [name, parsed_subname] =
-        GenerateName(std::string{kAlphabet[character]});
-    const auto& [subname, parsed_number] = parsed_subname;
-
-    amount_of_uses[character] =
-        static_cast<signed long long>(parsed_number.value_or(-1));
-  }
+  // First letter with the smallest number
+  const auto [rank, index] = *letters_.begin();
 
-  // Find first character with the smallest number
-  const auto smallest_character =
-      std::min_element(amount_of_uses.begin(), amount_of_uses.end());
+  ParsedName name{std::string{kAlphabet[index]}, ParsedSubname()};
+  if (rank >= 0) name.parsed_subname.number = static_cast<size_t>(rank);
 
-  // Generate name with smallest number
-  return GenerateName(std::string{
-      kAlphabet[std::distance(amount_of_uses.begin(), smallest_character)]});
+  return name;
 }
 
 ParsedName NameGenerator::GenerateName(const std::string& name) const
@@ -182,7 +356,7 @@ ParsedName NameGenerator::GenerateName(const std::string& name) const
   if (IsNameEmpty(parsed_name)) return GenerateName();
 
   // Check if name is used
-  if (!used_names_.IsItemUsed(parsed_name))
+  if (!IsNameUsed(parsed_name))
   {
     // Return name
     return parsed_name;
@@ -192,6 +366,38 @@ ParsedName NameGenerator::GenerateName(const std::string& name) const
   return GenerateSubname(parsed_name);
 }
 
+std::vector<std::string> NameGenerator::ReserveNames(
+    const std::span<const std::string> names)
+{
+  std::vector<std::string> reserved(names.size());
+
+  // Free names are kept
+  std::vector<size_t> collided;
+  for (size_t index = 0; index < names.size(); ++index)
+  {
+    if (names[index].empty()) continue;
+
+    if (AddName(names[index]))
+    {
+      reserved[index] = names[index];
+    }
+    else
+    {
+      collided.push_back(index);
+    }
+  }
+
+  // Other ones are adjusted after all free names are taken
+  for (const auto index : collided)
+  {
+    const auto adjusted = GenerateName(names[index]);
+    AddName(adjusted);
+    reserved[index] = static_cast<std::string>(adjusted);
+  }
+
+  return reserved;
+}
+
 ParsedName NameGenerator::ParseName(const std::string& name)
 {
   // Find delimiter in subname
@@ -234,6 +440,12 @@ ParsedSubname NameGenerator::ParseSubname(const std::string& subname)
                      std::not_fn(std::isdigit))
             .base();
 
+    // Check if subname doesn't end with a number (for example "1A")
+    if (position_of_number == subname.end())
+    {
+      return {subname, {std::nullopt}};
+    }
+
     // Get subname without number
     const auto name_without_number =
         std::string{subname.begin(), position_of_number};
@@ -259,27 +471,60 @@ ParsedName NameGenerator::GenerateNumber(const ParsedName& parsed_name) const
 
   parsed_number = {std::nullopt};
 
+  const auto* base = FindBase(adjusted_name);
+
   // Check if empty is not used
-  if (!used_names_.IsItemUsed(adjusted_name))
+  if (!base || !base->is_used)
   {
     return adjusted_name;
   }
 
-  // Start to check all numbers from 0
-  for (size_t number = 0;; ++number)
-  {
-    parsed_number = {number};
-
-    // Check if number was used
-    if (!used_names_.IsItemUsed(adjusted_name))
-    {
-      return adjusted_name;
-    }
-  }
+  // Take the lowest free number
+  parsed_number = {base->numbers.GetLowestFree()};
+  return adjusted_name;
 }
 
 bool NameGenerator::IsNameEmpty(const ParsedName& parsed_name) const
 {
   return parsed_name.name.empty();
 }
+
+long long NameGenerator::Base::GetRank() const
+{
+  return is_used ? static_cast<long long>(numbers.GetLowestFree()) : -1;
+}
+
+std::string NameGenerator::GetBaseKey(const ParsedName& parsed_name)
+{
+  const auto& subname = parsed_name.parsed_subname.subname;
+  if (subname.empty()) return parsed_name.name;
+
+  return parsed_name.name + kDelimiter + subname;
+}
+
+const NameGenerator::Base* NameGenerator::FindBase(
+    const ParsedName& parsed_name) const
+{
+  const auto key = GetBaseKey(parsed_name);
+  const auto handle = base_keys_.Find(key, NamePool::Hash(key));
+
+  return handle == NamePool::kNone ? nullptr : &bases_[handle];
+}
+
+void NameGenerator::UpdateLetter(const NamePool::Handle handle)
+{
+  const auto key = base_keys_.GetKey(handle);
+  if (key.size() != 1) return;
+
+  const auto index = kAlphabet.find(key.front());
+  if (index == std::string_view::npos) return;
+
+  // Move letter to its new rank
+  const auto rank = bases_[handle].GetRank();
+  if (letter_ranks_[index] == rank) return;
+
+  letters_.erase({letter_ranks_[index], index});
+  letter_ranks_[index] = rank;
+  letters_.emplace(rank, index);
+}
 }  // namespace HomoGebra
\ No newline at end of file
@@ -1,6 +1,14 @@
 #pragma once
+#include <array>
+#include <cstdint>
+#include <map>
 #include <optional>
+#include <set>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "Dictionary.h"
 namespace HomoGebra
@@ -94,12 +102,185 @@ struct ParsedName
 
 using NameDictionary = Dictionary<ParsedName>;
 
+/**
+ * \brief Set of numbers, which finds the lowest number not in it.
+ *
+ * \details Numbers are kept as disjoint runs of consecutive numbers, so
+ * adding, deleting and finding the lowest free number take O(log n), where
+ * n is amount of runs. Numbers may be arbitrary large, e.g. a number of a
+ * name given by user.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+class NumberSet
+{
+ public:
+  /**
+   * \brief Adds number to the set.
+   *
+   * \param number Number to add.
+   *
+   * \return True if number was not in the set, false otherwise.
+   */
+  bool Add(size_t number);
+
+  /**
+   * \brief Deletes number from the set.
+   *
+   * \param number Number to delete.
+   *
+   * \return True if number was deleted, false otherwise.
+   */
+  bool Delete(size_t number);
+
+  /**
+   * \brief Checks if number is in the set.
+   *
+   * \param number Number to check.
+   *
+   * \return True if number is in, false otherwise.
+   */
+  [[nodiscard]] bool Contains(size_t number) const;
+
+  /**
+   * \brief Finds the lowest number, which is not in the set.
+   *
+   * \return The lowest free number.
+   */
+  [[nodiscard]] size_t GetLowestFree() const;
+
+  /**
+   * \brief Checks if set is empty.
+   *
+   * \return True if set is empty, false otherwise.
+   */
+  [[nodiscard]] bool IsEmpty() const;
+
+ private:
+  /**
+   * \brief Finds run, which contains number.
+   *
+   * \param number Number to find.
+   *
+   * \return Iterator to the run or end if number is not in the set.
+   */
+  [[nodiscard]] std::map<size_t, size_t>::const_iterator FindRun(
+      size_t number) const;
+
+  /**
+   * Member data.
+   */
+  std::map<size_t, size_t> runs_;  //!< First number of a run to its last.
+};
+
+/**
+ * \brief Interned strings, which are found by hash.
+ *
+ * \details Every distinct string is stored once and is given a handle,
+ * which is its index, so data of a string may be kept in a vector. Strings
+ * are found in an open addressing table with linear probing. Strings are
+ * never removed, so the table needs no tombstones.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+class NamePool
+{
+ public:
+  using Handle = std::uint32_t;
+
+  static constexpr Handle kNone = ~Handle{0};  //!< Handle of no string.
+
+  /**
+   * \brief Hashes string.
+   *
+   * \param key String to hash.
+   *
+   * \return Hash of the string.
+   */
+  [[nodiscard]] static size_t Hash(std::string_view key);
+
+  /**
+   * \brief Finds string.
+   *
+   * \param key String to find.
+   * \param hash Hash of the string.
+   *
+   * \return Handle of the string or kNone if it isn't interned.
+   */
+  [[nodiscard]] Handle Find(std::string_view key, size_t hash) const;
+
+  /**
+   * \brief Finds string or interns it.
+   *
+   * \param key String to intern.
+   * \param hash Hash of the string.
+   *
+   * \return Handle of the string.
+   */
+  Handle Intern(std::string_view key, size_t hash);
+
+  /**
+   * \brief Gets interned string.
+   *
+   * \param handle Handle of the string.
+   *
+   * \return String.
+   */
+  [[nodiscard]] std::string_view GetKey(Handle handle) const;
+
+  /**
+   * \brief Gets amount of interned strings.
+   *
+   * \return Amount of strings.
+   */
+  [[nodiscard]] size_t GetSize() const;
+
+ private:
+  /**
+   * \brief Finds slot of a string or the empty slot, where it would be.
+   *
+   * \param key String to find.
+   * \param hash Hash of the string.
+   *
+   * \return Index of the slot.
+   */
+  [[nodiscard]] size_t FindSlot(std::string_view key, size_t hash) const;
+
+  /**
+   * \brief Doubles amount of slots and puts all strings again.
+   */
+  void Grow();
+
+  /**
+   * Member data.
+   */
+  std::vector<Handle> slots_;      //!< Handles, amount is a power of two.
+  std::vector<std::string> keys_;  //!< Strings by handle.
+  std::vector<size_t> hashes_;     //!< Hashes of strings by handle.
+};
+
 /**
  * \brief Class to generate new names.
  *
  * \details This class is used to generate new names for objects. Also it
  * can change a lit bit a name to make it unique.
  *
+ * Names are grouped by base: name and subname without number. Bases are
+ * interned, so a name is found by one hash of its base. Every base keeps
+ * if it is used without number and a set of used numbers, so the lowest
+ * free number is found without trying numbers one by one. Single
+ * letters, which are generated by default, are ordered by the number they
+ * would get next. So adding, deleting and generating a name take
+ * O(log n).
+ *
  * \author nook0110
  *
  * \version 0.3
@@ -115,7 +296,7 @@ class NameGenerator
    * \brief Default constructor.
    *
    */
-  NameGenerator() = default;
+  NameGenerator();
 
   /**
    * \brief Add name to used names.
@@ -208,6 +389,21 @@ class NameGenerator
    */
   [[nodiscard]] ParsedName GenerateName(const std::string& name) const;
 
+  /**
+   * \brief Adds names of a batch, adjusting the used ones.
+   *
+   * \details At first all names, which are free, are added in one pass, so
+   * they are kept as they are. Then names, which were used or repeated in
+   * the batch, are adjusted and added in order of the batch. So result
+   * doesn't depend on anything but the batch and used names. Takes
+   * O(n log n).
+   *
+   * \param names Names to add, empty ones are skipped.
+   *
+   * \return Added names in order of the batch, empty for skipped ones.
+   */
+  std::vector<std::string> ReserveNames(std::span<const std::string> names);
+
   /**
    * \brief Parses name.
    *
@@ -252,6 +448,61 @@ class NameGenerator
    */
   [[nodiscard]] bool IsNameEmpty(const ParsedName& parsed_name) const;
 
-  NameDictionary used_names_;  //!< Dictionary of used names.
+  /**
+   * \brief Used names with the same name and subname.
+   */
+  struct Base
+  {
+    bool is_used = false;  //!< Is base used without number?
+    NumberSet numbers;     //!< Used numbers of the base.
+
+    /**
+     * \brief Gets rank of the next name of the base.
+     *
+     * \return -1 if base is free, the lowest free number otherwise.
+     */
+    [[nodiscard]] long long GetRank() const;
+  };
+
+  /**
+   * \brief Gets key of the base of a name.
+   *
+   * \details Name has no delimiter, so the key is unique.
+   *
+   * \param parsed_name Name.
+   *
+   * \return Name and subname without number.
+   */
+  [[nodiscard]] static std::string GetBaseKey(const ParsedName& parsed_name);
+
+  /**
+   * \brief Finds base of a name.
+   *
+   * \param parsed_name Name.
+   *
+   * \return Base or nullptr if no name of the base was used.
+   */
+  [[nodiscard]] const Base* FindBase(const ParsedName& parsed_name) const;
+
+  /**
+   * \brief Updates order of a letter if base is a letter of the alphabet.
+   *
+   * \param handle Handle of the base, which has changed.
+   */
+  void UpdateLetter(NamePool::Handle handle);
+
+  static constexpr std::string_view kAlphabet =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZ";  //!< Letters to generate names from.
+
+  /**
+   * Member data.
+   */
+  NamePool base_keys_;       //!< Keys of bases, which were ever used.
+  std::vector<Base> bases_;  //!< Bases by handle of their keys.
+
+  std::array<long long, kAlphabet.size()>
+      letter_ranks_;  //!< Ranks of letters by index.
+  std::set<std::pair<long long, size_t>>
+      letters_;  //!< Letters by rank, then by index.
 };
 }  // namespace HomoGebra
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "NameIndex.h"
+
+namespace HomoGebra
+{
+bool NameIndex::Add(const std::string& name, GeometricObject* object)
+{
+  ++version_;
+  if (name.empty()) return false;
+
+  const auto [added, inserted] = objects_.try_emplace(name, object);
+  if (!inserted) return false;
+
+  // Node keys of the hash map don't move, so they are viewed
+  ordered_objects_.emplace(added->first, object);
+  return true;
+}
+
+bool NameIndex::Remove(const std::string_view name,
+                       const GeometricObject* object)
+{
+  ++version_;
+  const auto found = objects_.find(name);
+  if (found == objects_.end() || found->second != object) return false;
+
+  ordered_objects_.erase(found->first);
+  objects_.erase(found);
+  return true;
+}
+
+GeometricObject* NameIndex::Find(const std::string_view name) const
+{
+  const auto found = objects_.find(name);
+  return found == objects_.end() ? nullptr : found->second;
+}
+
+std::vector<GeometricObject*> NameIndex::FindByPrefix(
+    const std::string_view prefix, const size_t limit) const
+{
+  std::vector<GeometricObject*> objects;
+
+  for (auto name = ordered_objects_.lower_bound(prefix);
+       name != ordered_objects_.end() && objects.size() < limit &&
+       name->first.starts_with(prefix);
+       ++name)
+  {
+    objects.push_back(name->second);
+  }
+
+  return objects;
+}
+
+size_t NameIndex::GetSize() const { return objects_.size(); }
+
+size_t NameIndex::GetVersion() const { return version_; }
+}  // namespace HomoGebra
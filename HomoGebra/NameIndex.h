@@ -0,0 +1,115 @@
+#pragma once
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace HomoGebra
+{
+class GeometricObject;
+
+/**
+ * \brief Index of objects by their names.
+ *
+ * \details Object is found by name in O(1) expected time. Names are also
+ * kept in order, so objects with names starting with a prefix are found in
+ * O(log n) plus amount of found objects, e.g. for autocompletion. Empty
+ * names aren't indexed.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see NameGenerator
+ */
+class NameIndex
+{
+ public:
+  /**
+   * \brief Adds object with a name.
+   *
+   * \param name Name of the object.
+   * \param object Object to add.
+   *
+   * \return True if name was not indexed, false otherwise.
+   */
+  bool Add(const std::string& name, GeometricObject* object);
+
+  /**
+   * \brief Removes object with a name.
+   *
+   * \details Name is removed only if it belongs to the object, so a name,
+   * which was given to another object, is kept.
+   *
+   * \param name Name of the object.
+   * \param object Object to remove.
+   *
+   * \return True if name was removed, false otherwise.
+   */
+  bool Remove(std::string_view name, const GeometricObject* object);
+
+  /**
+   * \brief Finds object by name.
+   *
+   * \param name Name of the object.
+   *
+   * \return Object or nullptr if no object has the name.
+   */
+  [[nodiscard]] GeometricObject* Find(std::string_view name) const;
+
+  /**
+   * \brief Finds objects, which names start with a prefix.
+   *
+   * \param prefix Prefix of names.
+   * \param limit Maximal amount of objects.
+   *
+   * \return Objects in order of their names.
+   */
+  [[nodiscard]] std::vector<GeometricObject*> FindByPrefix(
+      std::string_view prefix, size_t limit) const;
+
+  /**
+   * \brief Gets amount of indexed names.
+   *
+   * \return Amount of names.
+   */
+  [[nodiscard]] size_t GetSize() const;
+
+  /**
+   * \brief Gets version of the index.
+   *
+   * \details Version changes on every addition or removal, even if the name
+   * isn't indexed, so every rename of an object changes it.
+   *
+   * \return Version.
+   */
+  [[nodiscard]] size_t GetVersion() const;
+
+ private:
+  /**
+   * \brief Hash, which finds strings by std::string_view.
+   */
+  struct Hash
+  {
+    using is_transparent = void;
+
+    [[nodiscard]] size_t operator()(const std::string_view name) const
+    {
+      return std::hash<std::string_view>{}(name);
+    }
+  };
+
+  /**
+   * Member data.
+   */
+  std::unordered_map<std::string, GeometricObject*, Hash, std::equal_to<>>
+      objects_;  //!< Objects by name.
+  std::map<std::string_view, GeometricObject*>
+      ordered_objects_;  //!< Objects in order of names, keys are in objects_.
+  size_t version_ = 0;  //!< Changes on every addition or removal.
+};
+}  // namespace HomoGebra
@@ -59,6 +59,38 @@ void PointOnPlane::RecalculateEquation()
   SetEquation(equation_);
 }
 
+void PointOnPlane::Move(PointEquation equation)
+{
+  equation_ = std::move(equation);
+
+  // Notifies dependent objects
+  RecalculateEquation();
+}
+
+bool PointOnPlane::CanMove(const PointEquation& equation) const
+{
+  const auto& coordinate = equation.GetEquation();
+  if (coordinate.x.IsZero() && coordinate.y.IsZero() && coordinate.z.IsZero())
+  {
+    return false;
+  }
+
+  // Lines by two points are attached to their points
+  const auto* point = GetPoint();
+  for (const auto* observer : point->GetObservers())
+  {
+    const auto* line = dynamic_cast<const ByTwoPoints*>(observer);
+    if (!line) continue;
+
+    const auto* other = line->GetFirstPoint() == point
+                            ? line->GetSecondPoint()
+                            : line->GetFirstPoint();
+    if (!ByTwoPoints::Fit(equation, other->GetEquation())) return false;
+  }
+
+  return true;
+}
+
 GeometricObject* ConstructionLine::GetObject() const
 {
   // Return line
@@ -122,6 +154,18 @@ ByTwoPoints::ByTwoPoints(Point* first_point, Point* second_point)
   RecalculateEquation();
 }
 
+ByTwoPoints::ByTwoPoints(Point* first_point, Point* second_point,
+                         const LineEquation& equation)
+    : first_point_(first_point), second_point_(second_point)
+{
+  // Attach to points
+  first_point_->Attach(this);
+  second_point_->Attach(this);
+
+  // Set known equation
+  SetEquation(equation);
+}
+
 ByTwoPoints::~ByTwoPoints()
 {
   // Detach from points
@@ -129,10 +173,9 @@ ByTwoPoints::~ByTwoPoints()
   second_point_->Detach(this);
 }
 
-void ByTwoPoints::RecalculateEquation()
+std::optional<LineEquation> ByTwoPoints::Fit(const PointEquation& first,
+                                             const PointEquation& second)
 {
-  // Construct equation
-
   // Calculate equation of a line that goes through 2 points
   // We need to solve the system of equations [matrix]:
   // f_ is first, s_ is second
@@ -142,8 +185,8 @@ void ByTwoPoints::RecalculateEquation()
   // |  r   r   r  | 1 |
 
   // Get equations of points
-  const auto& f_equation = first_point_->GetEquation().GetEquation();
-  const auto& s_equation = second_point_->GetEquation().GetEquation();
+  const auto& f_equation = first.GetEquation();
+  const auto& s_equation = second.GetEquation();
 
   // Create matrix
   HomoGebra::ComplexSquaredMatrix matrix{3};
@@ -195,16 +238,33 @@ void ByTwoPoints::RecalculateEquation()
   // Get solution
   const auto solution = matrix.GetSolution();
 
-  // Check if solution exists
-  Assert(solution.has_value(), "Matrix has no solution!");
+  // Points coincide
+  if (!solution.has_value()) return std::nullopt;
 
   // Get value
   const auto& value = *solution;
 
   // Create equation
-  SetEquation(LineEquation({value[0], value[1], value[2]}));
+  return LineEquation({value[0], value[1], value[2]});
+}
+
+void ByTwoPoints::RecalculateEquation()
+{
+  // Find equation
+  const auto equation =
+      Fit(first_point_->GetEquation(), second_point_->GetEquation());
+
+  // Check if solution exists
+  Assert(equation.has_value(), "Matrix has no solution!");
+
+  // Set equation
+  SetEquation(*equation);
 }
 
+Point* ByTwoPoints::GetFirstPoint() const { return first_point_; }
+
+Point* ByTwoPoints::GetSecondPoint() const { return second_point_; }
+
 GeometricObject* ConstructionConic::GetObject() const
 {
   // Return conic
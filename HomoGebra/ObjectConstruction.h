@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+
 #include "Construction.h"
 #include "Equation.h"
 
@@ -121,6 +123,25 @@ class PointOnPlane : public ConstructionPoint, public StrongConstruction
    */
   void RecalculateEquation() override;
 
+  /**
+   * \brief Moves point, objects, which depend on it, are recalculated.
+   *
+   * \param equation New equation of point.
+   */
+  void Move(PointEquation equation);
+
+  /**
+   * \brief Checks that point can move without degenerate dependent objects.
+   *
+   * \details Point can't be (0:0:0) and a line by two points can't go
+   * through coincident points, otherwise its recalculation would assert.
+   *
+   * \param equation New equation of point.
+   *
+   * \return True if the point can move.
+   */
+  [[nodiscard]] bool CanMove(const PointEquation& equation) const;
+
  private:
   PointEquation equation_;  //!< Equation of point.
 };
@@ -246,10 +267,50 @@ class ByTwoPoints final : public ConstructionLine, public StrongConstruction
    */
   ByTwoPoints(Point* first_point, Point* second_point);
 
+  /**
+   * \brief Constructs line by two points with already known equation.
+   *
+   * \details Equation isn't recalculated until points move.
+   *
+   * \param first_point First point.
+   * \param second_point Second point.
+   * \param equation Equation of the line through the points.
+   */
+  ByTwoPoints(Point* first_point, Point* second_point,
+              const LineEquation& equation);
+
   ~ByTwoPoints() override;
 
+  /**
+   * \brief Finds the line through two points.
+   *
+   * \details Unlike the constructor, doesn't assert if points coincide, so
+   * points may come from the user.
+   *
+   * \param first First point.
+   * \param second Second point.
+   *
+   * \return Equation of the line or std::nullopt if points coincide.
+   */
+  [[nodiscard]] static std::optional<LineEquation> Fit(
+      const PointEquation& first, const PointEquation& second);
+
   void RecalculateEquation() override;
 
+  /**
+   * \brief Gets first point.
+   *
+   * \return First point.
+   */
+  [[nodiscard]] Point* GetFirstPoint() const;
+
+  /**
+   * \brief Gets second point.
+   *
+   * \return Second point.
+   */
+  [[nodiscard]] Point* GetSecondPoint() const;
+
  private:
   Point* first_point_;   //!< First point.
   Point* second_point_;  //!< Second point.
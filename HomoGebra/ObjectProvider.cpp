@@ -1,47 +1,57 @@
 #include "ObjectProvider.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "GeometricObject.h"
 
 namespace HomoGebra
 {
 ObjectProvider::ObjectProvider(Plane* plane) : plane_(plane) {}
 
+namespace
+{
+/**
+ * \brief Makes filter of the spatial index by type of objects.
+ *
+ * \tparam GeometricObjectType Type of objects to accept.
+ *
+ * \return Filter that accepts only GeometricObjectType.
+ */
+template <class GeometricObjectType>
+SpatialIndex::Filter MakeTypeFilter()
+{
+  return [](const GeometricObject* object)
+  { return dynamic_cast<const GeometricObjectType*>(object) != nullptr; };
+}
+}  // namespace
+
 template <class GeometricObjectType>
 GeometricObjectType* ObjectProvider::GetNearestObject(
     const sf::Vector2f& position, const Distance max_distance)
 {
-  // Get all GeometricObjectType objects
-  auto objects = plane_->GetObjects<GeometricObjectType>();
-
-  GeometricObjectType* nearest_object{nullptr};
-  float current_distance = std::numeric_limits<float>::max();
-
-  // Find nearest
-  for (auto& object : objects)
-  {
-    // Get distance to object
-    const auto distance = object->GetDistance(position);
-
-    // Check if distance is less than current distance
-    if (distance < current_distance)
-    {
-      // Update current distance
-      current_distance = distance;
-
-      // Update nearest object
-      nearest_object = dynamic_cast<GeometricObjectType*>(object);
-    }
-  }
-
-  // Check if distance is less than max distance
-  if (current_distance < max_distance)
-  {
-    // Return nearest object
-    return nearest_object;
-  }
-
-  // Else return nullptr
-  return nullptr;
+  // Look only at objects near position
+  const auto nearest_object = plane_->GetSpatialIndex().FindNearest(
+      position, max_distance, MakeTypeFilter<GeometricObjectType>());
+
+  return dynamic_cast<GeometricObjectType*>(nearest_object);
+}
+
+template <class GeometricObjectType>
+std::vector<GeometricObjectType*> ObjectProvider::GetObjectsInRadius(
+    const sf::Vector2f& position, const Distance radius)
+{
+  const auto objects = plane_->GetSpatialIndex().FindInRadius(
+      position, radius, MakeTypeFilter<GeometricObjectType>());
+
+  // Cast objects to the type
+  std::vector<GeometricObjectType*> result;
+  result.reserve(objects.size());
+  std::ranges::transform(
+      objects, std::back_inserter(result), [](const auto object)
+      { return dynamic_cast<GeometricObjectType*>(object); });
+
+  return result;
 }
 
 template GeometricObject* ObjectProvider::GetNearestObject(
@@ -52,4 +62,13 @@ template Line* ObjectProvider::GetNearestObject(const sf::Vector2f& position,
                                                 Distance max_distance);
 template Conic* ObjectProvider::GetNearestObject(const sf::Vector2f& position,
                                                  Distance max_distance);
+
+template std::vector<GeometricObject*> ObjectProvider::GetObjectsInRadius(
+    const sf::Vector2f& position, Distance radius);
+template std::vector<Point*> ObjectProvider::GetObjectsInRadius(
+    const sf::Vector2f& position, Distance radius);
+template std::vector<Line*> ObjectProvider::GetObjectsInRadius(
+    const sf::Vector2f& position, Distance radius);
+template std::vector<Conic*> ObjectProvider::GetObjectsInRadius(
+    const sf::Vector2f& position, Distance radius);
 }  // namespace HomoGebra
\ No newline at end of file
@@ -38,6 +38,20 @@ class ObjectProvider
       const sf::Vector2f& position,
       Distance max_distance = std::numeric_limits<Distance>::max());
 
+  /**
+   * \brief Gets all objects near position.
+   *
+   * \tparam GeometricObjectType Type of objects to get.
+   *
+   * \param position Position to find objects.
+   * \param radius Maximum distance to objects.
+   *
+   * \return Objects, which are closer than radius.
+   */
+  template <class GeometricObjectType>
+  std::vector<GeometricObjectType*> GetObjectsInRadius(
+      const sf::Vector2f& position, Distance radius);
+
  private:
   /**
    * Member data.
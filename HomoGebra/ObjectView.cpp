@@ -0,0 +1,143 @@
+#include "ObjectView.h"
+
+#include <vector>
+
+#include "Assert.h"
+#include "GeometricObject.h"
+
+namespace HomoGebra
+{
+std::unique_ptr<ObjectView> ObjectView::Create(GeometricObject* object)
+{
+  if (auto* const point = dynamic_cast<Point*>(object))
+  {
+    return std::make_unique<PointView>(point);
+  }
+  if (auto* const line = dynamic_cast<Line*>(object))
+  {
+    return std::make_unique<LineView>(line);
+  }
+  if (auto* const conic = dynamic_cast<Conic*>(object))
+  {
+    return std::make_unique<ConicView>(conic);
+  }
+
+  Assert(false, "Object can't be drawn!");
+  return nullptr;
+}
+
+ObjectView::ObjectView(GeometricObject* object) : object_(object)
+{
+  object_->Attach(this);
+}
+
+ObjectView::~ObjectView() { object_->Detach(this); }
+
+GeometricObject* ObjectView::GetObject() const { return object_; }
+
+void ObjectView::Update(const ObjectEvent::Moved& moved_event)
+{
+  // Body has to read the new equation
+  is_body_outdated_ = true;
+}
+
+void ObjectView::Update(const ObjectEvent::GoingToBeDestroyed& destroyed_event)
+{
+  /*
+   * Plane removes the view, when it removes the object.
+   */
+}
+
+void ObjectView::Update(const ObjectEvent::Renamed& renamed_event)
+{
+  // Plane may adjust the name while the event is delivered, so the name is
+  // read from the object
+  GetBody().SetName(object_->GetName());
+}
+
+bool ObjectView::IsBodyOutdated() const { return is_body_outdated_; }
+
+void ObjectView::SetBodyUpdated() { is_body_outdated_ = false; }
+
+PointView::PointView(Point* point) : ObjectView(point), point_(point)
+{
+  body_.SetName(point->GetName());
+}
+
+void PointView::UpdateBody(const sf::RenderTarget& target)
+{
+  // Equation is read again only after the object has moved
+  if (IsBodyOutdated())
+  {
+    body_.Update(target, point_->GetEquation());
+    SetBodyUpdated();
+  }
+  else
+  {
+    body_.UpdateView(target);
+  }
+}
+
+PointBody& PointView::GetBody() { return body_; }
+
+const PointBody& PointView::GetBody() const { return body_; }
+
+LineView::LineView(Line* line) : ObjectView(line), line_(line)
+{
+  body_.SetName(line->GetName());
+}
+
+void LineView::UpdateBody(const sf::RenderTarget& target)
+{
+  LineView* view = this;
+  UpdateBodies({&view, 1}, target);
+}
+
+void LineView::UpdateBodies(const std::span<LineView* const> views,
+                            const sf::RenderTarget& target)
+{
+  std::vector<LineBody*> bodies;
+  bodies.reserve(views.size());
+
+  for (auto* const view : views)
+  {
+    // Equation is read again only after the object has moved
+    if (view->IsBodyOutdated())
+    {
+      view->body_.UpdateEquation(view->line_->GetEquation());
+      view->SetBodyUpdated();
+    }
+
+    bodies.push_back(&view->body_);
+  }
+
+  LineBody::UpdateViews(bodies, target);
+}
+
+LineBody& LineView::GetBody() { return body_; }
+
+const LineBody& LineView::GetBody() const { return body_; }
+
+ConicView::ConicView(Conic* conic) : ObjectView(conic), conic_(conic)
+{
+  body_.SetName(conic->GetName());
+}
+
+void ConicView::UpdateBody(const sf::RenderTarget& target)
+{
+  // Equation is read again only after the object has moved
+  if (IsBodyOutdated())
+  {
+    body_.Update(target, conic_->GetEquation());
+    SetBodyUpdated();
+  }
+  else
+  {
+    body_.UpdateView(target);
+  }
+}
+
+ConicBody& ConicView::GetBody() { return body_; }
+
+const ConicBody& ConicView::GetBody() const { return body_; }
+}  // namespace HomoGebra
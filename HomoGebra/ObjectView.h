@@ -0,0 +1,236 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <span>
+
+#include "GeometricObjectBody.h"
+#include "Observer.h"
+
+namespace HomoGebra
+{
+class GeometricObject;
+class Point;
+class Line;
+class Conic;
+
+/**
+ * \brief Drawable part of a geometric object.
+ *
+ * \details View observes its object: equation is read again only after the
+ * object has moved and name of the body follows name of the object. Object
+ * must outlive its view.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see PointView
+ * \see LineView
+ * \see ConicView
+ */
+class ObjectView : public GeometricObjectObserver
+{
+ public:
+  /**
+   * \brief Creates view of an object.
+   *
+   * \param object Object to view.
+   *
+   * \return View of the object.
+   */
+  [[nodiscard]] static std::unique_ptr<ObjectView> Create(
+      GeometricObject* object);
+
+  /**
+   * \brief Stops observing the object.
+   */
+  ~ObjectView() override;
+
+  ObjectView(const ObjectView&) = delete;
+  ObjectView& operator=(const ObjectView&) = delete;
+
+  /**
+   * \brief Gets viewed object.
+   *
+   * \return Object.
+   */
+  [[nodiscard]] GeometricObject* GetObject() const;
+
+  /**
+   * \brief Update the body of the object.
+   *
+   * \param target Render target to draw to.
+   */
+  virtual void UpdateBody(const sf::RenderTarget& target) = 0;
+
+  /**
+   * \brief Gets body of the object.
+   *
+   * \return Body of the object.
+   */
+  [[nodiscard]] virtual ObjectBody& GetBody() = 0;
+
+  /**
+   * \brief Gets body of the object.
+   *
+   * \return Body of the object.
+   */
+  [[nodiscard]] virtual const ObjectBody& GetBody() const = 0;
+
+  /**
+   * \brief Marks body outdated, because object has moved.
+   *
+   * \param moved_event Tag of the move.
+   */
+  void Update(const ObjectEvent::Moved& moved_event) override;
+
+  void Update(const ObjectEvent::GoingToBeDestroyed& destroyed_event) override;
+
+  /**
+   * \brief Copies new name of the object to the body.
+   *
+   * \param renamed_event Tag with the new name.
+   */
+  void Update(const ObjectEvent::Renamed& renamed_event) override;
+
+ protected:
+  /**
+   * \brief Starts observing an object.
+   *
+   * \param object Object to view.
+   */
+  explicit ObjectView(GeometricObject* object);
+
+  /**
+   * \brief Checks if object has moved since the body was updated.
+   *
+   * \return True if equation has to be read again.
+   */
+  [[nodiscard]] bool IsBodyOutdated() const;
+
+  /**
+   * \brief Remembers that body has read the equation.
+   */
+  void SetBodyUpdated();
+
+ private:
+  /**
+   * Member data.
+   */
+  GeometricObject* object_;       //!< Viewed object.
+  bool is_body_outdated_ = true;  //!< Has equation changed since update?
+};
+
+/**
+ * \brief View of a point.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+class PointView final : public ObjectView
+{
+ public:
+  /**
+   * \brief Starts observing a point.
+   *
+   * \param point Point to view.
+   */
+  explicit PointView(Point* point);
+
+  void UpdateBody(const sf::RenderTarget& target) override;
+
+  [[nodiscard]] PointBody& GetBody() override;
+
+  [[nodiscard]] const PointBody& GetBody() const override;
+
+ private:
+  /**
+   * Member data.
+   */
+  Point* point_;    //!< Viewed point.
+  PointBody body_;  //!< Body, which you can draw.
+};
+
+/**
+ * \brief View of a line.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+class LineView final : public ObjectView
+{
+ public:
+  /**
+   * \brief Starts observing a line.
+   *
+   * \param line Line to view.
+   */
+  explicit LineView(Line* line);
+
+  void UpdateBody(const sf::RenderTarget& target) override;
+
+  /**
+   * \brief Updates bodies of many lines at once.
+   *
+   * \details Lines are clipped with the view in one pass, it is faster than
+   * updating them one by one.
+   *
+   * \param views Views of lines to update.
+   * \param target Render target to draw to.
+   */
+  static void UpdateBodies(std::span<LineView* const> views,
+                           const sf::RenderTarget& target);
+
+  [[nodiscard]] LineBody& GetBody() override;
+
+  [[nodiscard]] const LineBody& GetBody() const override;
+
+ private:
+  /**
+   * Member data.
+   */
+  Line* line_;     //!< Viewed line.
+  LineBody body_;  //!< Body, which you can draw.
+};
+
+/**
+ * \brief View of a conic.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+class ConicView final : public ObjectView
+{
+ public:
+  /**
+   * \brief Starts observing a conic.
+   *
+   * \param conic Conic to view.
+   */
+  explicit ConicView(Conic* conic);
+
+  void UpdateBody(const sf::RenderTarget& target) override;
+
+  [[nodiscard]] ConicBody& GetBody() override;
+
+  [[nodiscard]] const ConicBody& GetBody() const override;
+
+ private:
+  /**
+   * Member data.
+   */
+  Conic* conic_;    //!< Viewed conic.
+  ConicBody body_;  //!< Body, which you can draw.
+};
+}  // namespace HomoGebra
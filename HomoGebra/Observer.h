@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <list>
 #include <string>
 
@@ -68,6 +69,13 @@ class Observable : public ObservableInterface<Observer>
   template <class Event>
   void Notify(const Event& event) const;
 
+  /**
+   * \brief Gets subscribed observers.
+   *
+   * \return Observers in order of subscription.
+   */
+  [[nodiscard]] const std::list<Observer*>& GetObservers() const;
+
  private:
   /**
    * Member data.
@@ -75,6 +83,35 @@ class Observable : public ObservableInterface<Observer>
   std::list<Observer*> observers_;  //!< List of subscribed observers.
 };
 
+template <class Observer>
+void Observable<Observer>::Attach(Observer* observer)
+{
+  // Add observer to list
+  observers_.push_back(observer);
+}
+
+template <class Observer>
+void Observable<Observer>::Detach(const Observer* observer)
+{
+  // Remove observer from list
+  observers_.remove_if([observer](const Observer* obs)
+                       { return obs == observer; });
+}
+
+template <class Observer>
+const std::list<Observer*>& Observable<Observer>::GetObservers() const
+{
+  return observers_;
+}
+
+template <class Observer>
+template <class Event>
+void Observable<Observer>::Notify(const Event& event) const
+{
+  std::ranges::for_each(
+      observers_, [&event](const auto& observer) { observer->Update(event); });
+}
+
 /**
  * \brief Events which can happen with objects.
  */
@@ -204,6 +241,16 @@ class ObservableGeometricObject : public Observable<GeometricObjectObserver>
 
 namespace PlaneEvent
 {
+/**
+ * \brief Tag that shows that object was added.
+ *
+ * \author nook0110
+ */
+struct ObjectAdded
+{
+  GeometricObject* added_object{};
+};
+
 /**
  * \brief Tag that shows that object was removed.
  *
@@ -229,6 +276,13 @@ class PlaneObserver
    */
   virtual ~PlaneObserver() = default;
 
+  /**
+   * \brief Update, because object was added.
+   *
+   * \param object_added Tag with the added object.
+   */
+  virtual void Update(const PlaneEvent::ObjectAdded& object_added) = 0;
+
   /**
    * \brief Update, because sth was destroyed.
    *
@@ -256,4 +310,4 @@ class ObservablePlane : public Observable<PlaneObserver>
   template <class Event>
   void Notify(const Event& event) const;
 };
-}  // namespace HomoGebra
\ No newline at end of file
+}  // namespace HomoGebra
@@ -1,16 +1,28 @@
 #include "Plane.h"
 
 #include <algorithm>
+#include <ranges>
 
-#include "Construction.h"
 #include "GeometricObject.h"
+#include "Profiler.h"
+#include "SfmlCanvas.h"
 
 namespace HomoGebra
 {
-void Plane::AddConstruction(std::unique_ptr<Construction> construction)
+Plane::Plane()
 {
-  // Add object to plane
-  implementation_.AddConstruction(std::move(construction));
+  // Forget objects, when they are removed
+  implementation_.Attach(&spatial_index_);
+
+  // Draw objects, while they are on the plane
+  implementation_.Attach(this);
+}
+
+PlaneImplementation& Plane::GetImplementation() { return implementation_; }
+
+const PlaneImplementation& Plane::GetImplementation() const
+{
+  return implementation_;
 }
 
 void Plane::DeleteObject(const GeometricObject* object)
@@ -31,20 +43,83 @@ template std::vector<GeometricObject*> Plane::GetObjects<Point>() const;
 template std::vector<GeometricObject*> Plane::GetObjects<Line>() const;
 template std::vector<GeometricObject*> Plane::GetObjects<Conic>() const;
 
-void Plane::UpdateBodies(const sf::RenderTarget& target) const
+const std::vector<std::unique_ptr<ObjectView>>& Plane::GetViews() const
 {
-  // Update all objects
-  std::ranges::for_each(GetObjects<GeometricObject>(),
-                        [&target](const auto object)
-                        { object->UpdateBody(target); });
+  return views_;
 }
 
+void Plane::UpdateBodies(const sf::RenderTarget& target)
+{
+  // Cells are proportional to the view, so a body covers few of them
+  const auto& view_size = target.getView().getSize();
+  spatial_index_.SetCellSize(std::max(view_size.x, view_size.y) /
+                             kCellsPerView);
+
+  // Update all objects, invisible ones are updated only partially. Lines are
+  // clipped with the view together
+  std::vector<LineView*> lines;
+  {
+    HOMOGEBRA_PROFILE_SCOPE("Update bodies");
+    for (const auto& view : views_)
+    {
+      if (auto* const line = dynamic_cast<LineView*>(view.get()))
+      {
+        lines.push_back(line);
+      }
+      else
+      {
+        view->UpdateBody(target);
+      }
+    }
+  }
+
+  {
+    HOMOGEBRA_PROFILE_SCOPE("Update lines");
+    LineView::UpdateBodies(lines, target);
+  }
+
+  [[maybe_unused]] size_t culled = 0;
+  {
+    HOMOGEBRA_PROFILE_SCOPE("Spatial index");
+    std::ranges::for_each(views_,
+                          [this, &culled](const auto& view)
+                          {
+                            spatial_index_.Update(view->GetObject(),
+                                                  view->GetBody());
+
+                            if (!view->GetBody().IsVisible()) ++culled;
+                          });
+  }
+
+  HOMOGEBRA_PROFILE_COUNT("Culled bodies", static_cast<float>(culled));
+
+  // Choose what of visible bodies is drawn
+  HOMOGEBRA_PROFILE_SCOPE("Level of detail");
+  level_of_detail_.Update(target, views_);
+  HOMOGEBRA_PROFILE_COUNT(
+      "Clusters", static_cast<float>(level_of_detail_.GetClusters().size()));
+}
+
+const SpatialIndex& Plane::GetSpatialIndex() const { return spatial_index_; }
+
 void Plane::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
-  //  Draw all objects
-  std::ranges::for_each(GetObjects<GeometricObject>(),
-                        [&target, &states](const auto object)
-                        { target.draw(*object, states); });
+  SfmlCanvas canvas{target, states};
+  Draw(canvas);
+}
+
+void Plane::Draw(Canvas& canvas) const
+{
+  //  Draw all visible objects
+  std::ranges::for_each(views_,
+                        [&canvas](const auto& view)
+                        {
+                          const auto& body = view->GetBody();
+                          if (body.IsVisible()) body.Draw(canvas);
+                        });
+
+  // Draw clusters of points
+  level_of_detail_.Draw(canvas);
 }
 
 void Plane::Update(const UserEvent::Click& clicked_event)
@@ -52,9 +127,34 @@ void Plane::Update(const UserEvent::Click& clicked_event)
   EventNotifier::Notify(clicked_event);
 }
 
-const NameGenerator& Plane::GetNameGenerator() const
+void Plane::Update(const UserEvent::Drag& drag_event)
+{
+  EventNotifier::Notify(drag_event);
+}
+
+void Plane::Update(const UserEvent::Unclick& unclick_event)
 {
-  return implementation_.GetNameGenerator();
+  EventNotifier::Notify(unclick_event);
+}
+
+void Plane::Update(const PlaneEvent::ObjectAdded& object_added)
+{
+  views_.push_back(ObjectView::Create(object_added.added_object));
+}
+
+void Plane::Update(const PlaneEvent::ObjectRemoved& object_removed)
+{
+  // Objects are usually removed from the end, e.g. when plane is destroyed
+  const auto found =
+      std::ranges::find(views_ | std::views::reverse,
+                        object_removed.removed_object,
+                        [](const std::unique_ptr<ObjectView>& view)
+                        { return view->GetObject(); });
+
+  if (found != std::ranges::rend(views_))
+  {
+    views_.erase(std::prev(found.base()));
+  }
 }
 
 void Plane::Attach(PlaneObserver* observer)
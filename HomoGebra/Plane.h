@@ -2,16 +2,22 @@
 #include <SFML/Graphics.hpp>
 
 #include "EventNotifier.h"
+#include "LevelOfDetail.h"
+#include "ObjectView.h"
 #include "Observer.h"
 #include "PlaneImplementation.h"
+#include "SpatialIndex.h"
 
 namespace HomoGebra
 {
-class Construction;
+class Canvas;
 
 /**
  * \brief Container for all objects, which you can draw.
  *
+ * \details Objects live in the implementation, the plane observes it and
+ * keeps a view for every object.
+ *
  * \author nook0110
  *
  * \version 0.1
@@ -23,6 +29,7 @@ class Construction;
  */
 class Plane final : public sf::Drawable,
                     public ObservableInterface<PlaneObserver>,
+                    public PlaneObserver,
                     public EventListener,
                     public EventNotifier
 {
@@ -31,11 +38,24 @@ class Plane final : public sf::Drawable,
   using EventNotifier::Detach;
 
   /**
-   * \brief Adds object to plane.
+   * \brief Default constructor.
+   *
+   */
+  Plane();
+
+  /**
+   * \brief Gets objects and constructions of the plane.
    *
-   * \param construction Pointer to an object.
+   * \return Implementation of the plane.
    */
-  void AddConstruction(std::unique_ptr<Construction> construction);
+  [[nodiscard]] PlaneImplementation& GetImplementation();
+
+  /**
+   * \brief Gets objects and constructions of the plane.
+   *
+   * \return Implementation of the plane.
+   */
+  [[nodiscard]] const PlaneImplementation& GetImplementation() const;
 
   /**
    * \brief Deletes object from plane.
@@ -54,19 +74,36 @@ class Plane final : public sf::Drawable,
   template <class GeometricObjectType>
   [[nodiscard]] std::vector<GeometricObject*> GetObjects() const;
 
+  /**
+   * \brief Returns views of objects in order of their addition.
+   *
+   * \return Views.
+   */
+  [[nodiscard]] const std::vector<std::unique_ptr<ObjectView>>& GetViews()
+      const;
+
   /**
    * \brief Updates plane.
    *
+   * \details Also places updated bodies into the spatial index.
+   *
    * \param target Render target to draw to.
    */
-  void UpdateBodies(const sf::RenderTarget& target) const;
+  void UpdateBodies(const sf::RenderTarget& target);
 
   /**
-   * \brief Returns name generator.
+   * \brief Draws all objects to a canvas.
    *
-   * \return Name generator.
+   * \param canvas Canvas to draw to.
    */
-  [[nodiscard]] const NameGenerator& GetNameGenerator() const;
+  void Draw(Canvas& canvas) const;
+
+  /**
+   * \brief Returns index of bodies on the plane.
+   *
+   * \return Spatial index.
+   */
+  [[nodiscard]] const SpatialIndex& GetSpatialIndex() const;
 
   void Attach(PlaneObserver* observer) override;
 
@@ -83,6 +120,31 @@ class Plane final : public sf::Drawable,
 
   void Update(const UserEvent::Click& clicked_event) override;
 
+  void Update(const UserEvent::Drag& drag_event) override;
+
+  void Update(const UserEvent::Unclick& unclick_event) override;
+
+  /**
+   * \brief Creates view of the added object.
+   *
+   * \param object_added Tag with the object.
+   */
+  void Update(const PlaneEvent::ObjectAdded& object_added) override;
+
+  /**
+   * \brief Destroys view of the removed object.
+   *
+   * \param object_removed Tag with the object.
+   */
+  void Update(const PlaneEvent::ObjectRemoved& object_removed) override;
+
+  static constexpr float kCellsPerView =
+      32.f;  //!< Amount of index cells along the view.
+
+  SpatialIndex spatial_index_;  //!< Index of bodies. Must outlive objects.
+  LevelOfDetail level_of_detail_;  //!< Detail of bodies and clusters.
+  std::vector<std::unique_ptr<ObjectView>>
+      views_;  //!< Views in order of addition. Must outlive objects.
   PlaneImplementation implementation_;  //!< Implementation of plane
 };
 }  // namespace HomoGebra
\ No newline at end of file
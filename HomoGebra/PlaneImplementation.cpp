@@ -1,6 +1,7 @@
 ﻿#include "PlaneImplementation.h"
 
 #include <functional>
+#include <ranges>
 
 #include "Assert.h"
 #include "Construction.h"
@@ -19,11 +20,15 @@ PlaneImplementation::~PlaneImplementation()
 void PlaneImplementation::AddConstruction(
     std::unique_ptr<Construction> construction)
 {
+  auto* const object = construction->GetObject();
+
   // Attach plane as an observer to object
-  construction->GetObject()->Attach(this);
+  object->Attach(this);
 
   // Add object to vector of all objects
   construction_.push_back(std::move(construction));
+
+  Notify(PlaneEvent::ObjectAdded{object});
 }
 
 void PlaneImplementation::DestroyObject(const GeometricObject* object)
@@ -43,11 +48,52 @@ bool PlaneImplementation::IsContained(const GeometricObject* object) const
              }) != construction_.end();
 }
 
+const std::vector<std::unique_ptr<Construction>>&
+PlaneImplementation::GetConstructions() const
+{
+  return construction_;
+}
+
 const NameGenerator& PlaneImplementation::GetNameGenerator() const
 {
   return name_generator_;
 }
 
+const NameIndex& PlaneImplementation::GetNameIndex() const
+{
+  return name_index_;
+}
+
+void PlaneImplementation::AssignNames(
+    const std::span<GeometricObject* const> objects,
+    const std::span<const std::string> names)
+{
+  Expect(objects.size() == names.size(), "Every object needs a name!");
+
+  // Current names of renamed objects are free for the batch
+  for (size_t index = 0; index < objects.size(); ++index)
+  {
+    if (names[index].empty()) continue;
+
+    const auto& name = objects[index]->GetName();
+    name_generator_.DeleteName(name);
+    name_index_.Remove(name, objects[index]);
+  }
+
+  const auto reserved = name_generator_.ReserveNames(names);
+
+  // Names are taken already, so events of renaming are skipped
+  is_assigning_names_ = true;
+  for (size_t index = 0; index < objects.size(); ++index)
+  {
+    if (reserved[index].empty()) continue;
+
+    name_index_.Add(reserved[index], objects[index]);
+    objects[index]->SetName(reserved[index]);
+  }
+  is_assigning_names_ = false;
+}
+
 void PlaneImplementation::Update(const ObjectEvent::Moved& moved_event)
 {
   /*
@@ -67,21 +113,28 @@ void PlaneImplementation::Update(const ObjectEvent::Renamed& renamed_event)
   Expect(renamed_event.object->GetName() == renamed_event.new_name,
          "Object name isn't correct!");
 
+  if (is_assigning_names_) return;
+
   name_generator_.DeleteName(renamed_event.old_name);
+  name_index_.Remove(renamed_event.old_name, renamed_event.object);
 
   auto adjust_name = [this, &renamed_event]
   {
     const auto new_name = name_generator_.GenerateName(renamed_event.new_name);
 
-    name_generator_.AddName(new_name);
-
+    // Renaming deletes the taken name, which still belongs to another object
     renamed_event.object->SetName(static_cast<std::string>(new_name));
+    name_generator_.AddName(renamed_event.new_name);
   };
 
   if (!name_generator_.AddName(renamed_event.new_name))
   {
+    // Adjusted name is indexed by the nested event of renaming
     adjust_name();
+    return;
   }
+
+  name_index_.Add(renamed_event.new_name, renamed_event.object);
 }
 
 void PlaneImplementation::RemoveObject(const GeometricObject* object)
@@ -89,10 +142,18 @@ void PlaneImplementation::RemoveObject(const GeometricObject* object)
   Notify(PlaneEvent::ObjectRemoved{object});
 
   name_generator_.DeleteName(object->GetName());
+  name_index_.Remove(object->GetName(), object);
 
-  std::erase_if(construction_,
-                [object](const std::unique_ptr<Construction>& construction)
-                { return construction->GetObject() == object; });
+  // Objects are usually removed from the end, e.g. when plane is destroyed
+  const auto found = std::ranges::find_if(
+      construction_ | std::views::reverse,
+      [object](const std::unique_ptr<Construction>& construction)
+      { return construction->GetObject() == object; });
+
+  if (found != std::ranges::rend(construction_))
+  {
+    construction_.erase(std::prev(found.base()));
+  }
 }
 
 void PlaneImplementation::ClearGarbage()
@@ -1,9 +1,12 @@
 #pragma once
 #include <algorithm>
 #include <memory>
+#include <span>
+#include <string>
 #include <vector>
 
 #include "NameGenerator.h"
+#include "NameIndex.h"
 #include "Observer.h"
 
 namespace HomoGebra
@@ -46,7 +49,8 @@ class GarbageObjectCollector
  *
  * \date February 2023
  *
- * \details Class that manages all objects.
+ * \details Class that manages all objects. It doesn't depend on graphics,
+ * so it is used without a window, Plane draws it by observing it.
  *
  * \see Plane
  */
@@ -62,6 +66,8 @@ class PlaneImplementation : public GeometricObjectObserver,
   /**
    * \brief Adds object
    *
+   * \details Observers are notified after the object is added.
+   *
    * \param construction Object to add
    */
   void AddConstruction(std::unique_ptr<Construction> construction);
@@ -92,6 +98,16 @@ class PlaneImplementation : public GeometricObjectObserver,
   template <class GeometricObjectType>
   [[nodiscard]] std::vector<GeometricObject*> GetObjects() const;
 
+  /**
+   * \brief Get all constructions in order of their addition.
+   *
+   * \details Construction is always added after objects it depends on.
+   *
+   * \return Constructions.
+   */
+  [[nodiscard]] const std::vector<std::unique_ptr<Construction>>&
+  GetConstructions() const;
+
   /**
    * \brief Get name generator.
    *
@@ -99,6 +115,27 @@ class PlaneImplementation : public GeometricObjectObserver,
    */
   [[nodiscard]] const NameGenerator& GetNameGenerator() const;
 
+  /**
+   * \brief Get index of objects by names.
+   *
+   * \return Name index.
+   */
+  [[nodiscard]] const NameIndex& GetNameIndex() const;
+
+  /**
+   * \brief Names objects of a batch at once, e.g. when they are imported.
+   *
+   * \details Names are reserved with NameGenerator::ReserveNames(), so
+   * collisions are resolved in one sweep. Every object is renamed once, as
+   * its name is already free.
+   *
+   * \param objects Objects of the plane to name.
+   * \param names Requested names by object, objects with empty ones keep
+   * their names.
+   */
+  void AssignNames(std::span<GeometricObject* const> objects,
+                   std::span<const std::string> names);
+
   void Update(const ObjectEvent::Moved& moved_event) override;
   void Update(const ObjectEvent::GoingToBeDestroyed& destroyed_event) override;
   void Update(const ObjectEvent::Renamed& renamed_event) override;
@@ -114,7 +151,9 @@ class PlaneImplementation : public GeometricObjectObserver,
   std::vector<std::unique_ptr<Construction>>
       construction_;  //!< All constructions on the plane.
 
-  NameGenerator name_generator_;  //!< Name generator.
+  NameGenerator name_generator_;     //!< Name generator.
+  NameIndex name_index_;             //!< Objects by names.
+  bool is_assigning_names_ = false;  //!< Is AssignNames() renaming?
 
   GarbageObjectCollector going_to_be_destroyed_;
 };
@@ -0,0 +1,239 @@
+#include "Polynomial.h"
+
+#include <algorithm>
+#include <numbers>
+
+namespace HomoGebra
+{
+Polynomial::Polynomial(Coefficients coefficients)
+    : coefficients_(std::move(coefficients))
+{}
+
+size_t Polynomial::GetDegree() const
+{
+  // Skip zero leading coefficients
+  for (size_t power = coefficients_.size(); power > 0; --power)
+  {
+    if (!coefficients_[power - 1].IsZero()) return power - 1;
+  }
+
+  return 0;
+}
+
+Complex Polynomial::operator[](const size_t power) const
+{
+  if (power >= coefficients_.size()) return Complex{};
+
+  return coefficients_[power];
+}
+
+Complex Polynomial::operator()(const Complex& x) const
+{
+  // Horner's method
+  Complex value{};
+  for (auto coefficient = coefficients_.rbegin();
+       coefficient != coefficients_.rend(); ++coefficient)
+  {
+    value = value * x + *coefficient;
+  }
+
+  return value;
+}
+
+Polynomial Polynomial::GetDerivative() const
+{
+  if (coefficients_.size() <= 1) return {};
+
+  Coefficients derivative(coefficients_.size() - 1);
+  for (size_t power = 1; power < coefficients_.size(); ++power)
+  {
+    derivative[power - 1] =
+        coefficients_[power] * Complex{static_cast<long double>(power)};
+  }
+
+  return Polynomial{std::move(derivative)};
+}
+
+std::vector<Complex> Polynomial::GetRoots() const
+{
+  // Find the largest coefficient to compare others with it
+  long double largest{};
+  std::ranges::for_each(
+      coefficients_, [&largest](const auto& coefficient)
+      { largest = std::max(largest, std::abs(coefficient)); });
+
+  // Drop negligible leading coefficients
+  auto degree = coefficients_.size();
+  while (degree > 0 &&
+         std::abs(coefficients_[degree - 1]) <= kRelativeEpsilon * largest)
+  {
+    --degree;
+  }
+
+  // Constant polynomial has no roots
+  if (degree <= 1) return {};
+  --degree;
+
+  const Polynomial trimmed{
+      Coefficients{coefficients_.begin(),
+                   coefficients_.begin() + static_cast<ptrdiff_t>(degree) + 1}};
+
+  // Make polynomial monic
+  auto monic = trimmed;
+  monic *= Complex{1} / trimmed[degree];
+
+  // All roots lie inside the circle of this radius (Cauchy bound)
+  long double radius{};
+  for (size_t power = 0; power < degree; ++power)
+  {
+    radius = std::max(radius, std::abs(monic[power]));
+  }
+  radius += 1;
+
+  // Start from points on the circle, which aren't symmetric to real axis
+  std::vector<Complex> roots(degree);
+  for (size_t root = 0; root < degree; ++root)
+  {
+    constexpr long double kShift = 0.4L;
+    const auto angle = 2 * std::numbers::pi_v<long double> *
+                           static_cast<long double>(root) /
+                           static_cast<long double>(degree) +
+                       kShift;
+    roots[root] = Complex{std::polar(radius, angle)};
+  }
+
+  // Durand-Kerner iteration
+  for (size_t iteration = 0; iteration < kMaxIterations; ++iteration)
+  {
+    long double largest_step{};
+
+    for (size_t root = 0; root < degree; ++root)
+    {
+      Complex denominator{1};
+      for (size_t other = 0; other < degree; ++other)
+      {
+        if (other == root) continue;
+        denominator *= roots[root] - roots[other];
+      }
+
+      // Two approximations coincide, so move one of them
+      if (denominator == Complex{})
+      {
+        roots[root] +=
+            Complex{radius * kRelativeEpsilon, radius * kRelativeEpsilon};
+        largest_step = radius;
+        continue;
+      }
+
+      const auto step = monic(roots[root]) / denominator;
+      roots[root] -= step;
+
+      largest_step = std::max(
+          largest_step,
+          std::abs(step) / std::max(1.L, std::abs(roots[root])));
+    }
+
+    constexpr long double kPrecision = 1e-15L;
+    if (largest_step < kPrecision) break;
+  }
+
+  // Polish roots with Newton's method
+  const auto derivative = trimmed.GetDerivative();
+  for (auto& root : roots)
+  {
+    constexpr size_t kPolishIterations = 2;
+    for (size_t iteration = 0; iteration < kPolishIterations; ++iteration)
+    {
+      const auto slope = derivative(root);
+      if (slope == Complex{}) break;
+
+      const auto polished = root - trimmed(root) / slope;
+
+      // Newton's method diverges near multiple roots
+      if (std::abs(trimmed(polished)) >= std::abs(trimmed(root))) break;
+
+      root = polished;
+    }
+  }
+
+  return roots;
+}
+
+Polynomial& Polynomial::operator+=(const Polynomial& other)
+{
+  if (coefficients_.size() < other.coefficients_.size())
+  {
+    coefficients_.resize(other.coefficients_.size());
+  }
+
+  for (size_t power = 0; power < other.coefficients_.size(); ++power)
+  {
+    coefficients_[power] += other.coefficients_[power];
+  }
+
+  return *this;
+}
+
+Polynomial Polynomial::operator+(const Polynomial& other) const
+{
+  auto copy = *this;
+
+  copy += other;
+
+  return copy;
+}
+
+Polynomial& Polynomial::operator-=(const Polynomial& other)
+{
+  return *this += other * Complex{-1};
+}
+
+Polynomial Polynomial::operator-(const Polynomial& other) const
+{
+  auto copy = *this;
+
+  copy -= other;
+
+  return copy;
+}
+
+Polynomial& Polynomial::operator*=(const Polynomial& other)
+{
+  return *this = *this * other;
+}
+
+Polynomial Polynomial::operator*(const Polynomial& other) const
+{
+  if (coefficients_.empty() || other.coefficients_.empty()) return {};
+
+  Coefficients product(coefficients_.size() + other.coefficients_.size() - 1);
+  for (size_t power = 0; power < coefficients_.size(); ++power)
+  {
+    for (size_t other_power = 0; other_power < other.coefficients_.size();
+         ++other_power)
+    {
+      product[power + other_power] +=
+          coefficients_[power] * other.coefficients_[other_power];
+    }
+  }
+
+  return Polynomial{std::move(product)};
+}
+
+Polynomial& Polynomial::operator*=(const Complex& factor)
+{
+  std::ranges::for_each(coefficients_, [&factor](auto& coefficient)
+                        { coefficient *= factor; });
+
+  return *this;
+}
+
+Polynomial Polynomial::operator*(const Complex& factor) const
+{
+  auto copy = *this;
+
+  copy *= factor;
+
+  return copy;
+}
+}  // namespace HomoGebra
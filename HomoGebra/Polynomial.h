@@ -0,0 +1,103 @@
+#pragma once
+#include <vector>
+
+#include "Complex.h"
+
+namespace HomoGebra
+{
+/**
+ * \brief Polynomial of one variable with complex coefficients.
+ *
+ * \details Coefficient with index i stands before x^i.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+class Polynomial
+{
+ public:
+  using Coefficients = std::vector<Complex>;  //!< Coefficients of polynomial.
+
+  /**
+   * \brief Constructs zero polynomial.
+   *
+   */
+  Polynomial() = default;
+
+  /**
+   * \brief Constructs polynomial from coefficients.
+   *
+   * \param coefficients Coefficients, starting from the constant one.
+   */
+  explicit Polynomial(Coefficients coefficients);
+
+  /**
+   * \brief Gets degree of polynomial.
+   *
+   * \details Zero leading coefficients are not counted. Degree of zero
+   * polynomial is zero.
+   *
+   * \return Degree of polynomial.
+   */
+  [[nodiscard]] size_t GetDegree() const;
+
+  /**
+   * \brief Gets coefficient before x^power.
+   *
+   * \param power Power of the variable.
+   *
+   * \return Coefficient, zero if power is greater than degree.
+   */
+  [[nodiscard]] Complex operator[](size_t power) const;
+
+  /**
+   * \brief Calculates value of polynomial.
+   *
+   * \param x Value of the variable.
+   *
+   * \return Value of polynomial.
+   */
+  [[nodiscard]] Complex operator()(const Complex& x) const;
+
+  /**
+   * \brief Calculates derivative of polynomial.
+   *
+   * \return Derivative.
+   */
+  [[nodiscard]] Polynomial GetDerivative() const;
+
+  /**
+   * \brief Finds all roots of polynomial.
+   *
+   * \details Uses Durand-Kerner iteration and polishes roots with Newton's
+   * method. Leading coefficients, which are negligible in comparison with
+   * the largest one, are dropped.
+   *
+   * \return Roots with multiplicity, empty for constant polynomial.
+   */
+  [[nodiscard]] std::vector<Complex> GetRoots() const;
+
+  Polynomial& operator+=(const Polynomial& other);
+  Polynomial operator+(const Polynomial& other) const;
+  Polynomial& operator-=(const Polynomial& other);
+  Polynomial operator-(const Polynomial& other) const;
+  Polynomial& operator*=(const Polynomial& other);
+  Polynomial operator*(const Polynomial& other) const;
+  Polynomial& operator*=(const Complex& factor);
+  Polynomial operator*(const Complex& factor) const;
+
+ private:
+  /**
+   * Member data.
+   */
+  static constexpr long double kRelativeEpsilon =
+      1e-12L;  //!< Relative size of negligible coefficients.
+  static constexpr size_t kMaxIterations =
+      500;  //!< Maximum amount of Durand-Kerner iterations.
+
+  Coefficients coefficients_;  //!< Coefficients of polynomial.
+};
+}  // namespace HomoGebra
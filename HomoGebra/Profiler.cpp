@@ -0,0 +1,236 @@
+#include "Profiler.h"
+
+#include <atomic>
+#include <fstream>
+
+#include "imgui.h"
+
+namespace HomoGebra::Profiling
+{
+namespace
+{
+/**
+ * \brief Converts duration to milliseconds.
+ *
+ * \param duration Duration to convert.
+ *
+ * \return Milliseconds.
+ */
+float ToMilliseconds(const Clock::duration duration)
+{
+  return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+/**
+ * \brief Writes string as JSON string literal.
+ *
+ * \param out Stream to write to.
+ * \param string String to write.
+ */
+void WriteJsonString(std::ostream& out, const std::string_view string)
+{
+  out << '"';
+  for (const auto character : string)
+  {
+    if (character == '"' || character == '\\') out << '\\';
+    out << character;
+  }
+  out << '"';
+}
+}  // namespace
+
+Profiler& Profiler::Get()
+{
+  static Profiler profiler;
+  return profiler;
+}
+
+Profiler::Profiler() : epoch_(Clock::now()), frame_start_(epoch_) {}
+
+void Profiler::Record(const std::string_view name,
+                      const Clock::time_point start,
+                      const Clock::time_point finish)
+{
+  // Threads are numbered in order of their first record
+  static std::atomic<size_t> thread_count;
+  thread_local const auto thread = thread_count++;
+
+  std::scoped_lock lock(mutex_);
+
+  // Find stage or add a new one
+  auto [iterator, inserted] = stage_indices_.try_emplace(name, stages_.size());
+  if (inserted)
+  {
+    stages_.push_back(Stage{name});
+  }
+
+  stages_[iterator->second].current += finish - start;
+
+  events_.Push(Event{name, start, finish - start, thread});
+}
+
+void Profiler::Count(const std::string_view name, const float value)
+{
+  std::scoped_lock lock(mutex_);
+
+  // Find counter or add a new one
+  auto [iterator, inserted] =
+      counter_indices_.try_emplace(name, counters_.size());
+  if (inserted)
+  {
+    counters_.push_back(Counter{name});
+  }
+
+  counters_[iterator->second].current += value;
+}
+
+void Profiler::EndFrame()
+{
+  const auto now = Clock::now();
+
+  std::scoped_lock lock(mutex_);
+
+  frame_times_.Push(ToMilliseconds(now - frame_start_));
+  frame_start_ = now;
+
+  // Move totals of the frame to statistics
+  for (auto& stage : stages_)
+  {
+    stage.milliseconds.Push(ToMilliseconds(stage.current));
+    stage.current = {};
+  }
+
+  for (auto& counter : counters_)
+  {
+    counter.values.Push(counter.current);
+    counter.current = {};
+  }
+}
+
+std::vector<StageStatistics> Profiler::GetStatistics() const
+{
+  std::scoped_lock lock(mutex_);
+
+  std::vector<StageStatistics> statistics;
+  statistics.reserve(stages_.size());
+
+  for (const auto& [name, current, milliseconds] : stages_)
+  {
+    statistics.push_back(
+        {name, milliseconds.GetLast(), milliseconds.GetPercentile(0.5),
+         milliseconds.GetPercentile(0.95), milliseconds.GetPercentile(1.),
+         milliseconds.GetMean()});
+  }
+
+  std::ranges::sort(statistics, std::ranges::greater{},
+                    &StageStatistics::mean);
+
+  return statistics;
+}
+
+std::vector<CounterStatistics> Profiler::GetCounters() const
+{
+  std::scoped_lock lock(mutex_);
+
+  std::vector<CounterStatistics> statistics;
+  statistics.reserve(counters_.size());
+
+  for (const auto& [name, current, values] : counters_)
+  {
+    statistics.push_back({name, values.GetLast(), values.GetMean()});
+  }
+
+  return statistics;
+}
+
+std::vector<float> Profiler::GetFrameTimes() const
+{
+  std::scoped_lock lock(mutex_);
+
+  return frame_times_.GetValues();
+}
+
+bool Profiler::ExportChromeTrace(const std::string& path) const
+{
+  std::ofstream out(path);
+  if (!out) return false;
+
+  std::scoped_lock lock(mutex_);
+
+  // Complete events ("ph": "X") with time in microseconds
+  out << "{\"traceEvents\":[";
+  for (size_t index = 0; index < events_.GetSize(); ++index)
+  {
+    const auto& [name, start, duration, thread] = events_[index];
+
+    if (index != 0) out << ',';
+    out << "\n{\"name\":";
+    WriteJsonString(out, name);
+    out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread << ",\"ts\":"
+        << std::chrono::duration<double, std::micro>(start - epoch_).count()
+        << ",\"dur\":"
+        << std::chrono::duration<double, std::micro>(duration).count() << '}';
+  }
+  out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  return static_cast<bool>(out);
+}
+
+void Profiler::ConstructOverlay()
+{
+  const auto frame_times = GetFrameTimes();
+  const auto statistics = GetStatistics();
+  const auto counters = GetCounters();
+
+  ImGui::Begin("Profiler");
+
+  // Frame-time graph
+  const auto last_frame = frame_times.empty() ? 0.f : frame_times.back();
+  const auto overlay = std::to_string(last_frame) + " ms";
+  ImGui::PlotLines("Frame", frame_times.data(),
+                   static_cast<int>(frame_times.size()), 0, overlay.c_str(),
+                   0.f, 3.4e38f, ImVec2(0, 80));
+
+  // Top costs
+  if (ImGui::BeginTable("Stages", 6,
+                        ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+  {
+    ImGui::TableSetupColumn("Stage");
+    ImGui::TableSetupColumn("Last");
+    ImGui::TableSetupColumn("Median");
+    ImGui::TableSetupColumn("P95");
+    ImGui::TableSetupColumn("Max");
+    ImGui::TableSetupColumn("Mean");
+    ImGui::TableHeadersRow();
+
+    for (const auto& [name, last, median, p95, max, mean] : statistics)
+    {
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::Text("%.*s", static_cast<int>(name.size()), name.data());
+
+      for (const auto value : {last, median, p95, max, mean})
+      {
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", value);
+      }
+    }
+
+    ImGui::EndTable();
+  }
+
+  // Counters
+  for (const auto& [name, last, mean] : counters)
+  {
+    ImGui::Text("%.*s: %.0f (mean %.1f)", static_cast<int>(name.size()),
+                name.data(), last, mean);
+  }
+
+  if (ImGui::Button("Export trace"))
+  {
+    [[maybe_unused]] const auto exported = ExportChromeTrace("trace.json");
+  }
+
+  ImGui::End();
+}
+}  // namespace HomoGebra::Profiling
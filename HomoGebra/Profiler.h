@@ -0,0 +1,388 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Profiling is compiled in only when HOMOGEBRA_PROFILING is non-zero.
+ * Otherwise all HOMOGEBRA_PROFILE_* macros expand to nothing.
+ */
+#ifndef HOMOGEBRA_PROFILING
+#define HOMOGEBRA_PROFILING 0
+#endif
+
+namespace HomoGebra::Profiling
+{
+using Clock = std::chrono::steady_clock;
+
+/**
+ * \brief Buffer, which keeps last values.
+ *
+ * \details When buffer is full, a new value replaces the oldest one.
+ *
+ * \tparam T Type of values.
+ * \tparam Capacity Maximum amount of values.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+template <class T, size_t Capacity>
+class RingBuffer
+{
+ public:
+  /**
+   * \brief Adds value, replacing the oldest one if buffer is full.
+   *
+   * \param value Value to add.
+   */
+  void Push(const T& value)
+  {
+    values_[next_] = value;
+    next_ = (next_ + 1) % Capacity;
+    size_ = std::min(size_ + 1, Capacity);
+  }
+
+  /**
+   * \brief Gets amount of values.
+   *
+   * \return Amount of values.
+   */
+  [[nodiscard]] size_t GetSize() const { return size_; }
+
+  /**
+   * \brief Gets value by age.
+   *
+   * \param index Index of value, 0 is the oldest one.
+   *
+   * \return Value.
+   */
+  [[nodiscard]] const T& operator[](const size_t index) const
+  {
+    return values_[(next_ + Capacity - size_ + index) % Capacity];
+  }
+
+  /**
+   * \brief Gets the newest value.
+   *
+   * \return The newest value or default value if buffer is empty.
+   */
+  [[nodiscard]] T GetLast() const
+  {
+    return size_ == 0 ? T{} : (*this)[size_ - 1];
+  }
+
+  /**
+   * \brief Copies values from the oldest to the newest.
+   *
+   * \return Values.
+   */
+  [[nodiscard]] std::vector<T> GetValues() const
+  {
+    std::vector<T> values;
+    values.reserve(size_);
+    for (size_t index = 0; index < size_; ++index)
+    {
+      values.push_back((*this)[index]);
+    }
+    return values;
+  }
+
+  /**
+   * \brief Calculates percentile of values.
+   *
+   * \details Uses nearest rank.
+   *
+   * \param part Part of values, which are not greater than the result
+   * (from 0 to 1).
+   *
+   * \return Percentile or default value if buffer is empty.
+   */
+  [[nodiscard]] T GetPercentile(const double part) const
+  {
+    if (size_ == 0) return T{};
+
+    auto values = GetValues();
+    const auto rank = static_cast<size_t>(
+        std::clamp(part, 0., 1.) * static_cast<double>(size_ - 1));
+    std::ranges::nth_element(values, values.begin() + rank);
+    return values[rank];
+  }
+
+  /**
+   * \brief Calculates mean of values.
+   *
+   * \return Mean or default value if buffer is empty.
+   */
+  [[nodiscard]] T GetMean() const
+  {
+    if (size_ == 0) return T{};
+
+    T sum{};
+    for (size_t index = 0; index < size_; ++index)
+    {
+      sum += (*this)[index];
+    }
+    return sum / static_cast<T>(size_);
+  }
+
+ private:
+  /**
+   * Member data.
+   */
+  std::array<T, Capacity> values_{};  //!< Values.
+  size_t next_ = 0;                   //!< Index to write next value to.
+  size_t size_ = 0;                   //!< Amount of values.
+};
+
+/**
+ * \brief Statistics of a stage over the last frames.
+ */
+struct StageStatistics
+{
+  std::string_view name;  //!< Name of the stage.
+  float last;             //!< Time in the last frame (ms).
+  float median;           //!< Median time (ms).
+  float p95;              //!< 95th percentile of time (ms).
+  float max;              //!< Maximum time (ms).
+  float mean;             //!< Mean time (ms).
+};
+
+/**
+ * \brief Statistics of a counter over the last frames.
+ */
+struct CounterStatistics
+{
+  std::string_view name;  //!< Name of the counter.
+  float last;             //!< Value in the last frame.
+  float mean;             //!< Mean value.
+};
+
+/**
+ * \brief Collects time of named stages frame by frame.
+ *
+ * \details Time of a stage is summed over a frame, so a stage may be entered
+ * many times (for example, once per object). Besides per-frame totals, the
+ * last scopes are kept as events to export them in Chrome trace format
+ * (chrome://tracing, Perfetto).
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see ScopedTimer
+ */
+class Profiler
+{
+ public:
+  static constexpr size_t kFrameCapacity = 240;      //!< Frames in statistics.
+  static constexpr size_t kEventCapacity = 1 << 16;  //!< Events in trace.
+
+  /**
+   * \brief Gets profiler of the application.
+   *
+   * \return Profiler.
+   */
+  static Profiler& Get();
+
+  /**
+   * \brief Records time of a scope.
+   *
+   * \param name Name of the stage. Must outlive the profiler.
+   * \param start Time when the scope was entered.
+   * \param finish Time when the scope was left.
+   */
+  void Record(std::string_view name, Clock::time_point start,
+              Clock::time_point finish);
+
+  /**
+   * \brief Adds value to a counter of the current frame.
+   *
+   * \param name Name of the counter. Must outlive the profiler.
+   * \param value Value to add.
+   */
+  void Count(std::string_view name, float value);
+
+  /**
+   * \brief Finishes current frame and moves its totals to statistics.
+   */
+  void EndFrame();
+
+  /**
+   * \brief Gets statistics of all stages.
+   *
+   * \return Statistics sorted by mean time in descending order.
+   */
+  [[nodiscard]] std::vector<StageStatistics> GetStatistics() const;
+
+  /**
+   * \brief Gets statistics of all counters.
+   *
+   * \return Statistics in order of appearance.
+   */
+  [[nodiscard]] std::vector<CounterStatistics> GetCounters() const;
+
+  /**
+   * \brief Gets duration of the last frames.
+   *
+   * \return Durations (ms) from the oldest to the newest.
+   */
+  [[nodiscard]] std::vector<float> GetFrameTimes() const;
+
+  /**
+   * \brief Writes recorded events in Chrome trace format.
+   *
+   * \param path Path to the file.
+   *
+   * \return True if file was written.
+   */
+  [[nodiscard]] bool ExportChromeTrace(const std::string& path) const;
+
+  /**
+   * \brief Constructs ImGui window with frame-time graph and top stages.
+   */
+  void ConstructOverlay();
+
+ private:
+  /**
+   * \brief Constructs profiler, which starts the first frame.
+   */
+  Profiler();
+
+  /**
+   * \brief Time of a stage.
+   */
+  struct Stage
+  {
+    std::string_view name;                           //!< Name of the stage.
+    Clock::duration current{};                       //!< Total in the frame.
+    RingBuffer<float, kFrameCapacity> milliseconds;  //!< Totals of frames.
+  };
+
+  /**
+   * \brief Value, which is counted in every frame.
+   */
+  struct Counter
+  {
+    std::string_view name;                     //!< Name of the counter.
+    float current{};                           //!< Total in the frame.
+    RingBuffer<float, kFrameCapacity> values;  //!< Totals of frames.
+  };
+
+  /**
+   * \brief Recorded scope.
+   */
+  struct Event
+  {
+    std::string_view name;     //!< Name of the stage.
+    Clock::time_point start;   //!< Time when scope was entered.
+    Clock::duration duration;  //!< Duration of the scope.
+    size_t thread;             //!< Number of the thread.
+  };
+
+  /**
+   * Member data.
+   */
+  mutable std::mutex mutex_;  //!< Guards everything below.
+
+  std::vector<Stage> stages_;  //!< Stages in order of appearance.
+  std::unordered_map<std::string_view, size_t>
+      stage_indices_;  //!< Index of a stage by name.
+
+  std::vector<Counter> counters_;  //!< Counters in order of appearance.
+  std::unordered_map<std::string_view, size_t>
+      counter_indices_;  //!< Index of a counter by name.
+
+  Clock::time_point epoch_;        //!< Time when profiler was constructed.
+  Clock::time_point frame_start_;  //!< Time when current frame started.
+
+  RingBuffer<float, kFrameCapacity> frame_times_;  //!< Frame durations (ms).
+
+  RingBuffer<Event, kEventCapacity> events_;  //!< Last events.
+};
+
+/**
+ * \brief Records time between construction and destruction.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see Profiler
+ */
+class ScopedTimer
+{
+ public:
+  /**
+   * \brief Starts timer.
+   *
+   * \param name Name of the stage. Must outlive the profiler.
+   */
+  explicit ScopedTimer(const std::string_view name)
+      : profiler_(Profiler::Get()), name_(name), start_(Clock::now())
+  {}
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+  /**
+   * \brief Records time to the profiler.
+   */
+  ~ScopedTimer() { profiler_.Record(name_, start_, Clock::now()); }
+
+ private:
+  /**
+   * Member data.
+   */
+  Profiler& profiler_;       //!< Profiler to record to.
+  std::string_view name_;    //!< Name of the stage.
+  Clock::time_point start_;  //!< Time when timer was started.
+};
+}  // namespace HomoGebra::Profiling
+
+#if HOMOGEBRA_PROFILING
+#define HOMOGEBRA_PROFILE_CONCATENATE_IMPL(first, second) first##second
+#define HOMOGEBRA_PROFILE_CONCATENATE(first, second) \
+  HOMOGEBRA_PROFILE_CONCATENATE_IMPL(first, second)
+
+/**
+ * \brief Times the rest of the enclosing scope as stage `name`.
+ */
+#define HOMOGEBRA_PROFILE_SCOPE(name)      \
+  const ::HomoGebra::Profiling::ScopedTimer \
+  HOMOGEBRA_PROFILE_CONCATENATE(profile_scope_, __LINE__)(name)
+
+/**
+ * \brief Adds `value` to counter `name` of the current frame.
+ */
+#define HOMOGEBRA_PROFILE_COUNT(name, value) \
+  ::HomoGebra::Profiling::Profiler::Get().Count(name, value)
+
+/**
+ * \brief Finishes a frame of the profiler.
+ */
+#define HOMOGEBRA_PROFILE_END_FRAME() \
+  ::HomoGebra::Profiling::Profiler::Get().EndFrame()
+
+/**
+ * \brief Constructs ImGui overlay of the profiler.
+ */
+#define HOMOGEBRA_PROFILE_OVERLAY() \
+  ::HomoGebra::Profiling::Profiler::Get().ConstructOverlay()
+#else
+#define HOMOGEBRA_PROFILE_SCOPE(name)
+#define HOMOGEBRA_PROFILE_COUNT(name, value)
+#define HOMOGEBRA_PROFILE_END_FRAME()
+#define HOMOGEBRA_PROFILE_OVERLAY()
+#endif
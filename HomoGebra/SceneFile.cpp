@@ -0,0 +1,618 @@
+#include "SceneFile.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Assert.h"
+#include "GeometricObject.h"
+#include "MappedFile.h"
+#include "ObjectConstruction.h"
+#include "PlaneImplementation.h"
+
+namespace HomoGebra::SceneFile
+{
+namespace
+{
+static_assert(std::endian::native == std::endian::little,
+              "Sections are used in place, so the format is little-endian");
+
+constexpr std::array kMagic = {'H', 'G', 'S', 'C', 'E', 'N', 'E', '\0'};
+constexpr std::uint32_t kNoParent = ~std::uint32_t{0};
+
+/**
+ * \brief Type of a construction in the file.
+ */
+enum class ConstructionType : std::uint32_t
+{
+  kPointOnPlane,
+  kLineOnPlane,
+  kLineByTwoPoints,
+  kConicOnPlane,
+  kCount
+};
+
+/**
+ * \brief Beginning of the file.
+ */
+struct Header
+{
+  std::array<char, 8> magic;    //!< Always kMagic.
+  std::uint32_t version;        //!< Version of the format.
+  std::uint32_t reserved;       //!< Zero.
+  std::uint64_t constructions;  //!< Amount of constructions.
+  std::uint64_t parameters;     //!< Amount of parameters.
+  std::uint64_t name_bytes;     //!< Size of all names.
+  std::uint64_t equations;      //!< Amount of numbers in cached equations.
+  std::uint64_t cache_key;      //!< Key of constructions and parameters.
+};
+
+/**
+ * \brief Construction in the table.
+ */
+struct ConstructionRecord
+{
+  ConstructionType type;                 //!< Type of construction.
+  std::array<std::uint32_t, 2> parents;  //!< Ids of parents or kNoParent.
+  std::uint32_t first_parameter;         //!< Index of the first parameter.
+};
+
+/**
+ * \brief Complex number in the file.
+ */
+struct PackedComplex
+{
+  double real;       //!< Real part.
+  double imaginary;  //!< Imaginary part.
+};
+
+static_assert(sizeof(Header) == 56);
+static_assert(sizeof(ConstructionRecord) == 16);
+static_assert(sizeof(PackedComplex) == 16);
+
+/**
+ * \brief Offsets of sections in the file.
+ */
+struct Layout
+{
+  /**
+   * \brief Calculates offsets by sizes of sections.
+   *
+   * \param header Header of the file.
+   */
+  explicit Layout(const Header& header)
+      : constructions(sizeof(Header)),
+        parameters(constructions +
+                   header.constructions * sizeof(ConstructionRecord)),
+        name_offsets(parameters + header.parameters * sizeof(PackedComplex)),
+        names(name_offsets +
+              (header.constructions + 1) * sizeof(std::uint64_t)),
+        equations(names + Align(header.name_bytes)),
+        size(equations + header.equations * sizeof(PackedComplex))
+  {}
+
+  /**
+   * \brief Aligns size of a section.
+   *
+   * \param size Size of the section.
+   *
+   * \return Size with padding.
+   */
+  static constexpr size_t Align(const size_t size)
+  {
+    return (size + kAlignment - 1) / kAlignment * kAlignment;
+  }
+
+  static constexpr size_t kAlignment = 8;  //!< Alignment of sections.
+
+  size_t constructions;  //!< Offset of the construction table.
+  size_t parameters;     //!< Offset of the parameters.
+  size_t name_offsets;   //!< Offset of the offsets of names.
+  size_t names;          //!< Offset of characters of names.
+  size_t equations;      //!< Offset of the cached equations.
+  size_t size;           //!< Size of the file.
+};
+
+/**
+ * \brief Gets amount of parameters of a construction.
+ *
+ * \param type Type of construction.
+ *
+ * \return Amount of complex numbers.
+ */
+constexpr size_t CountParameters(const ConstructionType type)
+{
+  switch (type)
+  {
+    case ConstructionType::kPointOnPlane:
+    case ConstructionType::kLineOnPlane:
+      return 3;
+    case ConstructionType::kConicOnPlane:
+      return 6;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * \brief Gets amount of numbers in the cached equation of a construction.
+ *
+ * \param type Type of construction.
+ *
+ * \return Amount of complex numbers.
+ */
+constexpr size_t CountEquations(const ConstructionType type)
+{
+  return type == ConstructionType::kLineByTwoPoints ? 3 : 0;
+}
+
+/**
+ * \brief Calculates key of the cached equations.
+ *
+ * \details FNV-1a over 64-bit words, all sections have size divisible by 8.
+ *
+ * \param constructions Construction table.
+ * \param parameters Parameters.
+ *
+ * \return Key.
+ */
+std::uint64_t CalculateCacheKey(
+    const std::span<const ConstructionRecord> constructions,
+    const std::span<const PackedComplex> parameters)
+{
+  constexpr std::uint64_t kOffsetBasis = 14695981039346656037ull;
+  constexpr std::uint64_t kPrime = 1099511628211ull;
+
+  auto key = kOffsetBasis;
+  auto hash = [&key](const std::span<const std::byte> bytes)
+  {
+    for (size_t offset = 0; offset < bytes.size(); offset += sizeof(key))
+    {
+      std::uint64_t word;
+      std::memcpy(&word, bytes.data() + offset, sizeof(word));
+      key = (key ^ word) * kPrime;
+    }
+  };
+
+  hash(std::as_bytes(constructions));
+  hash(std::as_bytes(parameters));
+
+  return key;
+}
+
+/**
+ * \brief Gets a section of a mapped file.
+ *
+ * \tparam Item Type of items in the section.
+ *
+ * \param bytes Bytes of the file.
+ * \param offset Offset of the section.
+ * \param count Amount of items.
+ *
+ * \return Items in place.
+ */
+template <class Item>
+std::span<const Item> GetSection(const std::span<const std::byte> bytes,
+                                 const size_t offset, const size_t count)
+{
+  static_assert(std::is_trivially_copyable_v<Item>);
+
+  return {reinterpret_cast<const Item*>(bytes.data() + offset), count};
+}
+
+/**
+ * \brief Appends a complex number to packed numbers.
+ *
+ * \param number Number to append.
+ * \param packed Packed numbers.
+ */
+void Pack(const Complex& number, std::vector<PackedComplex>& packed)
+{
+  packed.push_back({static_cast<double>(number.real()),
+                    static_cast<double>(number.imag())});
+}
+
+/**
+ * \brief Appends x, y and z of a coordinate to packed numbers.
+ *
+ * \param coordinate Coordinate to append.
+ * \param packed Packed numbers.
+ */
+void Pack(const HomogeneousCoordinate& coordinate,
+          std::vector<PackedComplex>& packed)
+{
+  for (const auto var : {Var::kX, Var::kY, Var::kZ})
+  {
+    Pack(coordinate[var], packed);
+  }
+}
+
+/**
+ * \brief Appends squares and then pair products of a conic.
+ *
+ * \param equation Equation to append.
+ * \param packed Packed numbers.
+ */
+void Pack(const ConicEquation& equation, std::vector<PackedComplex>& packed)
+{
+  for (const auto& coefficient : equation.squares) Pack(coefficient, packed);
+  for (const auto& coefficient : equation.pair_products)
+  {
+    Pack(coefficient, packed);
+  }
+}
+
+/**
+ * \brief Reads a packed complex number.
+ *
+ * \param number Packed number.
+ *
+ * \return Complex number.
+ */
+Complex Unpack(const PackedComplex& number)
+{
+  return Complex{static_cast<long double>(number.real),
+                 static_cast<long double>(number.imaginary)};
+}
+
+/**
+ * \brief Reads a coordinate from three packed numbers.
+ *
+ * \param numbers First of the packed numbers.
+ *
+ * \return Coordinate.
+ */
+HomogeneousCoordinate UnpackCoordinate(const PackedComplex* numbers)
+{
+  return {Unpack(numbers[0]), Unpack(numbers[1]), Unpack(numbers[2])};
+}
+
+/**
+ * \brief Checks that a packed number is finite.
+ *
+ * \param number Packed number.
+ *
+ * \return True if both parts are finite.
+ */
+bool IsFinite(const PackedComplex& number)
+{
+  return std::isfinite(number.real) && std::isfinite(number.imaginary);
+}
+
+/**
+ * \brief Checks that three packed numbers of a coordinate are all zero.
+ *
+ * \details Such coordinate is neither a point nor a line, it can't be
+ * normalized.
+ *
+ * \param numbers First of the packed numbers.
+ *
+ * \return True if all numbers are zero.
+ */
+bool IsZeroCoordinate(const PackedComplex* numbers)
+{
+  const auto coordinate = UnpackCoordinate(numbers);
+  return coordinate.x.IsZero() && coordinate.y.IsZero() &&
+         coordinate.z.IsZero();
+}
+
+/**
+ * \brief Reads a conic from six packed numbers.
+ *
+ * \param numbers First of the packed numbers.
+ *
+ * \return Equation of the conic.
+ */
+ConicEquation UnpackConic(const PackedComplex* numbers)
+{
+  ConicEquation equation;
+  for (size_t index = 0; index < equation.squares.size(); ++index)
+  {
+    equation.squares[index] = Unpack(numbers[index]);
+    equation.pair_products[index] =
+        Unpack(numbers[equation.squares.size() + index]);
+  }
+  return equation;
+}
+
+/**
+ * \brief Writes items to a file.
+ *
+ * \tparam Item Type of items.
+ *
+ * \param file File to write to.
+ * \param items Items to write.
+ */
+template <class Item>
+void Write(std::ofstream& file, const std::span<const Item> items)
+{
+  const auto bytes = std::as_bytes(items);
+  file.write(reinterpret_cast<const char*>(bytes.data()),
+             static_cast<std::streamsize>(bytes.size()));
+}
+}  // namespace
+
+bool Save(const PlaneImplementation& plane, const std::filesystem::path& path,
+          const bool cache_equations)
+{
+  const auto& all_constructions = plane.GetConstructions();
+
+  std::vector<ConstructionRecord> constructions;
+  std::vector<PackedComplex> parameters;
+  std::vector<PackedComplex> equations;
+  std::vector<std::uint64_t> name_offsets{0};
+  std::string names;
+  constructions.reserve(all_constructions.size());
+  name_offsets.reserve(all_constructions.size() + 1);
+
+  // Parents are written before children, so they already have ids
+  std::unordered_map<const GeometricObject*, std::uint32_t> ids;
+  ids.reserve(all_constructions.size());
+  auto get_id = [&ids](const GeometricObject* object)
+  {
+    const auto found = ids.find(object);
+    return found != ids.end() ? found->second : kNoParent;
+  };
+
+  for (const auto& construction : all_constructions)
+  {
+    ConstructionRecord record{ConstructionType::kCount,
+                              {kNoParent, kNoParent},
+                              static_cast<std::uint32_t>(parameters.size())};
+
+    if (const auto* point =
+            dynamic_cast<const PointOnPlane*>(construction.get()))
+    {
+      record.type = ConstructionType::kPointOnPlane;
+      Pack(point->GetPoint()->GetEquation().GetEquation(), parameters);
+    }
+    else if (const auto* line =
+                 dynamic_cast<const LineOnPlane*>(construction.get()))
+    {
+      record.type = ConstructionType::kLineOnPlane;
+      Pack(line->GetLine()->GetEquation().equation, parameters);
+    }
+    else if (const auto* by_two_points =
+                 dynamic_cast<const ByTwoPoints*>(construction.get()))
+    {
+      record.type = ConstructionType::kLineByTwoPoints;
+      record.parents = {get_id(by_two_points->GetFirstPoint()),
+                        get_id(by_two_points->GetSecondPoint())};
+      if (std::ranges::find(record.parents, kNoParent) !=
+          record.parents.end())
+      {
+        return false;
+      }
+
+      if (cache_equations)
+      {
+        Pack(by_two_points->GetLine()->GetEquation().equation, equations);
+      }
+    }
+    else if (const auto* conic =
+                 dynamic_cast<const ConicOnPlane*>(construction.get()))
+    {
+      record.type = ConstructionType::kConicOnPlane;
+      Pack(conic->GetConic()->GetEquation(), parameters);
+    }
+    else
+    {
+      // Construction isn't supported by the format
+      return false;
+    }
+
+    ids.emplace(construction->GetObject(),
+                static_cast<std::uint32_t>(constructions.size()));
+    constructions.push_back(record);
+
+    names += construction->GetObject()->GetName();
+    name_offsets.push_back(names.size());
+  }
+
+  // Ids and parameter indices have to fit in the records
+  if (constructions.size() >= kNoParent || parameters.size() >= kNoParent)
+  {
+    return false;
+  }
+
+  const Header header{kMagic,
+                      kVersion,
+                      0,
+                      constructions.size(),
+                      parameters.size(),
+                      names.size(),
+                      equations.size(),
+                      cache_equations
+                          ? CalculateCacheKey(constructions, parameters)
+                          : 0};
+
+  std::ofstream file(path, std::ios::binary);
+  if (!file) return false;
+
+  constexpr std::array<std::byte, Layout::kAlignment> kPadding{};
+  Write(file, std::span{&header, 1});
+  Write<ConstructionRecord>(file, constructions);
+  Write<PackedComplex>(file, parameters);
+  Write<std::uint64_t>(file, name_offsets);
+  Write<char>(file, names);
+  Write(file, std::span{kPadding}.first(Layout::Align(names.size()) -
+                                        names.size()));
+  Write<PackedComplex>(file, equations);
+
+  return static_cast<bool>(file);
+}
+
+bool Load(const std::filesystem::path& path, PlaneImplementation& plane)
+{
+  const MappedFile file(path);
+  if (!file.IsOpen()) return false;
+
+  const auto bytes = file.GetBytes();
+
+  // Check header
+  Header header;
+  if (bytes.size() < sizeof(header)) return false;
+  std::memcpy(&header, bytes.data(), sizeof(header));
+
+  if (header.magic != kMagic || header.version != kVersion) return false;
+
+  // Sections can't be larger than the file, it also prevents overflows
+  if (header.constructions >= kNoParent || header.parameters > bytes.size() ||
+      header.name_bytes > bytes.size() || header.equations > bytes.size())
+  {
+    return false;
+  }
+
+  const Layout layout(header);
+  if (layout.size != bytes.size()) return false;
+
+  // Sections are used in place
+  const auto constructions = GetSection<ConstructionRecord>(
+      bytes, layout.constructions, header.constructions);
+  const auto parameters =
+      GetSection<PackedComplex>(bytes, layout.parameters, header.parameters);
+  const auto name_offsets = GetSection<std::uint64_t>(
+      bytes, layout.name_offsets, header.constructions + 1);
+  const auto names = GetSection<char>(bytes, layout.names, header.name_bytes);
+  const auto equations =
+      GetSection<PackedComplex>(bytes, layout.equations, header.equations);
+
+  auto get_point = [&constructions, &parameters](const std::uint32_t id)
+  {
+    return PointEquation{UnpackCoordinate(parameters.data() +
+                                          constructions[id].first_parameter)};
+  };
+
+  // Check everything before the plane is changed
+  size_t expected_equations = 0;
+  for (size_t id = 0; id < constructions.size(); ++id)
+  {
+    const auto& [type, parents, first_parameter] = constructions[id];
+
+    if (type >= ConstructionType::kCount ||
+        first_parameter + CountParameters(type) > parameters.size() ||
+        name_offsets[id] > name_offsets[id + 1])
+    {
+      return false;
+    }
+
+    // Numbers must be finite, point and line can't be (0:0:0)
+    const auto* parameter = parameters.data() + first_parameter;
+    if (!std::all_of(parameter, parameter + CountParameters(type), IsFinite) ||
+        ((type == ConstructionType::kPointOnPlane ||
+          type == ConstructionType::kLineOnPlane) &&
+         IsZeroCoordinate(parameter)))
+    {
+      return false;
+    }
+
+    // Line by two points depends on earlier points
+    if (type == ConstructionType::kLineByTwoPoints &&
+        !std::ranges::all_of(
+            parents,
+            [id, &constructions](const std::uint32_t parent)
+            {
+              return parent < id && constructions[parent].type ==
+                                        ConstructionType::kPointOnPlane;
+            }))
+    {
+      return false;
+    }
+
+    // Line by two points needs points, which don't coincide
+    if (type == ConstructionType::kLineByTwoPoints &&
+        (parents[0] == parents[1] ||
+         !ByTwoPoints::Fit(get_point(parents[0]), get_point(parents[1]))))
+    {
+      return false;
+    }
+
+    expected_equations += CountEquations(type);
+  }
+
+  if (name_offsets.front() != 0 || name_offsets.back() != names.size())
+  {
+    return false;
+  }
+
+  // Stale or missing cache only makes loading slower
+  auto is_cache_valid =
+      equations.size() == expected_equations &&
+      header.cache_key == CalculateCacheKey(constructions, parameters) &&
+      std::ranges::all_of(equations, IsFinite);
+
+  // Cached equations are only of lines by two points
+  for (size_t equation = 0; is_cache_valid && equation < equations.size();
+       equation += CountEquations(ConstructionType::kLineByTwoPoints))
+  {
+    is_cache_valid = !IsZeroCoordinate(equations.data() + equation);
+  }
+
+  std::vector<GeometricObject*> objects;
+  objects.reserve(constructions.size());
+  std::vector<std::string> object_names;
+  object_names.reserve(constructions.size());
+  size_t next_equation = 0;
+
+  for (size_t id = 0; id < constructions.size(); ++id)
+  {
+    const auto& [type, parents, first_parameter] = constructions[id];
+    const auto* parameter = parameters.data() + first_parameter;
+
+    std::unique_ptr<Construction> construction;
+    switch (type)
+    {
+      case ConstructionType::kPointOnPlane:
+        construction = std::make_unique<PointOnPlane>(
+            PointEquation{UnpackCoordinate(parameter)});
+        break;
+      case ConstructionType::kLineOnPlane:
+        construction = std::make_unique<LineOnPlane>(
+            LineEquation{UnpackCoordinate(parameter)});
+        break;
+      case ConstructionType::kLineByTwoPoints:
+      {
+        auto* first = static_cast<Point*>(objects[parents[0]]);
+        auto* second = static_cast<Point*>(objects[parents[1]]);
+
+        if (is_cache_valid)
+        {
+          construction = std::make_unique<ByTwoPoints>(
+              first, second,
+              LineEquation{UnpackCoordinate(equations.data() + next_equation)});
+          next_equation += CountEquations(type);
+        }
+        else
+        {
+          construction = std::make_unique<ByTwoPoints>(first, second);
+        }
+        break;
+      }
+      case ConstructionType::kConicOnPlane:
+        construction = std::make_unique<ConicOnPlane>(UnpackConic(parameter));
+        break;
+      default:
+        Assert(false, "Construction table was checked");
+    }
+
+    auto* object = construction->GetObject();
+    plane.AddConstruction(std::move(construction));
+
+    object_names.emplace_back(names.data() + name_offsets[id],
+                              name_offsets[id + 1] - name_offsets[id]);
+    objects.push_back(object);
+  }
+
+  // Collisions with names of the plane are resolved at once
+  plane.AssignNames(objects, object_names);
+
+  return true;
+}
+}  // namespace HomoGebra::SceneFile
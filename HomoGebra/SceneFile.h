@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+
+namespace HomoGebra
+{
+class PlaneImplementation;
+
+/**
+ * \brief Binary file with constructions of a plane.
+ *
+ * \details All numbers are little-endian and every section is aligned to 8
+ * bytes, so a mapped file is used as is:
+ * - header: magic, version, sizes of sections and a key of the cache;
+ * - construction table: type of every construction, ids of its parents
+ *   (indices in the table) and index of its first parameter;
+ * - parameters: complex numbers as pairs of doubles, equations of free
+ *   objects;
+ * - name table: offsets of names, then their characters;
+ * - cached equations (optional): equations of dependent objects. They are
+ *   used only if the key matches the construction table and the parameters,
+ *   otherwise dependent objects are recalculated.
+ *
+ * Construction is always written after its parents.
+ */
+namespace SceneFile
+{
+inline constexpr std::uint32_t kVersion = 1;  //!< Version of the format.
+
+/**
+ * \brief Writes constructions of a plane to a file.
+ *
+ * \param plane Plane to write.
+ * \param path Path to the file.
+ * \param cache_equations Write equations of dependent objects.
+ *
+ * \return True if the file is written, false if it couldn't be opened or
+ * plane has constructions, which the format doesn't support.
+ */
+[[nodiscard]] bool Save(const PlaneImplementation& plane,
+                        const std::filesystem::path& path,
+                        bool cache_equations = true);
+
+/**
+ * \brief Adds constructions from a file to a plane.
+ *
+ * \details The file is memory-mapped and checked before anything is added,
+ * so plane isn't changed if the file is broken.
+ *
+ * \param path Path to the file.
+ * \param plane Plane to add constructions to.
+ *
+ * \return True if the file is loaded, false if it is broken, for example a
+ * line goes through coincident points.
+ */
+[[nodiscard]] bool Load(const std::filesystem::path& path,
+                        PlaneImplementation& plane);
+}  // namespace SceneFile
+}  // namespace HomoGebra
@@ -0,0 +1,315 @@
+#include "SceneGenerator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "GeometricObjectFactory.h"
+
+namespace HomoGebra::SceneGenerator
+{
+namespace
+{
+/**
+ * \brief Source of random numbers, which are the same on every platform.
+ *
+ * \details Sequence of std::mt19937 is defined by the standard, unlike
+ * distributions, so numbers are mapped by hand.
+ */
+class Random
+{
+ public:
+  /**
+   * \brief Constructs source by seed.
+   *
+   * \param seed Seed.
+   */
+  explicit Random(const unsigned seed) : generator_(seed) {}
+
+  /**
+   * \brief Gets real number in [from, to).
+   *
+   * \param from Lower bound.
+   * \param to Upper bound.
+   *
+   * \return Number.
+   */
+  float GetReal(const float from, const float to)
+  {
+    // 24 bits fill the mantissa
+    constexpr float kScale = 1.f / static_cast<float>(1 << 24);
+    return from + (to - from) * static_cast<float>(generator_() >> 8) * kScale;
+  }
+
+  /**
+   * \brief Gets index in [0, size).
+   *
+   * \param size Amount of indices, not zero.
+   *
+   * \return Index.
+   */
+  size_t GetIndex(const size_t size)
+  {
+    return static_cast<size_t>(
+        (static_cast<std::uint64_t>(generator_()) * size) >> 32);
+  }
+
+  /**
+   * \brief Checks if an event with the probability has happened.
+   *
+   * \param probability Probability of the event.
+   *
+   * \return True if it has happened.
+   */
+  bool Roll(const float probability)
+  {
+    return GetReal(0.f, 1.f) < probability;
+  }
+
+ private:
+  /**
+   * Member data.
+   */
+  std::mt19937 generator_;  //!< Generator of bits.
+};
+
+/**
+ * \brief Position of a point.
+ */
+struct Position
+{
+  float x;  //!< Abscissa.
+  float y;  //!< Ordinate.
+
+  bool operator==(const Position&) const = default;
+};
+
+/**
+ * \brief Adds objects to a plane and remembers, what lines may go through.
+ */
+class Builder
+{
+ public:
+  /**
+   * \brief Constructs builder.
+   *
+   * \param plane Plane to add objects to.
+   * \param options Options of the scene.
+   */
+  Builder(PlaneImplementation& plane, const Options& options)
+      : plane_(plane), options_(options), random_(options.seed)
+  {}
+
+  /**
+   * \brief Adds all objects.
+   *
+   * \return What is generated.
+   */
+  Report Build()
+  {
+    auto points = options_.points;
+    auto lines = options_.lines;
+    auto conics = options_.conics;
+
+    while (points + lines + conics > 0)
+    {
+      // Type is chosen by what is left, so types are mixed evenly
+      const auto choice = random_.GetIndex(points + lines + conics);
+      const auto is_line = choice >= points && choice < points + lines;
+
+      // Line waits for points while they are left
+      if (choice < points || (is_line && points > 0 && open_.size() < 2))
+      {
+        AddPoint(random_.Roll(options_.degenerate));
+        --points;
+      }
+      else if (is_line)
+      {
+        // Parallel line takes its new point from points, which are left
+        if (points > 0 && !lines_.empty() && !open_.empty() &&
+            random_.Roll(options_.degenerate))
+        {
+          AddParallelLine();
+          --points;
+        }
+        else
+        {
+          AddLine();
+        }
+        --lines;
+      }
+      else
+      {
+        AddConic();
+        --conics;
+      }
+    }
+
+    return report_;
+  }
+
+ private:
+  /**
+   * \brief Amount of tries to find two points, which don't coincide.
+   */
+  static constexpr size_t kTries = 16;
+
+  /**
+   * \brief Adds point.
+   *
+   * \param is_coincident Should the point coincide with an earlier one?
+   *
+   * \return Index of the point.
+   */
+  size_t AddPoint(const bool is_coincident)
+  {
+    if (is_coincident && !positions_.empty())
+    {
+      ++report_.coincident_points;
+      return AddPointAt(positions_[random_.GetIndex(positions_.size())]);
+    }
+
+    const auto x = random_.GetReal(-options_.extent, options_.extent);
+    const auto y = random_.GetReal(-options_.extent, options_.extent);
+    return AddPointAt(Position{x, y});
+  }
+
+  /**
+   * \brief Adds point at a position.
+   *
+   * \param position Position of the point.
+   *
+   * \return Index of the point.
+   */
+  size_t AddPointAt(const Position position)
+  {
+    points_.push_back(PointOnPlaneFactory{&plane_}(
+        PointEquation{HomogeneousCoordinate{position.x, position.y}}));
+    positions_.push_back(position);
+    fan_outs_.push_back(0);
+
+    const auto point = points_.size() - 1;
+    open_slots_.push_back(open_.size());
+    open_.push_back(point);
+
+    ++report_.points;
+    return point;
+  }
+
+  /**
+   * \brief Adds line through two open points, which don't coincide.
+   */
+  void AddLine()
+  {
+    if (open_.size() < 2) return;
+
+    const auto first = open_[random_.GetIndex(open_.size())];
+    for (size_t tries = 0; tries < kTries; ++tries)
+    {
+      const auto second = open_[random_.GetIndex(open_.size())];
+      if (positions_[first] == positions_[second]) continue;
+
+      AddLine(first, second);
+      return;
+    }
+  }
+
+  /**
+   * \brief Adds line through an open point, parallel to an earlier line.
+   */
+  void AddParallelLine()
+  {
+    const auto& [from, to] = lines_[random_.GetIndex(lines_.size())];
+    const Position direction{positions_[to].x - positions_[from].x,
+                             positions_[to].y - positions_[from].y};
+
+    const auto first = open_[random_.GetIndex(open_.size())];
+    const auto second =
+        AddPointAt(Position{positions_[first].x + direction.x,
+                            positions_[first].y + direction.y});
+
+    ++report_.parallel_lines;
+    AddLine(first, second);
+  }
+
+  /**
+   * \brief Adds line through two points.
+   *
+   * \param first Index of the first point.
+   * \param second Index of the second point.
+   */
+  void AddLine(const size_t first, const size_t second)
+  {
+    LineByTwoPointsFactory{&plane_}(points_[first], points_[second]);
+    lines_.emplace_back(first, second);
+    ++report_.lines;
+
+    Use(first);
+    Use(second);
+  }
+
+  /**
+   * \brief Adds circle.
+   */
+  void AddConic()
+  {
+    const auto center_x = random_.GetReal(-options_.extent, options_.extent);
+    const auto center_y = random_.GetReal(-options_.extent, options_.extent);
+    const auto radius =
+        random_.GetReal(options_.extent / 20.f, options_.extent / 2.f);
+
+    // (x - a)^2 + (y - b)^2 - r^2 = 0
+    ConicEquation equation;
+    equation.squares = {
+        Complex{1}, Complex{1},
+        Complex{center_x * center_x + center_y * center_y - radius * radius}};
+    equation.pair_products = {Complex{-2 * center_y}, Complex{-2 * center_x},
+                              Complex{0}};
+
+    ConicOnPlaneFactory{&plane_}(equation);
+    ++report_.conics;
+  }
+
+  /**
+   * \brief Counts line through a point, closes the point if it is full.
+   *
+   * \param point Index of the point.
+   */
+  void Use(const size_t point)
+  {
+    const auto fan_out = ++fan_outs_[point];
+    report_.max_fan_out = std::max(report_.max_fan_out, fan_out);
+
+    if (options_.fan_out == 0 || fan_out < options_.fan_out) return;
+
+    // Last open point takes the slot of the closed one
+    const auto slot = open_slots_[point];
+    open_[slot] = open_.back();
+    open_slots_[open_[slot]] = slot;
+    open_.pop_back();
+  }
+
+  /**
+   * Member data.
+   */
+  PlaneImplementation& plane_;  //!< Plane to add objects to.
+  const Options& options_;      //!< Options of the scene.
+  Random random_;               //!< Source of random numbers.
+  Report report_;               //!< What is generated.
+
+  std::vector<Point*> points_;       //!< Points by index.
+  std::vector<Position> positions_;  //!< Positions of points.
+  std::vector<size_t> fan_outs_;     //!< Amount of lines through points.
+  std::vector<size_t> open_;         //!< Points, which lines may go through.
+  std::vector<size_t> open_slots_;   //!< Indices of points in open_.
+  std::vector<std::pair<size_t, size_t>> lines_;  //!< Points of lines.
+};
+}  // namespace
+
+Report Generate(PlaneImplementation& plane, const Options& options)
+{
+  return Builder(plane, options).Build();
+}
+}  // namespace HomoGebra::SceneGenerator
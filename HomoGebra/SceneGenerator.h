@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+
+namespace HomoGebra
+{
+class PlaneImplementation;
+
+/**
+ * \brief Random scenes for stress tests and benchmarks.
+ *
+ * \details Objects are created by factories in a random order, so lines are
+ * interleaved with points they depend on, as in a scene, which is built by
+ * hand. Scene depends only on options: the same seed gives the same scene.
+ */
+namespace SceneGenerator
+{
+/**
+ * \brief Options of a scene.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+struct Options
+{
+  unsigned seed = 0;     //!< Seed of the scene.
+  size_t points = 100;   //!< Amount of points.
+  size_t lines = 50;     //!< Amount of lines by two points.
+  size_t conics = 10;    //!< Amount of circles.
+  size_t fan_out = 0;    //!< Maximal amount of lines through a point, 0 if any.
+  float degenerate = 0.f;  //!< Share of coincident points and parallel lines.
+  float extent = 500.f;  //!< Half of the size of the region with objects.
+};
+
+/**
+ * \brief What is generated.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+struct Report
+{
+  size_t points{};             //!< Amount of points.
+  size_t lines{};              //!< Amount of lines.
+  size_t conics{};             //!< Amount of conics.
+  size_t coincident_points{};  //!< Points, which coincide with earlier ones.
+  size_t parallel_lines{};     //!< Lines, parallel to earlier ones.
+  size_t max_fan_out{};        //!< Maximal amount of lines through a point.
+};
+
+/**
+ * \brief Adds random objects to a plane.
+ *
+ * \details Line goes through two points, which don't coincide. A line is
+ * skipped, if there are no such points within fan-out, so the report may
+ * have fewer lines than requested.
+ *
+ * Degenerate point is placed exactly at an earlier point. Degenerate line
+ * goes through an earlier point and a new one, so it is parallel to an
+ * earlier line, the new point is one of requested points.
+ *
+ * \param plane Plane to add objects to.
+ * \param options Options of the scene.
+ *
+ * \return What is generated.
+ */
+Report Generate(PlaneImplementation& plane, const Options& options);
+}  // namespace SceneGenerator
+}  // namespace HomoGebra
@@ -0,0 +1,84 @@
+#include "SceneSnapshot.h"
+
+namespace HomoGebra
+{
+void SceneSnapshot::Clear()
+{
+  commands_.clear();
+  vertices_.clear();
+}
+
+void SceneSnapshot::Replay(Canvas& canvas) const
+{
+  auto get_vertices = [this](const size_t first, const size_t count)
+  { return std::span<const sf::Vertex>{vertices_}.subspan(first, count); };
+
+  for (const auto& command : commands_)
+  {
+    if (const auto* circle = std::get_if<Circle>(&command))
+    {
+      canvas.DrawCircle(circle->center, circle->radius, circle->color);
+    }
+    else if (const auto* lines = std::get_if<Lines>(&command))
+    {
+      canvas.DrawLines(get_vertices(lines->first, lines->count));
+    }
+    else if (const auto* polyline = std::get_if<Polyline>(&command))
+    {
+      canvas.DrawPolyline(get_vertices(polyline->first, polyline->count),
+                          polyline->thickness);
+    }
+    else if (const auto* text = std::get_if<Text>(&command))
+    {
+      canvas.DrawText(text->text, text->position, text->height, text->color);
+    }
+  }
+}
+
+bool SceneSnapshot::IsEmpty() const
+{
+  return commands_.empty();
+}
+
+void SceneSnapshot::SetRevision(const std::uint64_t revision)
+{
+  revision_ = revision;
+}
+
+std::uint64_t SceneSnapshot::GetRevision() const { return revision_; }
+
+RecordingCanvas::RecordingCanvas(SceneSnapshot& snapshot) : snapshot_(snapshot)
+{}
+
+void RecordingCanvas::DrawCircle(const sf::Vector2f& center,
+                                 const float radius, const sf::Color& color)
+{
+  snapshot_.commands_.emplace_back(
+      SceneSnapshot::Circle{center, radius, color});
+}
+
+void RecordingCanvas::DrawLines(const std::span<const sf::Vertex> vertices)
+{
+  auto& stored = snapshot_.vertices_;
+  snapshot_.commands_.emplace_back(
+      SceneSnapshot::Lines{stored.size(), vertices.size()});
+  stored.insert(stored.end(), vertices.begin(), vertices.end());
+}
+
+void RecordingCanvas::DrawPolyline(const std::span<const sf::Vertex> vertices,
+                                   const float thickness)
+{
+  auto& stored = snapshot_.vertices_;
+  snapshot_.commands_.emplace_back(
+      SceneSnapshot::Polyline{stored.size(), vertices.size(), thickness});
+  stored.insert(stored.end(), vertices.begin(), vertices.end());
+}
+
+void RecordingCanvas::DrawText(const std::string& text,
+                               const sf::Vector2f& position,
+                               const float height, const sf::Color& color)
+{
+  snapshot_.commands_.emplace_back(
+      SceneSnapshot::Text{text, position, height, color});
+}
+}  // namespace HomoGebra
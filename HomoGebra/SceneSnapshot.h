@@ -0,0 +1,154 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "Canvas.h"
+
+namespace HomoGebra
+{
+/**
+ * \brief Geometry of the plane, which was drawn once and can be drawn again.
+ *
+ * \details Keeps everything bodies have drawn (positions, polylines, names)
+ * in order, so another thread can draw it without touching the plane.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see RecordingCanvas
+ * \see SceneWorker
+ */
+class SceneSnapshot
+{
+ public:
+  /**
+   * \brief Removes everything, but keeps allocated memory.
+   */
+  void Clear();
+
+  /**
+   * \brief Draws everything in order it was recorded.
+   *
+   * \param canvas Canvas to draw to.
+   */
+  void Replay(Canvas& canvas) const;
+
+  /**
+   * \brief Checks if nothing was recorded.
+   *
+   * \return True if snapshot is empty.
+   */
+  [[nodiscard]] bool IsEmpty() const;
+
+  /**
+   * \brief Sets revision of the plane, which is recorded.
+   *
+   * \param revision Revision of the plane.
+   */
+  void SetRevision(std::uint64_t revision);
+
+  /**
+   * \brief Gets revision of the plane, which is recorded.
+   *
+   * \return Revision of the plane.
+   */
+  [[nodiscard]] std::uint64_t GetRevision() const;
+
+ private:
+  friend class RecordingCanvas;
+
+  /**
+   * \brief Recorded filled circle.
+   */
+  struct Circle
+  {
+    sf::Vector2f center;  //!< Center of the circle.
+    float radius;         //!< Radius of the circle.
+    sf::Color color;      //!< Color of the circle.
+  };
+
+  /**
+   * \brief Recorded thin segments.
+   */
+  struct Lines
+  {
+    size_t first;  //!< Index of the first vertex.
+    size_t count;  //!< Amount of vertices.
+  };
+
+  /**
+   * \brief Recorded thick polyline.
+   */
+  struct Polyline
+  {
+    size_t first;     //!< Index of the first vertex.
+    size_t count;     //!< Amount of vertices.
+    float thickness;  //!< Thickness of the polyline.
+  };
+
+  /**
+   * \brief Recorded text.
+   */
+  struct Text
+  {
+    std::string text;       //!< Text to draw.
+    sf::Vector2f position;  //!< Top left corner of the text.
+    float height;           //!< Height of the text.
+    sf::Color color;        //!< Color of the text.
+  };
+
+  using Command = std::variant<Circle, Lines, Polyline, Text>;
+
+  /**
+   * Member data.
+   */
+  std::vector<Command> commands_;     //!< Commands in order of recording.
+  std::vector<sf::Vertex> vertices_;  //!< Vertices of all segments.
+  std::uint64_t revision_ = 0;        //!< Revision of the plane.
+};
+
+/**
+ * \brief Canvas that records into a snapshot instead of drawing.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see SceneSnapshot
+ */
+class RecordingCanvas final : public Canvas
+{
+ public:
+  /**
+   * \brief Constructs canvas, which appends to a snapshot.
+   *
+   * \param snapshot Snapshot to record to.
+   */
+  explicit RecordingCanvas(SceneSnapshot& snapshot);
+
+  void DrawCircle(const sf::Vector2f& center, float radius,
+                  const sf::Color& color) override;
+
+  void DrawLines(std::span<const sf::Vertex> vertices) override;
+
+  void DrawPolyline(std::span<const sf::Vertex> vertices,
+                    float thickness) override;
+
+  void DrawText(const std::string& text, const sf::Vector2f& position,
+                float height, const sf::Color& color) override;
+
+ private:
+  /**
+   * Member data.
+   */
+  SceneSnapshot& snapshot_;  //!< Snapshot to record to.
+};
+}  // namespace HomoGebra
@@ -0,0 +1,248 @@
+#include "SceneWorker.h"
+
+#include "Plane.h"
+#include "Profiler.h"
+
+namespace HomoGebra
+{
+namespace
+{
+/**
+ * \brief Checks if two views map coordinates the same way.
+ *
+ * \param first First view.
+ * \param second Second view.
+ *
+ * \return True if views are equal.
+ */
+bool AreEqual(const sf::View& first, const sf::View& second)
+{
+  return first.getCenter() == second.getCenter() &&
+         first.getSize() == second.getSize() &&
+         first.getRotation() == second.getRotation() &&
+         first.getViewport() == second.getViewport();
+}
+}  // namespace
+
+SceneWorker::SceneWorker(std::unique_ptr<Plane> plane, const sf::View& view,
+                         const sf::Vector2u& size,
+                         LatencyTracker* latency_tracker)
+    : plane_(std::move(plane)),
+      target_(size),
+      latency_tracker_(latency_tracker),
+      view_(view),
+      size_(size),
+      thread_([this](const std::stop_token& stop_token) { Run(stop_token); })
+{}
+
+SceneWorker::~SceneWorker()
+{
+  thread_.request_stop();
+  thread_.join();
+}
+
+std::uint64_t SceneWorker::Post(Command command)
+{
+  std::uint64_t revision;
+  {
+    std::scoped_lock lock(mutex_);
+    revision = Queue(std::move(command), false);
+  }
+  wake_.notify_one();
+  return revision;
+}
+
+std::uint64_t SceneWorker::Post(Command command,
+                                const LatencyTracker::Kind kind,
+                                const LatencyTracker::Clock::time_point input)
+{
+  std::uint64_t revision;
+  {
+    std::scoped_lock lock(mutex_);
+    revision = Queue(std::move(command), false);
+
+    // Worker takes the change only under the lock, so it can't mark it first
+    if (latency_tracker_) latency_tracker_->Begin(kind, revision, input);
+  }
+  wake_.notify_one();
+  return revision;
+}
+
+void SceneWorker::SetView(const sf::View& view, const sf::Vector2u& size)
+{
+  {
+    std::scoped_lock lock(mutex_);
+    if (size_ == size && AreEqual(view_, view)) return;
+
+    view_ = view;
+    size_ = size;
+    dirty_ = true;
+  }
+  wake_.notify_one();
+}
+
+const SceneSnapshot& SceneWorker::AcquireSnapshot()
+{
+  snapshots_.Update();
+  return snapshots_.GetFront();
+}
+
+std::uint64_t SceneWorker::GetRevision()
+{
+  std::scoped_lock lock(mutex_);
+  return revision_;
+}
+
+void SceneWorker::WaitUntilIdle()
+{
+  std::unique_lock lock(mutex_);
+  idle_.wait(lock, [this] { return !dirty_ && !is_recomputing_; });
+}
+
+bool SceneWorker::IsIdle()
+{
+  std::scoped_lock lock(mutex_);
+  return !dirty_ && !is_recomputing_;
+}
+
+bool SceneWorker::HasFreshSnapshot() const { return snapshots_.IsFresh(); }
+
+void SceneWorker::Update(const UserEvent::Click& clicked_event)
+{
+  Post([clicked_event](Plane& plane)
+       { static_cast<EventListener&>(plane).Update(clicked_event); },
+       LatencyTracker::Kind::kClick, LatencyTracker::Clock::now());
+}
+
+void SceneWorker::Update(const UserEvent::Drag& drag_event)
+{
+  const auto input = LatencyTracker::Clock::now();
+  Command command = [drag_event](Plane& plane)
+  { static_cast<EventListener&>(plane).Update(drag_event); };
+
+  {
+    std::scoped_lock lock(mutex_);
+    const auto revision = Queue(std::move(command), true);
+
+    // Worker takes the change only under the lock, so it can't mark it first
+    if (latency_tracker_)
+    {
+      latency_tracker_->Begin(LatencyTracker::Kind::kDrag, revision, input);
+    }
+  }
+  wake_.notify_one();
+}
+
+void SceneWorker::Update(const UserEvent::Unclick& unclick_event)
+{
+  Post([unclick_event](Plane& plane)
+       { static_cast<EventListener&>(plane).Update(unclick_event); });
+}
+
+void SceneWorker::Update(const CameraEvent::ViewChanged& view_changed)
+{
+  SetView(view_changed.view, view_changed.size);
+}
+
+void SceneWorker::Invalidate()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    ++revision_;
+    dirty_ = true;
+  }
+  wake_.notify_one();
+}
+
+void SceneWorker::Run(const std::stop_token& stop_token)
+{
+  std::vector<Command> commands;
+  while (true)
+  {
+    sf::View view;
+    sf::Vector2u size;
+    std::uint64_t revision;
+    {
+      std::unique_lock lock(mutex_);
+      if (!wake_.wait(lock, stop_token, [this] { return dirty_; })) return;
+
+      // Take requests, new ones are collected meanwhile
+      commands.swap(commands_);
+      is_drag_queued_ = false;
+      view = view_;
+      size = size_;
+      revision = revision_;
+      dirty_ = false;
+      is_recomputing_ = true;
+    }
+
+    Recompute(commands, view, size, revision);
+    commands.clear();
+
+    {
+      std::scoped_lock lock(mutex_);
+      is_recomputing_ = false;
+    }
+    idle_.notify_all();
+  }
+}
+
+std::uint64_t SceneWorker::Queue(Command command, const bool is_drag)
+{
+  // Only the latest position matters, so the queued drag is replaced
+  if (is_drag && is_drag_queued_)
+    commands_.back() = std::move(command);
+  else
+    commands_.push_back(std::move(command));
+
+  is_drag_queued_ = is_drag;
+  dirty_ = true;
+  return ++revision_;
+}
+
+void SceneWorker::Recompute(const std::vector<Command>& commands,
+                            const sf::View& view, const sf::Vector2u& size,
+                            const std::uint64_t revision)
+{
+  HOMOGEBRA_PROFILE_SCOPE("Recompute");
+
+  auto& snapshot = snapshots_.GetBack();
+  snapshot.Clear();
+  snapshot.SetRevision(revision);
+
+  {
+    std::scoped_lock lock(plane_mutex_);
+
+    for (const auto& command : commands)
+    {
+      command(*plane_);
+    }
+
+    if (latency_tracker_)
+    {
+      latency_tracker_->Mark(LatencyTracker::Stage::kApplied, revision);
+    }
+
+    target_.SetSize(size);
+    target_.setView(view);
+
+    {
+      HOMOGEBRA_PROFILE_SCOPE("UpdateBodies");
+      plane_->UpdateBodies(target_);
+    }
+
+    {
+      HOMOGEBRA_PROFILE_SCOPE("Record snapshot");
+      RecordingCanvas canvas(snapshot);
+      plane_->Draw(canvas);
+    }
+  }
+
+  snapshots_.Publish();
+
+  if (latency_tracker_)
+  {
+    latency_tracker_->Mark(LatencyTracker::Stage::kPublished, revision);
+  }
+}
+}  // namespace HomoGebra
@@ -0,0 +1,300 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Camera.h"
+#include "EventNotifier.h"
+#include "LatencyTracker.h"
+#include "SceneSnapshot.h"
+#include "TripleBuffer.h"
+
+namespace HomoGebra
+{
+class Plane;
+
+/**
+ * \brief Recomputes the plane on its own thread.
+ *
+ * \details Owns the plane. Changes of the plane, clicks and changes of the
+ * view (e.g. from a Camera) are queued and applied by the worker, which then
+ * updates bodies and records them into a snapshot. The render thread draws
+ * the newest snapshot, which it takes without locking, so a recompute longer
+ * than a frame never stops rendering or input: the previous snapshot is
+ * drawn meanwhile.
+ *
+ * Code that needs the plane itself (GUI windows) may use TryAccess(), which
+ * doesn't wait for a running recompute.
+ *
+ * Every change of the plane increments its revision. Snapshot keeps the
+ * revision it was recorded at, so latency of changes can be tracked.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see SceneSnapshot
+ * \see TripleBuffer
+ */
+class SceneWorker final : public EventListener, public CameraObserver
+{
+ public:
+  /**
+   * \brief Change of the plane, which is applied by the worker.
+   */
+  using Command = std::function<void(Plane&)>;
+
+  /**
+   * \brief Starts worker, which recomputes the plane for a view.
+   *
+   * \param plane Plane to own.
+   * \param view View of the render target.
+   * \param size Size of the render target in pixels.
+   * \param latency_tracker Tracker of clicks and stages of changes, may be
+   * null.
+   */
+  SceneWorker(std::unique_ptr<Plane> plane, const sf::View& view,
+              const sf::Vector2u& size,
+              LatencyTracker* latency_tracker = nullptr);
+
+  /**
+   * \brief Stops worker.
+   */
+  ~SceneWorker() override;
+
+  SceneWorker(const SceneWorker&) = delete;
+  SceneWorker& operator=(const SceneWorker&) = delete;
+
+  /**
+   * \brief Queues change of the plane.
+   *
+   * \param command Change to apply on the worker thread.
+   *
+   * \return Revision of the plane with the change.
+   */
+  std::uint64_t Post(Command command);
+
+  /**
+   * \brief Queues change of the plane and begins tracking its latency.
+   *
+   * \details Change is begun in the tracker before the worker can apply it.
+   *
+   * \param command Change to apply on the worker thread.
+   * \param kind Kind of the input, which has made the change.
+   * \param input Time of the input.
+   *
+   * \return Revision of the plane with the change.
+   */
+  std::uint64_t Post(Command command, LatencyTracker::Kind kind,
+                     LatencyTracker::Clock::time_point input);
+
+  /**
+   * \brief Sets view, which bodies are updated for.
+   *
+   * \details Does nothing if view is the same.
+   *
+   * \param view View of the render target.
+   * \param size Size of the render target in pixels.
+   */
+  void SetView(const sf::View& view, const sf::Vector2u& size);
+
+  /**
+   * \brief Calls function with the plane if no recompute is running.
+   *
+   * \tparam Function Type of a function, which takes Plane& and returns
+   * true if it has changed the plane.
+   *
+   * \param function Function to call.
+   *
+   * \return True if function was called.
+   */
+  template <class Function>
+  bool TryAccess(Function&& function);
+
+  /**
+   * \brief Gets the newest snapshot.
+   *
+   * \details Only the render thread may call it. Snapshot is valid until the
+   * next call.
+   *
+   * \return Snapshot.
+   */
+  [[nodiscard]] const SceneSnapshot& AcquireSnapshot();
+
+  /**
+   * \brief Gets the newest revision of the plane.
+   *
+   * \return Revision, which includes all queued changes.
+   */
+  [[nodiscard]] std::uint64_t GetRevision();
+
+  /**
+   * \brief Waits until all requests are recomputed and published.
+   *
+   * \details Makes frames deterministic, e.g. when input is replayed.
+   */
+  void WaitUntilIdle();
+
+  /**
+   * \brief Checks if all requests are recomputed and published.
+   *
+   * \return True if no snapshot is expected until the next request.
+   */
+  [[nodiscard]] bool IsIdle();
+
+  /**
+   * \brief Checks if a snapshot is published, which isn't acquired yet.
+   *
+   * \details Only the render thread may call it.
+   *
+   * \return True if the next AcquireSnapshot() gives a new snapshot.
+   */
+  [[nodiscard]] bool HasFreshSnapshot() const;
+
+  /**
+   * \brief Queues click to the plane.
+   *
+   * \param clicked_event Click.
+   */
+  void Update(const UserEvent::Click& clicked_event) override;
+
+  /**
+   * \brief Queues drag to the plane.
+   *
+   * \details Drag replaces the queued one, if nothing is queued after it.
+   * So the worker recomputes only the latest position, however often the
+   * mouse moves.
+   *
+   * \param drag_event Drag.
+   */
+  void Update(const UserEvent::Drag& drag_event) override;
+
+  /**
+   * \brief Queues unclick to the plane.
+   *
+   * \param unclick_event Unclick.
+   */
+  void Update(const UserEvent::Unclick& unclick_event) override;
+
+  /**
+   * \brief Recomputes the plane for the new view of the camera.
+   *
+   * \param view_changed Tag with the new view.
+   */
+  void Update(const CameraEvent::ViewChanged& view_changed) override;
+
+ private:
+  /**
+   * \brief Render target, which has only view and size.
+   *
+   * \details Bodies are updated against it on the worker thread, as they
+   * need only mapping between pixels and coordinates.
+   */
+  class ViewTarget final : public sf::RenderTarget
+  {
+   public:
+    /**
+     * \brief Constructs target of a size.
+     *
+     * \param size Size in pixels.
+     */
+    explicit ViewTarget(const sf::Vector2u& size) : size_(size)
+    {
+      initialize();
+    }
+
+    /**
+     * \brief Sets size of the target.
+     *
+     * \param size Size in pixels.
+     */
+    void SetSize(const sf::Vector2u& size) { size_ = size; }
+
+    [[nodiscard]] sf::Vector2u getSize() const override { return size_; }
+
+   private:
+    /**
+     * Member data.
+     */
+    sf::Vector2u size_;  //!< Size in pixels.
+  };
+
+  /**
+   * \brief Asks worker to recompute.
+   */
+  void Invalidate();
+
+  /**
+   * \brief Waits for changes and recomputes until stopped.
+   *
+   * \param stop_token Token, which stops the worker.
+   */
+  void Run(const std::stop_token& stop_token);
+
+  /**
+   * \brief Queues change, mutex_ must be locked.
+   *
+   * \param command Change to apply on the worker thread.
+   * \param is_drag Replace the queued drag, if the change is a drag too.
+   *
+   * \return Revision of the plane with the change.
+   */
+  std::uint64_t Queue(Command command, bool is_drag);
+
+  /**
+   * \brief Applies changes, updates bodies and publishes a snapshot.
+   *
+   * \param commands Changes of the plane.
+   * \param view View to update bodies for.
+   * \param size Size of the render target in pixels.
+   * \param revision Revision of the plane with the changes.
+   */
+  void Recompute(const std::vector<Command>& commands, const sf::View& view,
+                 const sf::Vector2u& size, std::uint64_t revision);
+
+  /**
+   * Member data.
+   */
+  std::unique_ptr<Plane> plane_;  //!< Owned plane.
+  std::mutex plane_mutex_;        //!< Guards the plane.
+  ViewTarget target_;             //!< Target of the worker thread.
+
+  LatencyTracker* latency_tracker_;  //!< Tracker of changes, may be null.
+
+  std::mutex mutex_;                  //!< Guards requests below.
+  std::condition_variable_any wake_;  //!< Wakes worker on requests.
+  std::vector<Command> commands_;     //!< Queued changes.
+  bool is_drag_queued_ = false;       //!< Is the last queued change a drag?
+  sf::View view_;                     //!< Requested view.
+  sf::Vector2u size_;                 //!< Requested size.
+  bool dirty_ = true;                 //!< Should worker recompute?
+  bool is_recomputing_ = false;       //!< Is worker recomputing?
+  std::uint64_t revision_ = 0;        //!< Revision of the plane.
+  std::condition_variable_any idle_;  //!< Wakes waiters when idle.
+
+  TripleBuffer<SceneSnapshot> snapshots_;  //!< Recorded snapshots.
+
+  std::jthread thread_;  //!< Worker thread, which is stopped first.
+};
+
+template <class Function>
+bool SceneWorker::TryAccess(Function&& function)
+{
+  std::unique_lock lock(plane_mutex_, std::try_to_lock);
+  if (!lock) return false;
+
+  const bool changed = std::forward<Function>(function)(*plane_);
+  lock.unlock();
+
+  if (changed) Invalidate();
+  return true;
+}
+}  // namespace HomoGebra
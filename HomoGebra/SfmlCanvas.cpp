@@ -0,0 +1,63 @@
+#include "SfmlCanvas.h"
+
+#include "ThickLineDrawer.h"
+
+namespace HomoGebra
+{
+SfmlCanvas::SfmlCanvas(sf::RenderTarget& target, const sf::RenderStates states)
+    : target_(target), states_(states)
+{}
+
+void SfmlCanvas::DrawCircle(const sf::Vector2f& center, const float radius,
+                            const sf::Color& color)
+{
+  sf::CircleShape circle(radius);
+  circle.setOrigin(radius, radius);
+  circle.setPosition(center);
+  circle.setFillColor(color);
+
+  target_.draw(circle, states_);
+}
+
+void SfmlCanvas::DrawLines(const std::span<const sf::Vertex> vertices)
+{
+  target_.draw(vertices.data(), vertices.size(), sf::Lines, states_);
+}
+
+void SfmlCanvas::DrawPolyline(const std::span<const sf::Vertex> vertices,
+                              const float thickness)
+{
+  ThickLineDrawer{}.Draw(target_, vertices, thickness);
+}
+
+void SfmlCanvas::DrawText(const std::string& text, const sf::Vector2f& position,
+                          const float height, const sf::Color& color)
+{
+  sf::Text drawable_text(text, GetFont(), kCharacterSize);
+  drawable_text.setFillColor(color);
+
+  // Scale text to the height
+  if (const auto text_height = drawable_text.getLocalBounds().height;
+      text_height > 0.f)
+  {
+    const auto factor = height / text_height;
+    drawable_text.setScale({factor, factor});
+  }
+
+  drawable_text.setPosition(position);
+
+  target_.draw(drawable_text, states_);
+}
+
+const sf::Font& SfmlCanvas::GetFont()
+{
+  static const sf::Font font = []
+  {
+    sf::Font loaded_font;
+    loaded_font.loadFromFile(kFontPath);
+    return loaded_font;
+  }();
+
+  return font;
+}
+}  // namespace HomoGebra
@@ -0,0 +1,62 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+#include "Canvas.h"
+
+namespace HomoGebra
+{
+/**
+ * \brief Canvas that draws to SFML render target.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see Canvas
+ */
+class SfmlCanvas final : public Canvas
+{
+ public:
+  /**
+   * \brief Constructs canvas over render target.
+   *
+   * \param target Render target to draw to.
+   * \param states Current render states.
+   */
+  explicit SfmlCanvas(sf::RenderTarget& target,
+                      sf::RenderStates states = sf::RenderStates::Default);
+
+  void DrawCircle(const sf::Vector2f& center, float radius,
+                  const sf::Color& color) override;
+
+  void DrawLines(std::span<const sf::Vertex> vertices) override;
+
+  void DrawPolyline(std::span<const sf::Vertex> vertices,
+                    float thickness) override;
+
+  void DrawText(const std::string& text, const sf::Vector2f& position,
+                float height, const sf::Color& color) override;
+
+ private:
+  /**
+   * \brief Gets font of texts.
+   *
+   * \details Font is loaded once and shared by all texts.
+   *
+   * \return Font of texts.
+   */
+  static const sf::Font& GetFont();
+
+  /**
+   * Member data.
+   */
+  inline static const std::string kFontPath =
+      "Resources/font.ttf";                       //!< Path to font
+  static constexpr unsigned kCharacterSize = 50;  //!< Character size
+
+  sf::RenderTarget& target_;  //!< Render target to draw to.
+  sf::RenderStates states_;   //!< Current render states.
+};
+}  // namespace HomoGebra
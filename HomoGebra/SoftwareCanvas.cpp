@@ -0,0 +1,565 @@
+#include "SoftwareCanvas.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <optional>
+
+namespace HomoGebra
+{
+namespace
+{
+constexpr size_t kGlyphWidth = 5;   //!< Width of a glyph in cells.
+constexpr size_t kGlyphHeight = 7;  //!< Height of a glyph in cells.
+
+using Glyph =
+    std::array<std::uint8_t, kGlyphHeight>;  //!< Rows of cells, high bit left.
+
+/**
+ * \brief Built-in 5x7 font.
+ */
+constexpr std::array<std::pair<char, Glyph>, 45> kGlyphs = {{
+    {'A', {0b01110, 0b10001, 0b10001, 0b11111, 0b10001, 0b10001, 0b10001}},
+    {'B', {0b11110, 0b10001, 0b10001, 0b11110, 0b10001, 0b10001, 0b11110}},
+    {'C', {0b01110, 0b10001, 0b10000, 0b10000, 0b10000, 0b10001, 0b01110}},
+    {'D', {0b11100, 0b10010, 0b10001, 0b10001, 0b10001, 0b10010, 0b11100}},
+    {'E', {0b11111, 0b10000, 0b10000, 0b11110, 0b10000, 0b10000, 0b11111}},
+    {'F', {0b11111, 0b10000, 0b10000, 0b11110, 0b10000, 0b10000, 0b10000}},
+    {'G', {0b01110, 0b10001, 0b10000, 0b10111, 0b10001, 0b10001, 0b01111}},
+    {'H', {0b10001, 0b10001, 0b10001, 0b11111, 0b10001, 0b10001, 0b10001}},
+    {'I', {0b01110, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b01110}},
+    {'J', {0b00111, 0b00010, 0b00010, 0b00010, 0b00010, 0b10010, 0b01100}},
+    {'K', {0b10001, 0b10010, 0b10100, 0b11000, 0b10100, 0b10010, 0b10001}},
+    {'L', {0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b11111}},
+    {'M', {0b10001, 0b11011, 0b10101, 0b10101, 0b10001, 0b10001, 0b10001}},
+    {'N', {0b10001, 0b10001, 0b11001, 0b10101, 0b10011, 0b10001, 0b10001}},
+    {'O', {0b01110, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110}},
+    {'P', {0b11110, 0b10001, 0b10001, 0b11110, 0b10000, 0b10000, 0b10000}},
+    {'Q', {0b01110, 0b10001, 0b10001, 0b10001, 0b10101, 0b10010, 0b01101}},
+    {'R', {0b11110, 0b10001, 0b10001, 0b11110, 0b10100, 0b10010, 0b10001}},
+    {'S', {0b01111, 0b10000, 0b10000, 0b01110, 0b00001, 0b00001, 0b11110}},
+    {'T', {0b11111, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100}},
+    {'U', {0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110}},
+    {'V', {0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01010, 0b00100}},
+    {'W', {0b10001, 0b10001, 0b10001, 0b10101, 0b10101, 0b10101, 0b01010}},
+    {'X', {0b10001, 0b10001, 0b01010, 0b00100, 0b01010, 0b10001, 0b10001}},
+    {'Y', {0b10001, 0b10001, 0b10001, 0b01010, 0b00100, 0b00100, 0b00100}},
+    {'Z', {0b11111, 0b00001, 0b00010, 0b00100, 0b01000, 0b10000, 0b11111}},
+    {'0', {0b01110, 0b10001, 0b10011, 0b10101, 0b11001, 0b10001, 0b01110}},
+    {'1', {0b00100, 0b01100, 0b00100, 0b00100, 0b00100, 0b00100, 0b01110}},
+    {'2', {0b01110, 0b10001, 0b00001, 0b00010, 0b00100, 0b01000, 0b11111}},
+    {'3', {0b11111, 0b00010, 0b00100, 0b00010, 0b00001, 0b10001, 0b01110}},
+    {'4', {0b00010, 0b00110, 0b01010, 0b10010, 0b11111, 0b00010, 0b00010}},
+    {'5', {0b11111, 0b10000, 0b11110, 0b00001, 0b00001, 0b10001, 0b01110}},
+    {'6', {0b00110, 0b01000, 0b10000, 0b11110, 0b10001, 0b10001, 0b01110}},
+    {'7', {0b11111, 0b00001, 0b00010, 0b00100, 0b01000, 0b01000, 0b01000}},
+    {'8', {0b01110, 0b10001, 0b10001, 0b01110, 0b10001, 0b10001, 0b01110}},
+    {'9', {0b01110, 0b10001, 0b10001, 0b01111, 0b00001, 0b00010, 0b01100}},
+    {'_', {0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b11111}},
+    {'-', {0b00000, 0b00000, 0b00000, 0b11111, 0b00000, 0b00000, 0b00000}},
+    {'.', {0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b01100, 0b01100}},
+    {',', {0b00000, 0b00000, 0b00000, 0b00000, 0b01100, 0b00100, 0b01000}},
+    {':', {0b00000, 0b01100, 0b01100, 0b00000, 0b01100, 0b01100, 0b00000}},
+    {'(', {0b00010, 0b00100, 0b01000, 0b01000, 0b01000, 0b00100, 0b00010}},
+    {')', {0b01000, 0b00100, 0b00010, 0b00010, 0b00010, 0b00100, 0b01000}},
+    {'\'', {0b00100, 0b00100, 0b01000, 0b00000, 0b00000, 0b00000, 0b00000}},
+    {' ', {0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000}},
+}};
+
+/**
+ * \brief Finds glyph of a character.
+ *
+ * \param character Character to find.
+ *
+ * \return Glyph of the character, box if font doesn't have it.
+ */
+const Glyph& GetGlyph(const char character)
+{
+  static constexpr Glyph kUnknown = {0b11111, 0b10001, 0b10001, 0b10001,
+                                     0b10001, 0b10001, 0b11111};
+
+  // Font has only capital letters
+  const auto upper = static_cast<char>(
+      std::toupper(static_cast<unsigned char>(character)));
+
+  const auto glyph =
+      std::ranges::find(kGlyphs, upper, &std::pair<char, Glyph>::first);
+
+  return glyph != kGlyphs.end() ? glyph->second : kUnknown;
+}
+
+/**
+ * \brief Calculates CRC-32 of PNG chunk.
+ *
+ * \param data Bytes of the chunk.
+ *
+ * \return CRC-32.
+ */
+std::uint32_t CalculateCrc(const std::vector<std::uint8_t>& data)
+{
+  static const auto kTable = []
+  {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t value = 0; value < table.size(); ++value)
+    {
+      auto crc = value;
+      for (int bit = 0; bit < 8; ++bit)
+      {
+        crc = crc & 1 ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+      }
+      table[value] = crc;
+    }
+    return table;
+  }();
+
+  std::uint32_t crc = 0xFFFFFFFFu;
+  for (const auto byte : data)
+  {
+    crc = kTable[(crc ^ byte) & 0xFF] ^ (crc >> 8);
+  }
+
+  return crc ^ 0xFFFFFFFFu;
+}
+
+/**
+ * \brief Appends number in big-endian order.
+ *
+ * \param bytes Where to append.
+ * \param value Number to append.
+ */
+void AppendBigEndian(std::vector<std::uint8_t>& bytes,
+                     const std::uint32_t value)
+{
+  for (int shift = 24; shift >= 0; shift -= 8)
+  {
+    bytes.push_back(static_cast<std::uint8_t>(value >> shift));
+  }
+}
+
+/**
+ * \brief Writes PNG chunk.
+ *
+ * \param stream Stream to write to.
+ * \param type Type of the chunk.
+ * \param data Data of the chunk.
+ */
+void WriteChunk(std::ostream& stream, const std::string& type,
+                const std::vector<std::uint8_t>& data)
+{
+  std::vector<std::uint8_t> chunk(type.begin(), type.end());
+  chunk.insert(chunk.end(), data.begin(), data.end());
+
+  std::vector<std::uint8_t> header;
+  AppendBigEndian(header, static_cast<std::uint32_t>(data.size()));
+
+  std::vector<std::uint8_t> footer;
+  AppendBigEndian(footer, CalculateCrc(chunk));
+
+  stream.write(reinterpret_cast<const char*>(header.data()),
+               static_cast<std::streamsize>(header.size()));
+  stream.write(reinterpret_cast<const char*>(chunk.data()),
+               static_cast<std::streamsize>(chunk.size()));
+  stream.write(reinterpret_cast<const char*>(footer.data()),
+               static_cast<std::streamsize>(footer.size()));
+}
+}  // namespace
+
+SoftwareCanvas::SoftwareCanvas(const unsigned width, const unsigned height)
+    : width_(width),
+      height_(height),
+      pixels_(static_cast<size_t>(width) * height, sf::Color::White)
+{
+  // Set default view
+  initialize();
+}
+
+sf::Vector2u SoftwareCanvas::getSize() const { return {width_, height_}; }
+
+void SoftwareCanvas::Clear(const sf::Color& color)
+{
+  std::ranges::fill(pixels_, color);
+}
+
+const sf::Color& SoftwareCanvas::GetPixel(const unsigned x,
+                                          const unsigned y) const
+{
+  return pixels_[static_cast<size_t>(y) * width_ + x];
+}
+
+size_t SoftwareCanvas::CountDifferentPixels(const SoftwareCanvas& other,
+                                            const sf::Uint8 tolerance) const
+{
+  if (width_ != other.width_ || height_ != other.height_)
+  {
+    return pixels_.size();
+  }
+
+  auto differs = [tolerance](const sf::Uint8 first, const sf::Uint8 second)
+  { return std::abs(first - second) > tolerance; };
+
+  size_t different{};
+  for (size_t pixel = 0; pixel < pixels_.size(); ++pixel)
+  {
+    const auto& first = pixels_[pixel];
+    const auto& second = other.pixels_[pixel];
+
+    if (differs(first.r, second.r) || differs(first.g, second.g) ||
+        differs(first.b, second.b))
+    {
+      ++different;
+    }
+  }
+
+  return different;
+}
+
+bool SoftwareCanvas::SaveToPpm(const std::string& path) const
+{
+  std::ofstream file(path, std::ios::binary);
+  if (!file) return false;
+
+  file << "P6\n" << width_ << ' ' << height_ << "\n255\n";
+
+  for (const auto& pixel : pixels_)
+  {
+    file.put(static_cast<char>(pixel.r));
+    file.put(static_cast<char>(pixel.g));
+    file.put(static_cast<char>(pixel.b));
+  }
+
+  return static_cast<bool>(file);
+}
+
+bool SoftwareCanvas::SaveToPng(const std::string& path) const
+{
+  std::ofstream file(path, std::ios::binary);
+  if (!file) return false;
+
+  constexpr std::array<std::uint8_t, 8> kSignature = {0x89, 'P',  'N',  'G',
+                                                      '\r', '\n', 0x1A, '\n'};
+  file.write(reinterpret_cast<const char*>(kSignature.data()),
+             kSignature.size());
+
+  // Width, height, 8 bits per channel, RGB, no interlace
+  std::vector<std::uint8_t> header;
+  AppendBigEndian(header, width_);
+  AppendBigEndian(header, height_);
+  header.insert(header.end(), {8, 2, 0, 0, 0});
+  WriteChunk(file, "IHDR", header);
+
+  // Every row starts with filter type
+  std::vector<std::uint8_t> raw;
+  raw.reserve(static_cast<size_t>(height_) * (width_ * 3 + 1));
+  for (unsigned row = 0; row < height_; ++row)
+  {
+    raw.push_back(0);
+    for (unsigned column = 0; column < width_; ++column)
+    {
+      const auto& pixel = GetPixel(column, row);
+      raw.insert(raw.end(), {pixel.r, pixel.g, pixel.b});
+    }
+  }
+
+  // Zlib stream with stored deflate blocks
+  std::vector<std::uint8_t> data = {0x78, 0x01};
+  constexpr size_t kMaxBlockSize = 0xFFFF;
+  size_t offset = 0;
+  do
+  {
+    const auto size = std::min(kMaxBlockSize, raw.size() - offset);
+    const bool is_last = offset + size == raw.size();
+
+    data.push_back(is_last ? 1 : 0);
+    data.push_back(static_cast<std::uint8_t>(size));
+    data.push_back(static_cast<std::uint8_t>(size >> 8));
+    data.push_back(static_cast<std::uint8_t>(~size));
+    data.push_back(static_cast<std::uint8_t>(~size >> 8));
+    data.insert(data.end(), raw.begin() + static_cast<ptrdiff_t>(offset),
+                raw.begin() + static_cast<ptrdiff_t>(offset + size));
+
+    offset += size;
+  } while (offset < raw.size());
+
+  // Adler-32 of uncompressed data
+  std::uint32_t low = 1;
+  std::uint32_t high = 0;
+  for (const auto byte : raw)
+  {
+    constexpr std::uint32_t kModulo = 65521;
+    low = (low + byte) % kModulo;
+    high = (high + low) % kModulo;
+  }
+  AppendBigEndian(data, high << 16 | low);
+
+  WriteChunk(file, "IDAT", data);
+  WriteChunk(file, "IEND", {});
+
+  return static_cast<bool>(file);
+}
+
+bool SoftwareCanvas::LoadFromPpm(const std::string& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file) return false;
+
+  // Reads next number of the header, skipping comments
+  auto read_number = [&file]() -> std::optional<unsigned>
+  {
+    file >> std::ws;
+    while (file.peek() == '#')
+    {
+      file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+      file >> std::ws;
+    }
+
+    unsigned number{};
+    if (!(file >> number)) return std::nullopt;
+    return number;
+  };
+
+  std::string magic;
+  file >> magic;
+  if (magic != "P6") return false;
+
+  const auto width = read_number();
+  const auto height = read_number();
+  const auto max_value = read_number();
+  if (!width || !height || max_value != 255u) return false;
+
+  // Single whitespace separates header and pixels
+  file.get();
+
+  std::vector<sf::Color> pixels(static_cast<size_t>(width.value()) *
+                                height.value());
+  for (auto& pixel : pixels)
+  {
+    std::array<char, 3> rgb{};
+    if (!file.read(rgb.data(), rgb.size())) return false;
+
+    pixel = sf::Color(static_cast<sf::Uint8>(rgb[0]),
+                      static_cast<sf::Uint8>(rgb[1]),
+                      static_cast<sf::Uint8>(rgb[2]));
+  }
+
+  width_ = width.value();
+  height_ = height.value();
+  pixels_ = std::move(pixels);
+
+  // Reset view to the new size
+  initialize();
+
+  return true;
+}
+
+void SoftwareCanvas::DrawCircle(const sf::Vector2f& center, const float radius,
+                                const sf::Color& color)
+{
+  const auto pixel_center = MapToPixel(center);
+  FillCapsule(pixel_center, pixel_center, radius * GetPixelsPerUnit(), color);
+}
+
+void SoftwareCanvas::DrawLines(const std::span<const sf::Vertex> vertices)
+{
+  // Thin lines are one pixel wide
+  constexpr float kRadius = 0.5f;
+
+  for (size_t vertex = 1; vertex < vertices.size(); vertex += 2)
+  {
+    FillCapsule(MapToPixel(vertices[vertex - 1].position),
+                MapToPixel(vertices[vertex].position), kRadius,
+                vertices[vertex - 1].color);
+  }
+}
+
+void SoftwareCanvas::DrawPolyline(const std::span<const sf::Vertex> vertices,
+                                  const float thickness)
+{
+  if (vertices.empty()) return;
+
+  const auto radius = thickness / 2.f * GetPixelsPerUnit();
+
+  // Single vertex is a dot
+  if (vertices.size() == 1)
+  {
+    const auto position = MapToPixel(vertices.front().position);
+    FillCapsule(position, position, radius, vertices.front().color);
+    return;
+  }
+
+  auto from = MapToPixel(vertices.front().position);
+  for (size_t vertex = 1; vertex < vertices.size(); ++vertex)
+  {
+    const auto to = MapToPixel(vertices[vertex].position);
+    FillCapsule(from, to, radius, vertices[vertex - 1].color);
+    from = to;
+  }
+}
+
+void SoftwareCanvas::DrawText(const std::string& text,
+                              const sf::Vector2f& position, const float height,
+                              const sf::Color& color)
+{
+  const auto corner = MapToPixel(position);
+  const auto cell = height * GetPixelsPerUnit() / kGlyphHeight;
+
+  for (size_t character = 0; character < text.size(); ++character)
+  {
+    const auto& glyph = GetGlyph(text[character]);
+
+    // One empty column between glyphs
+    const auto left = corner.x + static_cast<float>(character) *
+                                     static_cast<float>(kGlyphWidth + 1) * cell;
+
+    for (size_t row = 0; row < kGlyphHeight; ++row)
+    {
+      for (size_t column = 0; column < kGlyphWidth; ++column)
+      {
+        if (!(glyph[row] >> (kGlyphWidth - 1 - column) & 1)) continue;
+
+        FillRectangle({left + static_cast<float>(column) * cell,
+                       corner.y + static_cast<float>(row) * cell, cell, cell},
+                      color);
+      }
+    }
+  }
+}
+
+sf::Vector2f SoftwareCanvas::MapToPixel(const sf::Vector2f& position) const
+{
+  const auto& view = getView();
+  const auto viewport = getViewport(view);
+
+  // Normalized device coordinates lie in [-1, 1], y goes up
+  const auto normalized = view.getTransform().transformPoint(position);
+
+  return {static_cast<float>(viewport.left) +
+              (normalized.x + 1.f) / 2.f * static_cast<float>(viewport.width),
+          static_cast<float>(viewport.top) +
+              (1.f - normalized.y) / 2.f * static_cast<float>(viewport.height)};
+}
+
+float SoftwareCanvas::GetPixelsPerUnit() const
+{
+  const auto& view = getView();
+
+  return static_cast<float>(getViewport(view).width) / view.getSize().x;
+}
+
+void SoftwareCanvas::FillCapsule(const sf::Vector2f& from,
+                                 const sf::Vector2f& to, const float radius,
+                                 const sf::Color& color)
+{
+  if (width_ == 0 || height_ == 0) return;
+
+  // Coverage falls to zero at this distance
+  const auto reach = radius + 0.5f;
+
+  const auto direction = to - from;
+  const auto length_squared =
+      direction.x * direction.x + direction.y * direction.y;
+
+  const auto top = std::max(std::floor(std::min(from.y, to.y) - reach), 0.f);
+  const auto bottom = std::min(std::ceil(std::max(from.y, to.y) + reach),
+                               static_cast<float>(height_ - 1));
+
+  for (auto row = top; row <= bottom; ++row)
+  {
+    const auto center_y = row + 0.5f;
+
+    // Part of the segment, which is close enough to the row
+    float first = 0.f;
+    float last = 1.f;
+    if (direction.y != 0.f)
+    {
+      first = (center_y - reach - from.y) / direction.y;
+      last = (center_y + reach - from.y) / direction.y;
+      if (first > last) std::swap(first, last);
+      first = std::max(first, 0.f);
+      last = std::min(last, 1.f);
+      if (first > last) continue;
+    }
+    else if (std::abs(center_y - from.y) > reach)
+    {
+      continue;
+    }
+
+    const auto first_x = from.x + direction.x * first;
+    const auto last_x = from.x + direction.x * last;
+    const auto left =
+        std::max(std::floor(std::min(first_x, last_x) - reach), 0.f);
+    const auto right = std::min(std::ceil(std::max(first_x, last_x) + reach),
+                                static_cast<float>(width_ - 1));
+
+    for (auto column = left; column <= right; ++column)
+    {
+      const sf::Vector2f center{column + 0.5f, center_y};
+
+      // Find the nearest point of the segment
+      auto parameter = 0.f;
+      if (length_squared > 0.f)
+      {
+        const auto offset = center - from;
+        parameter = std::clamp(
+            (offset.x * direction.x + offset.y * direction.y) / length_squared,
+            0.f, 1.f);
+      }
+      const auto nearest = from + direction * parameter;
+      const auto distance =
+          std::hypot(center.x - nearest.x, center.y - nearest.y);
+
+      const auto coverage = std::clamp(reach - distance, 0.f, 1.f);
+      if (coverage > 0.f)
+      {
+        Blend(static_cast<unsigned>(column), static_cast<unsigned>(row), color,
+              coverage);
+      }
+    }
+  }
+}
+
+void SoftwareCanvas::FillRectangle(const sf::FloatRect& rectangle,
+                                   const sf::Color& color)
+{
+  // Pixels, which centers are inside the rectangle
+  const auto left = std::max(std::ceil(rectangle.left - 0.5f), 0.f);
+  const auto right =
+      std::min(std::ceil(rectangle.left + rectangle.width - 0.5f),
+               static_cast<float>(width_));
+  const auto top = std::max(std::ceil(rectangle.top - 0.5f), 0.f);
+  const auto bottom =
+      std::min(std::ceil(rectangle.top + rectangle.height - 0.5f),
+               static_cast<float>(height_));
+
+  for (auto row = top; row < bottom; ++row)
+  {
+    for (auto column = left; column < right; ++column)
+    {
+      Blend(static_cast<unsigned>(column), static_cast<unsigned>(row), color,
+            1.f);
+    }
+  }
+}
+
+void SoftwareCanvas::Blend(const unsigned x, const unsigned y,
+                           const sf::Color& color, const float coverage)
+{
+  auto& pixel = pixels_[static_cast<size_t>(y) * width_ + x];
+
+  const auto alpha = coverage * static_cast<float>(color.a) / 255.f;
+
+  auto mix = [alpha](const sf::Uint8 destination, const sf::Uint8 source)
+  {
+    return static_cast<sf::Uint8>(std::lround(
+        static_cast<float>(destination) * (1.f - alpha) +
+        static_cast<float>(source) * alpha));
+  };
+
+  pixel.r = mix(pixel.r, color.r);
+  pixel.g = mix(pixel.g, color.g);
+  pixel.b = mix(pixel.b, color.b);
+}
+}  // namespace HomoGebra
@@ -0,0 +1,171 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+
+#include "Canvas.h"
+
+namespace HomoGebra
+{
+/**
+ * \brief Canvas that rasterizes on CPU into memory.
+ *
+ * \details Doesn't need a window or an OpenGL context, so it can be used on
+ * headless machines for benchmarks and comparing images. It is also a render
+ * target, so bodies can be updated against its view as against a window.
+ * Shapes are anti-aliased by the distance from the center of a pixel, texts
+ * are drawn with a built-in 5x7 bitmap font.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see Canvas
+ */
+class SoftwareCanvas final : public sf::RenderTarget, public Canvas
+{
+ public:
+  /**
+   * \brief Constructs white canvas.
+   *
+   * \param width Width in pixels.
+   * \param height Height in pixels.
+   */
+  SoftwareCanvas(unsigned width, unsigned height);
+
+  /**
+   * \brief Gets size of the canvas.
+   *
+   * \return Size in pixels.
+   */
+  [[nodiscard]] sf::Vector2u getSize() const override;
+
+  /**
+   * \brief Fills all pixels with color.
+   *
+   * \param color Color to fill with.
+   */
+  void Clear(const sf::Color& color = sf::Color::White);
+
+  /**
+   * \brief Gets color of a pixel.
+   *
+   * \param x Column of the pixel.
+   * \param y Row of the pixel.
+   *
+   * \return Color of the pixel.
+   */
+  [[nodiscard]] const sf::Color& GetPixel(unsigned x, unsigned y) const;
+
+  /**
+   * \brief Counts pixels, which differ from pixels of other canvas.
+   *
+   * \param other Canvas to compare with.
+   * \param tolerance Maximum difference of a channel to treat pixels equal.
+   *
+   * \return Amount of different pixels. If sizes differ, all pixels differ.
+   */
+  [[nodiscard]] size_t CountDifferentPixels(const SoftwareCanvas& other,
+                                            sf::Uint8 tolerance = 0) const;
+
+  /**
+   * \brief Saves canvas as binary PPM image.
+   *
+   * \param path Path to the file.
+   *
+   * \return True if file was written.
+   */
+  [[nodiscard]] bool SaveToPpm(const std::string& path) const;
+
+  /**
+   * \brief Saves canvas as PNG image.
+   *
+   * \details Image data is stored without compression.
+   *
+   * \param path Path to the file.
+   *
+   * \return True if file was written.
+   */
+  [[nodiscard]] bool SaveToPng(const std::string& path) const;
+
+  /**
+   * \brief Loads canvas from binary PPM image.
+   *
+   * \details Canvas takes size of the image.
+   *
+   * \param path Path to the file.
+   *
+   * \return True if image was loaded.
+   */
+  [[nodiscard]] bool LoadFromPpm(const std::string& path);
+
+  void DrawCircle(const sf::Vector2f& center, float radius,
+                  const sf::Color& color) override;
+
+  void DrawLines(std::span<const sf::Vertex> vertices) override;
+
+  void DrawPolyline(std::span<const sf::Vertex> vertices,
+                    float thickness) override;
+
+  void DrawText(const std::string& text, const sf::Vector2f& position,
+                float height, const sf::Color& color) override;
+
+ private:
+  /**
+   * \brief Maps coordinates of the plane to pixels.
+   *
+   * \param position Position on the plane.
+   *
+   * \return Position in pixels, not rounded.
+   */
+  [[nodiscard]] sf::Vector2f MapToPixel(const sf::Vector2f& position) const;
+
+  /**
+   * \brief Calculates how many pixels are in a unit of the plane.
+   *
+   * \return Pixels per unit.
+   */
+  [[nodiscard]] float GetPixelsPerUnit() const;
+
+  /**
+   * \brief Fills points, which are close to a segment.
+   *
+   * \details Coverage of a pixel falls linearly from 1 to 0 in a pixel
+   * around the border.
+   *
+   * \param from Start of the segment in pixels.
+   * \param to End of the segment in pixels.
+   * \param radius Half of thickness in pixels.
+   * \param color Color to fill with.
+   */
+  void FillCapsule(const sf::Vector2f& from, const sf::Vector2f& to,
+                   float radius, const sf::Color& color);
+
+  /**
+   * \brief Fills pixels, which centers lie inside a rectangle.
+   *
+   * \param rectangle Rectangle in pixels.
+   * \param color Color to fill with.
+   */
+  void FillRectangle(const sf::FloatRect& rectangle, const sf::Color& color);
+
+  /**
+   * \brief Blends color into a pixel.
+   *
+   * \param x Column of the pixel.
+   * \param y Row of the pixel.
+   * \param color Color to blend.
+   * \param coverage Part of the pixel that is covered.
+   */
+  void Blend(unsigned x, unsigned y, const sf::Color& color, float coverage);
+
+  /**
+   * Member data.
+   */
+  unsigned width_;                 //!< Width in pixels.
+  unsigned height_;                //!< Height in pixels.
+  std::vector<sf::Color> pixels_;  //!< Pixels row by row.
+};
+}  // namespace HomoGebra
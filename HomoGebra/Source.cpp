@@ -1,11 +1,33 @@
 #include <SFML/OpenGL.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "ButtonsImplementations.h"
+#include "Camera.h"
 #include "EventConverter.h"
+#include "EventLog.h"
+#include "FrameScheduler.h"
 #include "GeometricObject.h"
 #include "GeometricObjectFactory.h"
 #include "Gui.h"
+#include "Input.h"
+#include "JsonLines.h"
+#include "LatencyTracker.h"
+#include "Profiler.h"
 #include "SFML/Graphics.hpp"
+#include "SceneFile.h"
+#include "SceneWorker.h"
+#include "SfmlCanvas.h"
+#include "VectorExport.h"
 #include "imgui-SFML.h"
 #include "imgui.h"
 
@@ -97,8 +119,114 @@ Complex ComplexEditor::GetNumber() const
 
 }  // namespace HomoGebra::Editor
 
-int main()
+namespace
 {
+/**
+ * \brief Options of the application.
+ */
+struct Options
+{
+  std::filesystem::path scene;   //!< Path to the scene, may be empty.
+  std::filesystem::path record;  //!< Path to the log to record to.
+  std::filesystem::path replay;  //!< Path to the log to replay.
+  bool fast = false;             //!< Replay without waiting?
+  float budget = 0.f;  //!< Maximal 95th percentile of latency (ms), if set.
+};
+
+/**
+ * \brief Parses command line.
+ *
+ * \details Usage: HomoGebra [scene] [--record log] [--replay log [--fast]
+ * [--budget ms]].
+ *
+ * \param argc Amount of arguments.
+ * \param argv Arguments.
+ *
+ * \return Options or std::nullopt if command line is invalid.
+ */
+std::optional<Options> ParseOptions(const int argc, char** argv)
+{
+  Options options;
+
+  for (int argument = 1; argument < argc; ++argument)
+  {
+    const std::string key = argv[argument];
+
+    if (key == "--fast")
+    {
+      options.fast = true;
+      continue;
+    }
+
+    if (!key.starts_with("--"))
+    {
+      if (!options.scene.empty()) return std::nullopt;
+      options.scene = key;
+      continue;
+    }
+
+    // Other options have a value
+    if (argument + 1 >= argc) return std::nullopt;
+    const std::string value = argv[++argument];
+
+    try
+    {
+      if (key == "--record")
+        options.record = value;
+      else if (key == "--replay")
+        options.replay = value;
+      else if (key == "--budget")
+        options.budget = std::stof(value);
+      else
+        return std::nullopt;
+    }
+    catch (const std::exception&)
+    {
+      return std::nullopt;
+    }
+  }
+
+  // Replay can't be recorded, as its input doesn't come from the window
+  if (!options.record.empty() && !options.replay.empty()) return std::nullopt;
+  if ((options.fast || options.budget > 0.f) && options.replay.empty())
+    return std::nullopt;
+
+  return options;
+}
+}  // namespace
+
+int main(const int argc, char** argv)
+{
+  const auto options = ParseOptions(argc, argv);
+  if (!options)
+  {
+    std::cerr << "Usage: HomoGebra [scene] [--record log] "
+                 "[--replay log [--fast] [--budget ms]]\n";
+    return 2;
+  }
+
+  // Input is taken either from the window or from a log
+  std::unique_ptr<HomoGebra::EventRecorder> recorder;
+  if (!options->record.empty())
+  {
+    recorder = std::make_unique<HomoGebra::EventRecorder>(options->record);
+    if (!recorder->IsGood()) return 1;
+  }
+
+  std::unique_ptr<HomoGebra::EventPlayer> player;
+  if (!options->replay.empty())
+  {
+    player = std::make_unique<HomoGebra::EventPlayer>(
+        options->replay, options->fast
+                             ? HomoGebra::EventPlayer::Speed::kMaximal
+                             : HomoGebra::EventPlayer::Speed::kRecorded);
+    if (!player->IsGood())
+    {
+      std::cerr << "Couldn't replay " << options->replay.string() << '\n';
+      return 1;
+    }
+  }
+
   sf::ContextSettings settings;
   settings.depthBits = 24;
   settings.stencilBits = 8;
@@ -115,84 +243,391 @@ int main()
     return 1;
   }
 
+  // Limit is the timer of animations, idle loop waits for events instead
   window.setFramerateLimit(60);
   ImGui::GetIO().ConfigFlags |= ImGuiConfigFlags_DockingEnable;
 
+  // Blinking cursor would need frames while nothing else changes
+  ImGui::GetIO().ConfigInputTextCursorBlink = false;
+
   auto plane = std::make_unique<HomoGebra::Plane>();
+  auto& implementation = plane->GetImplementation();
 
-  auto first = HomoGebra::PointOnPlaneFactory{plane.get()}(
-      HomoGebra::PointEquation{HomoGebra::HomogeneousCoordinate{100, 100}});
-  auto second = HomoGebra::PointOnPlaneFactory{plane.get()}(
-      HomoGebra::PointEquation{HomoGebra::HomogeneousCoordinate{300, 300}});
+  // Scene is opened from a file, if it is given
+  if (const auto& path = options->scene; path.extension() == ".jsonl")
+  {
+    std::ifstream input(path);
+    if (!input) return 1;
 
-  HomoGebra::ConicEquation equation;
-  equation.squares = {{HomoGebra::Complex{1.0f}, HomoGebra::Complex{0.f, 0.f},
-                       HomoGebra::Complex{0.f, 0.f}}};
-  equation.pair_products = {HomoGebra::Complex{-1.f}, HomoGebra::Complex{0},
-                            HomoGebra::Complex{0.f, 0.f}};
-  auto conic = HomoGebra::ConicOnPlaneFactory{plane.get()}(equation);
+    const auto report = HomoGebra::JsonLines::Import(input, implementation);
+    for (const auto& [line, message] : report.errors)
+    {
+      std::cerr << path.string() << ':' << line << ": " << message << '\n';
+    }
+  }
+  else if (!path.empty())
+  {
+    if (!HomoGebra::SceneFile::Load(path, implementation)) return 1;
+  }
+  else
+  {
+    auto first = HomoGebra::PointOnPlaneFactory{&implementation}(
+        HomoGebra::PointEquation{HomoGebra::HomogeneousCoordinate{100, 100}});
+    auto second = HomoGebra::PointOnPlaneFactory{&implementation}(
+        HomoGebra::PointEquation{HomoGebra::HomogeneousCoordinate{300, 300}});
+
+    HomoGebra::ConicEquation equation;
+    equation.squares = {{HomoGebra::Complex{1.0f},
+                         HomoGebra::Complex{0.f, 0.f},
+                         HomoGebra::Complex{0.f, 0.f}}};
+    equation.pair_products = {HomoGebra::Complex{-1.f},
+                              HomoGebra::Complex{0},
+                              HomoGebra::Complex{0.f, 0.f}};
+    auto conic = HomoGebra::ConicOnPlaneFactory{&implementation}(equation);
+  }
 
   HomoGebra::LineByTwoPointButton line_by_two_point_button{plane.get()};
   HomoGebra::DeleteButton delete_button{plane.get()};
+  HomoGebra::PointDragger point_dragger{plane.get()};
+
+  // Recompute runs on its own thread, the loop only draws its snapshots
+  HomoGebra::LatencyTracker latency_tracker;
+  HomoGebra::SceneWorker worker(std::move(plane), window.getView(),
+                                window.getSize(), &latency_tracker);
+
+  HomoGebra::Camera camera(window.getView(), window.getSize());
+  camera.Attach(&worker);
 
   HomoGebra::EventConverter converter(&window);
-  converter.Attach(plane.get());
+  converter.Attach(&worker);
+
+  std::array<char, 256> export_path{"figure.svg"};
+  std::string export_status;
+
+  std::array<char, 64> search_prefix{};
+
+  // Windows, which need the plane, draw copies while it is recomputed
+  std::vector<std::pair<std::string, float>> distances;
+  std::vector<std::string> found_names;
+
+  // Position of the mouse in pixels, which is replayed
+  sf::Vector2i replayed_mouse;
+
+  using Source = HomoGebra::FrameScheduler::Source;
+
+  // ImGui reacts to an input and lays out new windows in a few frames
+  constexpr size_t kGuiSettleFrames = 3;
+
+  // Period of checks for a snapshot, while it is recomputed
+  const auto kSceneCheckPeriod = sf::milliseconds(5);
+
+  HomoGebra::FrameScheduler scheduler;
+  scheduler.Invalidate(Source::kGui, kGuiSettleFrames);
+
+  // Handles event of the window or the log, false if ImGui has captured it
+  auto handle_event = [&](const sf::Event& event)
+  {
+    HOMOGEBRA_PROFILE_SCOPE("Events");
+
+    if (recorder) recorder->Record(event);
+
+    if (event.type == sf::Event::Closed)
+    {
+      window.close();
+    }
+
+    if (event.type == sf::Event::MouseMoved)
+    {
+      replayed_mouse = {event.mouseMove.x, event.mouseMove.y};
+    }
+
+    scheduler.Invalidate(Source::kInput);
+    scheduler.Invalidate(Source::kGui, kGuiSettleFrames);
+
+    HomoGebra::Gui::Global::ProcessEvent(event);
+
+    if (auto const& io = ImGui::GetIO();
+        io.WantCaptureMouse || io.WantCaptureKeyboard)
+    {
+      return false;
+    }
+
+    converter.Update(event);
+    camera.HandleEvent(event);
+    return true;
+  };
+
+  sf::Clock frame_clock;
   while (window.isOpen())
   {
+    // Replay draws every frame, otherwise valid frame isn't drawn again
+    bool has_waited = false;
+    while (!player && window.isOpen())
+    {
+      // Idle worker publishes nothing, so the snapshot is checked after it
+      const auto is_worker_idle = worker.IsIdle();
+      if (worker.HasFreshSnapshot()) scheduler.Invalidate(Source::kScene);
+      if (camera.IsAnimating()) scheduler.Invalidate(Source::kCamera);
+      if (scheduler.IsInvalid()) break;
+
+      has_waited = true;
+      sf::Event event{};
+      if (is_worker_idle)
+      {
+        // Nothing changes until the next event
+        if (window.waitEvent(event)) handle_event(event);
+      }
+      else
+      {
+        // Snapshot is expected, events are taken meanwhile
+        sf::sleep(kSceneCheckPeriod);
+        if (window.pollEvent(event)) handle_event(event);
+      }
+    }
+
+    // Time of waiting isn't a time of the frame, e.g. for animations
+    if (has_waited) frame_clock.restart();
+
+    // Only closing is taken from the window while replaying
     sf::Event event{};
-    while (window.pollEvent(event))
+    while (player && window.pollEvent(event))
     {
       if (event.type == sf::Event::Closed)
       {
         window.close();
       }
+    }
+
+    while (player ? player->PollEvent(event) : window.pollEvent(event))
+    {
+      if (!handle_event(event)) break;
+    }
+
+    // Moves of the frame are sent as one drag, so one recompute follows
+    converter.Flush();
+
+    // Frame takes the recorded time, so the camera moves the same way
+    const auto frame_time =
+        player ? player->EndFrame() : frame_clock.restart().asSeconds();
+    if (recorder) recorder->EndFrame(frame_time);
+
+    {
+      HOMOGEBRA_PROFILE_SCOPE("Camera");
+
+      camera.Update(frame_time);
+      window.setView(camera.GetView());
+    }
+
+    // Replayed frame is drawn after all its changes are recomputed
+    if (player) worker.WaitUntilIdle();
+
+    window.clear(sf::Color::White);
+
+    {
+      HOMOGEBRA_PROFILE_SCOPE("ImGui update");
+      if (player)
+      {
+        HomoGebra::Gui::Global::Update(window, replayed_mouse,
+                                       sf::seconds(frame_time));
+      }
+      else
+      {
+        HomoGebra::Gui::Global::Update(window);
+      }
+    }
 
-      if (event.type == sf::Event::MouseWheelScrolled)
+    auto mouse_position = window.mapPixelToCoords(
+        player ? replayed_mouse : sf::Mouse::getPosition(window));
+
+    // Windows, which need the plane, draw copies while it is recomputed
+    {
+      HOMOGEBRA_PROFILE_SCOPE("Distance window");
+      ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+      if (ImGui::Begin("Distance"))
       {
+        worker.TryAccess(
+            [&distances](const HomoGebra::Plane& accessed_plane)
+            {
+              distances.resize(accessed_plane.GetViews().size());
+              return false;
+            });
+
+        // Distances are computed only for visible rows
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(distances.size()));
+        while (clipper.Step())
+        {
+          const auto first = static_cast<size_t>(clipper.DisplayStart);
+          const auto last = static_cast<size_t>(clipper.DisplayEnd);
+
+          worker.TryAccess(
+              [&](const HomoGebra::Plane& accessed_plane)
+              {
+                const auto& views = accessed_plane.GetViews();
+                for (auto row = first; row < std::min(last, views.size());
+                     ++row)
+                {
+                  const auto& view = views[row];
+                  distances[row] = {
+                      view->GetObject()->GetName(),
+                      view->GetBody().GetDistance(mouse_position)};
+                }
+                return false;
+              });
+
+          for (auto row = first; row < last; ++row)
+          {
+            const auto& [name, distance] = distances[row];
+            ImGui::Text("%s: %f", name.c_str(), distance);
+          }
+        }
       }
+      ImGui::End();
 
-      HomoGebra::Gui::Global::ProcessEvent(event);
+      ImGui::Begin("Mouse position");
+      ImGui::Text("Mouse position: (%f, %f)", mouse_position.x,
+                  mouse_position.y);
+      ImGui::End();
+    }
 
-      if (auto const& io = ImGui::GetIO();
-          io.WantCaptureMouse || io.WantCaptureKeyboard)
+    {
+      HOMOGEBRA_PROFILE_SCOPE("Find window");
+      ImGui::Begin("Find");
+      ImGui::InputText("Name", search_prefix.data(), search_prefix.size());
+      worker.TryAccess(
+          [&search_prefix, &found_names](const HomoGebra::Plane& accessed_plane)
+          {
+            // Autocompletion shows first names in order
+            constexpr size_t kMaxFound = 10;
+            const auto& implementation = accessed_plane.GetImplementation();
+
+            found_names.clear();
+            for (const auto* object :
+                 implementation.GetNameIndex().FindByPrefix(
+                     search_prefix.data(), kMaxFound))
+            {
+              found_names.push_back(object->GetName());
+            }
+            return false;
+          });
+      for (const auto& name : found_names)
       {
-        break;
+        ImGui::TextUnformatted(name.c_str());
       }
+      ImGui::End();
+    }
 
-      converter.Update(event);
+    {
+      HOMOGEBRA_PROFILE_SCOPE("Export window");
+      ImGui::Begin("Export");
+      ImGui::InputText("Path", export_path.data(), export_path.size());
+      if (ImGui::Button("Export view"))
+      {
+        // Figure is the current view, sizes are the same as on the screen
+        const auto& view = window.getView();
+        const auto corner = view.getCenter() - view.getSize() / 2.f;
+
+        HomoGebra::VectorExport::Options options;
+        options.viewport = {corner.x, corner.y, corner.x + view.getSize().x,
+                            corner.y + view.getSize().y};
+        options.width = static_cast<float>(window.getSize().x);
+
+        const std::filesystem::path path = export_path.data();
+        options.format = path.extension() == ".pdf"
+                             ? HomoGebra::VectorExport::Format::kPdf
+                             : HomoGebra::VectorExport::Format::kSvg;
+
+        const auto accessed = worker.TryAccess(
+            [&](const HomoGebra::Plane& accessed_plane)
+            {
+              std::ofstream output(path, std::ios::binary);
+              export_status =
+                  output && HomoGebra::VectorExport::Export(
+                                accessed_plane.GetImplementation(), options,
+                                output)
+                      ? "Exported"
+                      : "Couldn't write the file";
+              return false;
+            });
+        if (!accessed) export_status = "Plane is busy, try again";
+      }
+      ImGui::TextUnformatted(export_status.c_str());
+      ImGui::End();
     }
-    window.clear(sf::Color::White);
 
-    HomoGebra::Gui::Global::Update(window);
+    std::uint64_t drawn_revision;
+    {
+      HOMOGEBRA_PROFILE_SCOPE("Draw snapshot");
+      HomoGebra::SfmlCanvas canvas(window);
+      const auto& snapshot = worker.AcquireSnapshot();
+      snapshot.Replay(canvas);
+      drawn_revision = snapshot.GetRevision();
+    }
 
-    // print distance from mouse to all objects
-    auto mouse_position =
-        window.mapPixelToCoords(sf::Mouse::getPosition(window));
+    {
+      HOMOGEBRA_PROFILE_SCOPE("Buttons");
+      const auto input = HomoGebra::LatencyTracker::Clock::now();
+
+      // Buttons draw copies, which are made while the plane is free
+      worker.TryAccess(
+          [&](HomoGebra::Plane&)
+          {
+            line_by_two_point_button.Refresh();
+            delete_button.Refresh();
+            return false;
+          });
+
+      // Construction is a change, which is made by buttons in this frame
+      auto post = [&](HomoGebra::SceneWorker::Command change)
+      {
+        worker.Post(std::move(change),
+                    HomoGebra::LatencyTracker::Kind::kConstruction, input);
+      };
+      if (line_by_two_point_button.Draw())
+      {
+        post(line_by_two_point_button.GetChange());
+      }
+      if (delete_button.Draw()) post(delete_button.GetChange());
+    }
+
+    HOMOGEBRA_PROFILE_OVERLAY();
 
-    ImGui::Begin("Distance");
-    for (auto const& object : plane->GetObjects<HomoGebra::GeometricObject>())
     {
-      ImGui::Text("%s: %f", object->GetName().c_str(),
-                  object->GetDistance(mouse_position));
+      HOMOGEBRA_PROFILE_SCOPE("ImGui render");
+      HomoGebra::Gui::Global::Render(window);
     }
-    ImGui::End();
 
-    ImGui::Begin("Mouse position");
-    ImGui::Text("Mouse position: (%f, %f)", mouse_position.x, mouse_position.y);
-    ImGui::End();
+    {
+      HOMOGEBRA_PROFILE_SCOPE("Display");
+      window.display();
+    }
 
-    plane->UpdateBodies(window);  // TODO: Should be called only when window
-                                  // size changes or it moves
-    window.draw(*plane);
+    latency_tracker.Mark(HomoGebra::LatencyTracker::Stage::kDrawn,
+                         drawn_revision);
 
-    line_by_two_point_button.Draw();
-    delete_button.Draw();
+    scheduler.EndFrame();
 
-    HomoGebra::Gui::Global::Render(window);
+    HOMOGEBRA_PROFILE_END_FRAME();
 
-    window.display();
+    if (player && player->IsFinished()) window.close();
   }
 
   ImGui::SFML::Shutdown();
+
+  latency_tracker.Write(std::cout);
+
+  // Replay fails if latency is over the budget
+  if (options->budget > 0.f)
+  {
+    for (const auto& statistics : latency_tracker.GetStatistics())
+    {
+      if (statistics.stage == HomoGebra::LatencyTracker::Stage::kDrawn &&
+          statistics.p95 > options->budget)
+      {
+        return 1;
+      }
+    }
+  }
+
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,421 @@
+#include "SpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "GeometricObjectBody.h"
+
+namespace HomoGebra
+{
+void SpatialIndex::SetCellSize(const float cell_size)
+{
+  // Nothing changed
+  if (cell_size == cell_size_ || !(cell_size > 0.f)) return;
+
+  // All cells are invalid now
+  cell_size_ = cell_size;
+  Clear();
+}
+
+float SpatialIndex::GetCellSize() const { return cell_size_; }
+
+void SpatialIndex::Update(GeometricObject* object, const ObjectBody& body)
+{
+  // Calculate cells that object covers
+  auto cells = Rasterize(body.GetFootprint());
+
+  auto& entry = entries_[object];
+  entry.body = &body;
+
+  // Body didn't move to other cells
+  if (entry.cells == cells) return;
+
+  // Remove object from old cells
+  for (const auto key : entry.cells)
+  {
+    RemoveFromCell(key, object);
+  }
+
+  // Add object to new cells
+  for (const auto key : cells)
+  {
+    auto& objects = cells_[key];
+    if (objects.empty()) CountCell(key, 1);
+
+    objects.push_back(object);
+  }
+
+  entry.cells = std::move(cells);
+  UpdateBounds();
+}
+
+void SpatialIndex::Remove(const GeometricObject* object)
+{
+  const auto entry = entries_.find(object);
+
+  // Object isn't indexed
+  if (entry == entries_.end()) return;
+
+  // Remove object from its cells
+  for (const auto key : entry->second.cells)
+  {
+    RemoveFromCell(key, object);
+  }
+
+  entries_.erase(entry);
+  UpdateBounds();
+}
+
+void SpatialIndex::Clear()
+{
+  cells_.clear();
+  entries_.clear();
+  columns_.clear();
+  rows_.clear();
+
+  UpdateBounds();
+}
+
+GeometricObject* SpatialIndex::FindNearest(const sf::Vector2f& position,
+                                           const Distance max_distance,
+                                           const Filter& filter) const
+{
+  if (cells_.empty()) return nullptr;
+
+  // Start new query
+  ++query_stamp_;
+
+  const auto center = GetCell(position);
+
+  GeometricObject* nearest_object{nullptr};
+  auto nearest_distance = max_distance;
+
+  auto check_object = [&](GeometricObject* object, const ObjectBody& body)
+  {
+    if (filter && !filter(object)) return;
+
+    // Get distance to object
+    const auto distance = body.GetDistance(position);
+
+    // Check if distance is less than current distance
+    if (distance < nearest_distance)
+    {
+      nearest_distance = distance;
+      nearest_object = object;
+    }
+  };
+
+  // Rings that are closer than occupied cells are empty
+  const auto first_ring =
+      std::max({0, min_cell_.x - center.x, center.x - max_cell_.x,
+                min_cell_.y - center.y, center.y - max_cell_.y});
+
+  // Go through rings of cells around the position
+  for (int ring = first_ring;; ++ring)
+  {
+    // Objects in this ring can't be closer than already found one
+    if (GetRingDistance(position, center, ring) >= nearest_distance) break;
+
+    // There are no objects in this ring and further
+    if (!HasCellsOutside(center, ring - 1)) break;
+
+    if (ring == 0)
+    {
+      VisitCell(center, check_object);
+      continue;
+    }
+
+    // Top and bottom rows of the ring
+    for (int x = std::max(center.x - ring, min_cell_.x);
+         x <= std::min(center.x + ring, max_cell_.x); ++x)
+    {
+      VisitCell({x, center.y - ring}, check_object);
+      VisitCell({x, center.y + ring}, check_object);
+    }
+
+    // Left and right columns of the ring
+    for (int y = std::max(center.y - ring + 1, min_cell_.y);
+         y <= std::min(center.y + ring - 1, max_cell_.y); ++y)
+    {
+      VisitCell({center.x - ring, y}, check_object);
+      VisitCell({center.x + ring, y}, check_object);
+    }
+  }
+
+  return nearest_object;
+}
+
+std::vector<GeometricObject*> SpatialIndex::FindInRadius(
+    const sf::Vector2f& position, const Distance radius,
+    const Filter& filter) const
+{
+  std::vector<GeometricObject*> objects;
+
+  if (cells_.empty()) return objects;
+
+  // Start new query
+  ++query_stamp_;
+
+  const auto first = GetCell(position - sf::Vector2f{radius, radius});
+  const auto last = GetCell(position + sf::Vector2f{radius, radius});
+
+  // Go through all cells that intersect the circle
+  for (int x = std::max(first.x, min_cell_.x);
+       x <= std::min(last.x, max_cell_.x); ++x)
+  {
+    for (int y = std::max(first.y, min_cell_.y);
+         y <= std::min(last.y, max_cell_.y); ++y)
+    {
+      VisitCell({x, y},
+                [&](GeometricObject* object, const ObjectBody& body)
+                {
+                  if (filter && !filter(object)) return;
+
+                  if (body.GetDistance(position) <= radius)
+                  {
+                    objects.push_back(object);
+                  }
+                });
+    }
+  }
+
+  return objects;
+}
+
+void SpatialIndex::Update(const PlaneEvent::ObjectAdded& object_added)
+{
+  /*
+   * Object is inserted, when its body is updated.
+   */
+}
+
+void SpatialIndex::Update(const PlaneEvent::ObjectRemoved& object_removed)
+{
+  Remove(object_removed.removed_object);
+}
+
+void SpatialIndex::RemoveFromCell(const CellKey key,
+                                  const GeometricObject* object)
+{
+  const auto objects = cells_.find(key);
+  if (objects == cells_.end()) return;
+
+  std::erase(objects->second, object);
+  if (!objects->second.empty()) return;
+
+  cells_.erase(objects);
+  CountCell(key, -1);
+}
+
+void SpatialIndex::CountCell(const CellKey key, const int change)
+{
+  const auto cell = GetCell(key);
+
+  // Rows and columns without occupied cells are forgotten
+  const auto count = [change](std::map<int, size_t>& counts, const int index)
+  {
+    auto& amount = counts[index];
+    if (change > 0)
+      ++amount;
+    else if (--amount == 0)
+      counts.erase(index);
+  };
+
+  count(columns_, cell.x);
+  count(rows_, cell.y);
+}
+
+void SpatialIndex::UpdateBounds()
+{
+  if (columns_.empty())
+  {
+    // Make bounds empty
+    min_cell_ = {std::numeric_limits<int>::max(),
+                 std::numeric_limits<int>::max()};
+    max_cell_ = {std::numeric_limits<int>::min(),
+                 std::numeric_limits<int>::min()};
+    return;
+  }
+
+  min_cell_ = {columns_.begin()->first, rows_.begin()->first};
+  max_cell_ = {columns_.rbegin()->first, rows_.rbegin()->first};
+}
+
+SpatialIndex::Cell SpatialIndex::GetCell(const CellKey key)
+{
+  return {static_cast<int>(key >> 32),
+          static_cast<int>(static_cast<unsigned>(key))};
+}
+
+SpatialIndex::Cell SpatialIndex::GetCell(const sf::Vector2f& position) const
+{
+  // Limit coordinates, so they fit into a key
+  constexpr float kLimit = 1 << 30;
+
+  const auto x = std::clamp(std::floor(position.x / cell_size_), -kLimit,
+                            kLimit);
+  const auto y = std::clamp(std::floor(position.y / cell_size_), -kLimit,
+                            kLimit);
+
+  return {static_cast<int>(x), static_cast<int>(y)};
+}
+
+SpatialIndex::CellKey SpatialIndex::GetKey(const Cell& cell)
+{
+  return static_cast<CellKey>(static_cast<unsigned long long>(cell.x) << 32 |
+                              static_cast<unsigned>(cell.y));
+}
+
+std::vector<SpatialIndex::CellKey> SpatialIndex::Rasterize(
+    const Footprint& footprint) const
+{
+  std::vector<CellKey> cells;
+
+  auto is_finite = [](const sf::Vector2f& position)
+  { return std::isfinite(position.x) && std::isfinite(position.y); };
+
+  // Add all cells that boxes cover
+  for (const auto& box : footprint.boxes)
+  {
+    const sf::Vector2f corner{box.left, box.top};
+    const auto opposite_corner = corner + sf::Vector2f{box.width, box.height};
+
+    if (!is_finite(corner) || !is_finite(opposite_corner)) continue;
+
+    const auto first = GetCell(corner);
+    const auto last = GetCell(opposite_corner);
+
+    for (int x = first.x; x <= last.x; ++x)
+    {
+      for (int y = first.y; y <= last.y; ++y)
+      {
+        cells.push_back(GetKey({x, y}));
+      }
+    }
+  }
+
+  // Add all cells that polylines cross
+  for (const auto& polyline : footprint.polylines)
+  {
+    if (polyline.size() == 1 && is_finite(polyline.front().position))
+    {
+      cells.push_back(GetKey(GetCell(polyline.front().position)));
+    }
+
+    for (size_t vertex = 1; vertex < polyline.size(); ++vertex)
+    {
+      const auto& from = polyline[vertex - 1].position;
+      const auto& to = polyline[vertex].position;
+
+      if (!is_finite(from) || !is_finite(to)) continue;
+
+      RasterizeSegment(from, to, cells);
+    }
+  }
+
+  // Make cells unique
+  std::ranges::sort(cells);
+  const auto [first, last] = std::ranges::unique(cells);
+  cells.erase(first, last);
+
+  return cells;
+}
+
+void SpatialIndex::RasterizeSegment(const sf::Vector2f& from,
+                                    const sf::Vector2f& to,
+                                    std::vector<CellKey>& cells) const
+{
+  /*
+   * Walk through all cells that segment crosses.
+   * See: Amanatides J., Woo A. "A Fast Voxel Traversal Algorithm".
+   */
+  auto cell = GetCell(from);
+  const auto last = GetCell(to);
+
+  cells.push_back(GetKey(cell));
+
+  const auto direction = to - from;
+
+  const int step_x = direction.x > 0 ? 1 : -1;
+  const int step_y = direction.y > 0 ? 1 : -1;
+
+  constexpr auto kInfinity = std::numeric_limits<float>::infinity();
+
+  // Parameter of the segment to cross one cell
+  const auto delta_x =
+      direction.x != 0.f ? cell_size_ / std::abs(direction.x) : kInfinity;
+  const auto delta_y =
+      direction.y != 0.f ? cell_size_ / std::abs(direction.y) : kInfinity;
+
+  // Parameter of the segment to cross the next border of a cell
+  const auto border_x =
+      static_cast<float>(cell.x + (step_x > 0 ? 1 : 0)) * cell_size_;
+  const auto border_y =
+      static_cast<float>(cell.y + (step_y > 0 ? 1 : 0)) * cell_size_;
+  auto next_x = direction.x != 0.f ? (border_x - from.x) / direction.x
+                                   : kInfinity;
+  auto next_y = direction.y != 0.f ? (border_y - from.y) / direction.y
+                                   : kInfinity;
+
+  // Amount of steps is bounded, so float errors can't make the walk endless
+  auto steps = std::abs(last.x - cell.x) + std::abs(last.y - cell.y);
+
+  while (steps-- > 0)
+  {
+    if (next_x < next_y)
+    {
+      cell.x += step_x;
+      next_x += delta_x;
+    }
+    else
+    {
+      cell.y += step_y;
+      next_y += delta_y;
+    }
+
+    cells.push_back(GetKey(cell));
+  }
+}
+
+void SpatialIndex::VisitCell(
+    const Cell& cell,
+    const std::function<void(GeometricObject*, const ObjectBody&)>& visitor)
+    const
+{
+  const auto objects = cells_.find(GetKey(cell));
+
+  if (objects == cells_.end()) return;
+
+  for (const auto object : objects->second)
+  {
+    // Object is in several cells, so visit it once
+    const auto& entry = entries_.at(object);
+    if (entry.stamp == query_stamp_) continue;
+    entry.stamp = query_stamp_;
+
+    visitor(object, *entry.body);
+  }
+}
+
+Distance SpatialIndex::GetRingDistance(const sf::Vector2f& position,
+                                       const Cell& center,
+                                       const int ring) const
+{
+  if (ring == 0) return 0.f;
+
+  // Borders of cells, which are inside the ring
+  const auto left = static_cast<float>(center.x - ring + 1) * cell_size_;
+  const auto right = static_cast<float>(center.x + ring) * cell_size_;
+  const auto top = static_cast<float>(center.y - ring + 1) * cell_size_;
+  const auto bottom = static_cast<float>(center.y + ring) * cell_size_;
+
+  return std::min({position.x - left, right - position.x, position.y - top,
+                   bottom - position.y});
+}
+
+bool SpatialIndex::HasCellsOutside(const Cell& center, const int ring) const
+{
+  return min_cell_.x < center.x - ring || max_cell_.x > center.x + ring ||
+         min_cell_.y < center.y - ring || max_cell_.y > center.y + ring;
+}
+}  // namespace HomoGebra
@@ -0,0 +1,282 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <functional>
+#include <limits>
+#include <map>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "DistanceUtilities.h"
+#include "Observer.h"
+
+namespace HomoGebra
+{
+class ObjectBody;
+
+/**
+ * \brief Shape of a body that is placed into a spatial index.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see SpatialIndex
+ */
+struct Footprint
+{
+  std::vector<sf::FloatRect> boxes;  //!< Boxes, which are covered by a body.
+  std::vector<std::span<const sf::Vertex>>
+      polylines;  //!< Polylines, which are covered by a body.
+};
+
+/**
+ * \brief Uniform grid over bodies of objects.
+ *
+ * \details Every object is stored in all cells that its footprint crosses.
+ * Queries walk cells in rings around a position, so picking an object costs
+ * time proportional to amount of objects near the position, not to amount of
+ * all objects on the plane.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ *
+ * \see Footprint
+ * \see ObjectProvider
+ */
+class SpatialIndex final : public PlaneObserver
+{
+ public:
+  using Filter =
+      std::function<bool(const GeometricObject*)>;  //!< Filter of objects.
+
+  /**
+   * \brief Sets size of a cell.
+   *
+   * \details If size is changed, then index is cleared, because all cells
+   * become invalid.
+   *
+   * \param cell_size Size of a cell.
+   */
+  void SetCellSize(float cell_size);
+
+  /**
+   * \brief Gets size of a cell.
+   *
+   * \return Size of a cell.
+   */
+  [[nodiscard]] float GetCellSize() const;
+
+  /**
+   * \brief Inserts object or updates its footprint.
+   *
+   * \details Body is kept to measure distances, so it must stay alive while
+   * the object is indexed.
+   *
+   * \param object Object to insert.
+   * \param body Body of the object.
+   */
+  void Update(GeometricObject* object, const ObjectBody& body);
+
+  /**
+   * \brief Removes object from index.
+   *
+   * \param object Object to remove.
+   */
+  void Remove(const GeometricObject* object);
+
+  /**
+   * \brief Removes all objects from index.
+   */
+  void Clear();
+
+  /**
+   * \brief Finds the nearest object to position.
+   *
+   * \param position Position to find object near.
+   * \param max_distance Maximum distance to the object.
+   * \param filter Filter of objects, which can be found.
+   *
+   * \return The nearest object if there is one closer than max_distance,
+   * otherwise nullptr.
+   */
+  [[nodiscard]] GeometricObject* FindNearest(
+      const sf::Vector2f& position,
+      Distance max_distance = std::numeric_limits<Distance>::max(),
+      const Filter& filter = {}) const;
+
+  /**
+   * \brief Finds all objects within radius.
+   *
+   * \param position Center of the circle.
+   * \param radius Radius of the circle.
+   * \param filter Filter of objects, which can be found.
+   *
+   * \return Objects, which are closer than radius.
+   */
+  [[nodiscard]] std::vector<GeometricObject*> FindInRadius(
+      const sf::Vector2f& position, Distance radius,
+      const Filter& filter = {}) const;
+
+  void Update(const PlaneEvent::ObjectAdded& object_added) override;
+
+  /**
+   * \brief Removes object from index, when it is removed from the plane.
+   *
+   * \param object_removed Event with removed object.
+   */
+  void Update(const PlaneEvent::ObjectRemoved& object_removed) override;
+
+ private:
+  using CellKey = long long;  //!< Packed coordinates of a cell.
+
+  /**
+   * \brief Coordinates of a cell.
+   */
+  struct Cell
+  {
+    int x;  //!< Column of the cell.
+    int y;  //!< Row of the cell.
+  };
+
+  /**
+   * \brief Information about an indexed object.
+   */
+  struct Entry
+  {
+    std::vector<CellKey> cells;  //!< Cells, which contain the object.
+    const ObjectBody* body{};    //!< Body to measure distance to.
+    mutable size_t stamp{};      //!< Last query that visited the object.
+  };
+
+  /**
+   * \brief Finds cell of position.
+   *
+   * \param position Position.
+   *
+   * \return Cell that contains position.
+   */
+  [[nodiscard]] Cell GetCell(const sf::Vector2f& position) const;
+
+  /**
+   * \brief Unpacks coordinates of a cell.
+   *
+   * \param key Key of the cell.
+   *
+   * \return Cell.
+   */
+  [[nodiscard]] static Cell GetCell(CellKey key);
+
+  /**
+   * \brief Removes object from a cell, forgets the cell if it is empty.
+   *
+   * \param key Key of the cell.
+   * \param object Object to remove.
+   */
+  void RemoveFromCell(CellKey key, const GeometricObject* object);
+
+  /**
+   * \brief Counts cell in its row and column, when it becomes occupied or
+   * empty.
+   *
+   * \param key Key of the cell.
+   * \param change 1 if the cell is occupied, -1 if it is empty.
+   */
+  void CountCell(CellKey key, int change);
+
+  /**
+   * \brief Sets bounds of occupied cells by occupied rows and columns.
+   */
+  void UpdateBounds();
+
+  /**
+   * \brief Packs coordinates of a cell.
+   *
+   * \param cell Cell to pack.
+   *
+   * \return Key of the cell.
+   */
+  [[nodiscard]] static CellKey GetKey(const Cell& cell);
+
+  /**
+   * \brief Collects all cells, which footprint crosses.
+   *
+   * \param footprint Footprint of an object.
+   *
+   * \return Sorted unique keys of cells.
+   */
+  [[nodiscard]] std::vector<CellKey> Rasterize(
+      const Footprint& footprint) const;
+
+  /**
+   * \brief Collects cells, which segment crosses.
+   *
+   * \param from Start of the segment.
+   * \param to End of the segment.
+   * \param cells Where to put cells.
+   */
+  void RasterizeSegment(const sf::Vector2f& from, const sf::Vector2f& to,
+                        std::vector<CellKey>& cells) const;
+
+  /**
+   * \brief Visits all objects in a cell once per query.
+   *
+   * \param cell Cell to visit.
+   * \param visitor Function to call for every object and its body.
+   */
+  void VisitCell(const Cell& cell,
+                 const std::function<void(GeometricObject*, const ObjectBody&)>&
+                     visitor) const;
+
+  /**
+   * \brief Calculates distance from position to the nearest point of a ring.
+   *
+   * \param position Position.
+   * \param center Center cell of the ring.
+   * \param ring Number of the ring.
+   *
+   * \return Lower bound of distance to any object in the ring.
+   */
+  [[nodiscard]] Distance GetRingDistance(const sf::Vector2f& position,
+                                         const Cell& center, int ring) const;
+
+  /**
+   * \brief Checks if there are some objects outside of ring.
+   *
+   * \param center Center cell of the ring.
+   * \param ring Number of the ring.
+   *
+   * \return True if some cells outside of the ring are occupied.
+   */
+  [[nodiscard]] bool HasCellsOutside(const Cell& center, int ring) const;
+
+  /**
+   * Member data.
+   */
+  static constexpr float kDefaultCellSize = 32.f;  //!< Default cell size.
+
+  float cell_size_ = kDefaultCellSize;  //!< Size of a cell.
+
+  std::unordered_map<CellKey, std::vector<GeometricObject*>>
+      cells_;  //!< Objects in each cell.
+  std::unordered_map<const GeometricObject*, Entry>
+      entries_;  //!< Indexed objects.
+
+  std::map<int, size_t> columns_;  //!< Amount of occupied cells in columns.
+  std::map<int, size_t> rows_;     //!< Amount of occupied cells in rows.
+
+  Cell min_cell_{
+      std::numeric_limits<int>::max(),
+      std::numeric_limits<int>::max()};  //!< Lower bound of occupied cells.
+  Cell max_cell_{
+      std::numeric_limits<int>::min(),
+      std::numeric_limits<int>::min()};  //!< Upper bound of occupied cells.
+
+  mutable size_t query_stamp_{};  //!< Stamp of the current query.
+};
+}  // namespace HomoGebra
@@ -1,5 +1,6 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <span>
 namespace HomoGebra
 {
 /**
@@ -15,7 +16,7 @@ namespace HomoGebra
 class ThickLineDrawer
 {
  public:
-  void Draw(sf::RenderTarget& target, const std::vector<sf::Vertex>& vertices,
+  void Draw(sf::RenderTarget& target, std::span<const sf::Vertex> vertices,
             float thickness)
   {
     if (vertices.empty())
@@ -0,0 +1,624 @@
+/*
+ * Moves free points of a scene and writes equations of dependent objects.
+ * The tool uses only the core library, so it doesn't need graphics.
+ *
+ * Usage:
+ *   BatchEval --scene scene.hgs|scene.jsonl [--updates updates.csv]
+ *             [--output results.csv|results.bin]
+ *
+ * Every line of updates is "id,x,y" or "id,x,y,z": id of a free point and
+ * its new homogeneous coordinates (z is 1 if it is omitted). Id of an object
+ * is the id of its record in JSON Lines and its index among constructions in
+ * files written by SceneFile. Empty lines and lines starting with '#' are
+ * skipped. Updates are read from stdin if --updates is missing or "-".
+ *
+ * After every update dependent objects, whose equation has changed, are
+ * written in order of their creation:
+ * - CSV (stdout if --output is missing): "update,id,re,im,re,im,..." with
+ *   three coefficients of a point or a line and six of a conic;
+ * - binary (.bin extension): ResultHeader followed by pairs of
+ *   little-endian doubles, so ids of dependent objects must be integers.
+ * Update is numbered by its position among good updates, starting from 0.
+ *
+ * Throughput is printed to stderr. Exit code is 1 if some updates are bad,
+ * they are skipped and reported. Update is bad if it can't be parsed, if
+ * the object isn't a free point, or if the new coordinates are (0:0:0) or
+ * coincide with the other point of a line through the point.
+ */
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "GeometricObject.h"
+#include "JsonLines.h"
+#include "ObjectConstruction.h"
+#include "PlaneImplementation.h"
+#include "SceneFile.h"
+
+namespace
+{
+/**
+ * \brief Options of the tool.
+ */
+struct Options
+{
+  std::string scene;          //!< Path to the scene.
+  std::string updates = "-";  //!< Path to the updates, "-" is stdin.
+  std::string output;         //!< Path to the results, empty is stdout.
+};
+
+/**
+ * \brief Header of an object in binary results.
+ */
+struct ResultHeader
+{
+  std::uint64_t update;  //!< Number of the update.
+  std::uint32_t id;      //!< Id of the object.
+  std::uint32_t size;    //!< Amount of complex numbers after the header.
+};
+
+static_assert(sizeof(ResultHeader) == 16);
+
+constexpr size_t kMaxErrors = 100;  //!< Only first bad updates are printed.
+
+/**
+ * \brief Parses command line.
+ *
+ * \param argc Amount of arguments.
+ * \param argv Arguments.
+ *
+ * \return Options or std::nullopt if command line is invalid.
+ */
+std::optional<Options> ParseOptions(const int argc, char** argv)
+{
+  Options options;
+
+  for (int argument = 1; argument < argc; ++argument)
+  {
+    const std::string key = argv[argument];
+
+    // Every option has a value
+    if (argument + 1 >= argc) return std::nullopt;
+    const std::string value = argv[++argument];
+
+    if (key == "--scene")
+      options.scene = value;
+    else if (key == "--updates")
+      options.updates = value;
+    else if (key == "--output")
+      options.output = value;
+    else
+      return std::nullopt;
+  }
+
+  if (options.scene.empty()) return std::nullopt;
+
+  return options;
+}
+
+/**
+ * \brief Loads scene from a binary file or from JSON Lines.
+ *
+ * \param path Path to the file.
+ * \param plane Plane to add objects to.
+ * \param ids Ids of objects by their indices among constructions.
+ *
+ * \return True if the file is read, bad lines of JSON Lines are only
+ * reported.
+ */
+bool LoadScene(const std::string& path, HomoGebra::PlaneImplementation& plane,
+               std::vector<std::string>& ids)
+{
+  const auto& constructions = plane.GetConstructions();
+
+  // Binary file is written in order of constructions
+  if (!path.ends_with(".jsonl"))
+  {
+    if (!HomoGebra::SceneFile::Load(path, plane)) return false;
+
+    ids.clear();
+    for (size_t index = 0; index < constructions.size(); ++index)
+    {
+      ids.push_back(std::to_string(index));
+    }
+    return true;
+  }
+
+  std::ifstream input(path);
+  if (!input) return false;
+
+  const auto report = HomoGebra::JsonLines::Import(input, plane);
+
+  // Records are created in order their references are resolved
+  std::unordered_map<const HomoGebra::GeometricObject*, size_t> indices;
+  for (size_t index = 0; index < constructions.size(); ++index)
+  {
+    indices.emplace(constructions[index]->GetObject(), index);
+  }
+  ids.assign(constructions.size(), {});
+  for (const auto& [id, object] : report.objects)
+  {
+    ids[indices.at(object)] = id;
+  }
+
+  for (const auto& [line, message] : report.errors)
+  {
+    std::cerr << path << ':' << line << ": " << message << '\n';
+  }
+  if (report.failed > report.errors.size())
+  {
+    std::cerr << report.failed - report.errors.size() << " more errors\n";
+  }
+
+  return true;
+}
+
+/**
+ * \brief Remembers that equation of an object has changed.
+ *
+ * \details Dependent objects are recalculated by their constructions, when
+ * a parent moves, so recorder only collects them.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+class ChangeRecorder final : public HomoGebra::GeometricObjectObserver
+{
+ public:
+  /**
+   * \brief Constructs recorder of an object.
+   *
+   * \param index Index of the object among constructions.
+   * \param object Object to observe.
+   * \param changed Indices of changed objects, recorder adds its index once.
+   */
+  ChangeRecorder(const std::uint32_t index, HomoGebra::GeometricObject* object,
+                 std::vector<std::uint32_t>& changed)
+      : index_(index), object_(object), changed_(&changed)
+  {}
+
+  void Update(const HomoGebra::ObjectEvent::Moved&) override
+  {
+    if (is_changed_) return;
+
+    is_changed_ = true;
+    changed_->push_back(index_);
+  }
+
+  void Update(const HomoGebra::ObjectEvent::GoingToBeDestroyed&) override {}
+
+  void Update(const HomoGebra::ObjectEvent::Renamed&) override {}
+
+  /**
+   * \brief Allows to record the object again.
+   */
+  void Reset() { is_changed_ = false; }
+
+  /**
+   * \brief Gets observed object.
+   *
+   * \return Object.
+   */
+  [[nodiscard]] const HomoGebra::GeometricObject* GetObject() const
+  {
+    return object_;
+  }
+
+ private:
+  /**
+   * Member data.
+   */
+  std::uint32_t index_;                  //!< Index of the object.
+  HomoGebra::GeometricObject* object_;   //!< Observed object.
+  std::vector<std::uint32_t>* changed_;  //!< Indices of changed objects.
+  bool is_changed_ = false;              //!< Is index already recorded?
+};
+
+/**
+ * \brief Gets coefficients of an equation of an object.
+ *
+ * \param object Object.
+ * \param coefficients Array to write coefficients to.
+ *
+ * \return Amount of coefficients.
+ */
+size_t GetCoefficients(const HomoGebra::GeometricObject* object,
+                       std::array<HomoGebra::Complex, 6>& coefficients)
+{
+  auto copy = [&coefficients](const HomoGebra::HomogeneousCoordinate& equation)
+  {
+    coefficients[0] = equation.x;
+    coefficients[1] = equation.y;
+    coefficients[2] = equation.z;
+    return size_t{3};
+  };
+
+  if (const auto* point = dynamic_cast<const HomoGebra::Point*>(object))
+  {
+    return copy(point->GetEquation().GetEquation());
+  }
+  if (const auto* line = dynamic_cast<const HomoGebra::Line*>(object))
+  {
+    return copy(line->GetEquation().equation);
+  }
+  if (const auto* conic = dynamic_cast<const HomoGebra::Conic*>(object))
+  {
+    const auto& equation = conic->GetEquation();
+    std::ranges::copy(equation.squares, coefficients.begin());
+    std::ranges::copy(equation.pair_products, coefficients.begin() + 3);
+    return size_t{6};
+  }
+
+  return 0;
+}
+
+/**
+ * \brief Writes changed equations as CSV or binary records.
+ *
+ * \details Text is collected in a buffer and written in large blocks.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+class ResultWriter
+{
+ public:
+  /**
+   * \brief Constructs writer.
+   *
+   * \param output Stream to write to.
+   * \param is_binary Write binary records instead of CSV.
+   */
+  ResultWriter(std::ostream& output, const bool is_binary)
+      : output_(output), is_binary_(is_binary)
+  {}
+
+  /**
+   * \brief Writes the rest of the buffer.
+   */
+  ~ResultWriter() { Flush(); }
+
+  ResultWriter(const ResultWriter&) = delete;
+  ResultWriter& operator=(const ResultWriter&) = delete;
+
+  /**
+   * \brief Writes equation of an object.
+   *
+   * \param update Number of the update.
+   * \param id Id of the object, it must be an integer for binary records.
+   * \param coefficients Coefficients of the equation.
+   */
+  void Write(const std::uint64_t update, const std::string_view id,
+             const std::span<const HomoGebra::Complex> coefficients)
+  {
+    if (is_binary_)
+    {
+      std::uint32_t number{};
+      std::from_chars(id.data(), id.data() + id.size(), number);
+
+      const ResultHeader header{
+          update, number, static_cast<std::uint32_t>(coefficients.size())};
+      Append(std::as_bytes(std::span{&header, 1}));
+      for (const auto& coefficient : coefficients)
+      {
+        const std::array<double, 2> packed{
+            static_cast<double>(coefficient.real()),
+            static_cast<double>(coefficient.imag())};
+        Append(std::as_bytes(std::span{packed}));
+      }
+    }
+    else
+    {
+      AppendNumber(update);
+      buffer_ += id;
+      buffer_ += ',';
+      for (const auto& coefficient : coefficients)
+      {
+        AppendNumber(static_cast<double>(coefficient.real()));
+        AppendNumber(static_cast<double>(coefficient.imag()));
+      }
+      buffer_.back() = '\n';
+    }
+
+    if (buffer_.size() >= kBufferSize) Flush();
+  }
+
+  /**
+   * \brief Writes buffer to the stream.
+   */
+  void Flush()
+  {
+    output_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+  }
+
+ private:
+  /**
+   * \brief Appends bytes to the buffer.
+   *
+   * \param bytes Bytes to append.
+   */
+  void Append(const std::span<const std::byte> bytes)
+  {
+    const auto* begin = reinterpret_cast<const char*>(bytes.data());
+    buffer_.append(begin, bytes.size());
+  }
+
+  /**
+   * \brief Appends number and a comma to the buffer.
+   *
+   * \param number Number to append.
+   */
+  template <class Number>
+  void AppendNumber(const Number number)
+  {
+    std::array<char, 32> text;
+    const auto end = std::to_chars(text.data(), text.data() + text.size(),
+                                   number)
+                         .ptr;
+    buffer_.append(text.data(), end);
+    buffer_ += ',';
+  }
+
+  static constexpr size_t kBufferSize = 1 << 16;  //!< Size of a block.
+
+  /**
+   * Member data.
+   */
+  std::ostream& output_;  //!< Stream to write to.
+  bool is_binary_;        //!< Write binary records?
+  std::string buffer_;    //!< Data, which isn't written yet.
+};
+
+/**
+ * \brief Move of a free point.
+ */
+struct PointUpdate
+{
+  std::string id;                               //!< Id of the point.
+  HomoGebra::HomogeneousCoordinate coordinate;  //!< New coordinates.
+};
+
+/**
+ * \brief Parses a line of updates.
+ *
+ * \param text Line to parse.
+ * \param update Parsed update.
+ *
+ * \return Error message, empty if the line is parsed.
+ */
+std::string ParseUpdate(std::string_view text, PointUpdate& update)
+{
+  auto skip_spaces = [&text]
+  {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+    {
+      text.remove_prefix(1);
+    }
+  };
+  auto parse = [&]<class Number>(Number& number)
+  {
+    skip_spaces();
+    const auto [end, error] =
+        std::from_chars(text.data(), text.data() + text.size(), number);
+    if (error != std::errc{}) return false;
+
+    text.remove_prefix(static_cast<size_t>(end - text.data()));
+    skip_spaces();
+    return true;
+  };
+
+  // Id is anything before the first comma
+  skip_spaces();
+  const auto comma = std::min(text.find(','), text.size());
+  const auto id_end = text.find_last_not_of(" \t", comma - 1);
+  if (comma == 0 || id_end == std::string_view::npos) return "expected id";
+  update.id = text.substr(0, id_end + 1);
+  text.remove_prefix(comma);
+
+  std::array<double, 3> coordinates{0., 0., 1.};
+  size_t amount = 0;
+  while (!text.empty() && text.front() == ',' && amount < coordinates.size())
+  {
+    text.remove_prefix(1);
+    if (!parse(coordinates[amount])) return "expected number";
+    ++amount;
+  }
+
+  if (!text.empty() && text.front() != '\r') return "unexpected characters";
+  if (amount < 2) return "expected x and y";
+
+  update.coordinate = HomoGebra::HomogeneousCoordinate{
+      HomoGebra::Complex{coordinates[0]}, HomoGebra::Complex{coordinates[1]},
+      HomoGebra::Complex{coordinates[2]}};
+  return {};
+}
+}  // namespace
+
+int main(const int argc, char** argv)
+{
+  const auto options = ParseOptions(argc, argv);
+  if (!options)
+  {
+    std::cerr << "Usage: BatchEval --scene scene.hgs|scene.jsonl "
+                 "[--updates updates.csv] "
+                 "[--output results.csv|results.bin]\n";
+    return 2;
+  }
+
+  std::ios::sync_with_stdio(false);
+
+  // Recorders are destroyed after the plane, which notifies them
+  std::vector<ChangeRecorder> recorders;
+
+  HomoGebra::PlaneImplementation plane;
+  std::vector<std::string> ids;
+  if (!LoadScene(options->scene, plane, ids))
+  {
+    std::cerr << "Couldn't read " << options->scene << '\n';
+    return 2;
+  }
+
+  std::ifstream updates_file;
+  if (options->updates != "-")
+  {
+    updates_file.open(options->updates);
+    if (!updates_file)
+    {
+      std::cerr << "Couldn't read " << options->updates << '\n';
+      return 2;
+    }
+  }
+  std::istream& updates = options->updates != "-" ? updates_file : std::cin;
+
+  std::ofstream output_file;
+  if (!options->output.empty())
+  {
+    output_file.open(options->output, std::ios::binary);
+    if (!output_file)
+    {
+      std::cerr << "Couldn't write " << options->output << '\n';
+      return 2;
+    }
+  }
+  std::ostream& output = !options->output.empty() ? output_file : std::cout;
+
+  // Free points can be moved, dependent objects are observed
+  const auto is_binary = options->output.ends_with(".bin");
+  const auto& constructions = plane.GetConstructions();
+  std::unordered_map<std::string_view, HomoGebra::PointOnPlane*> free_points;
+  std::vector<ChangeRecorder*> recorder_by_index(constructions.size());
+  std::vector<std::uint32_t> changed;
+  recorders.reserve(constructions.size());
+  for (std::uint32_t index = 0; index < constructions.size(); ++index)
+  {
+    auto* construction = constructions[index].get();
+    if (auto* point = dynamic_cast<HomoGebra::PointOnPlane*>(construction))
+    {
+      free_points.emplace(ids[index], point);
+    }
+    else if (!dynamic_cast<const HomoGebra::LineOnPlane*>(construction) &&
+             !dynamic_cast<const HomoGebra::ConicOnPlane*>(construction))
+    {
+      // Binary records have integer ids
+      const auto& id = ids[index];
+      std::uint32_t number{};
+      const auto [end, error] =
+          std::from_chars(id.data(), id.data() + id.size(), number);
+      if (is_binary && (error != std::errc{} || end != id.data() + id.size()))
+      {
+        std::cerr << "Id '" << id << "' isn't an integer, use CSV output\n";
+        return 2;
+      }
+
+      auto& recorder =
+          recorders.emplace_back(index, construction->GetObject(), changed);
+      construction->GetObject()->Attach(&recorder);
+      recorder_by_index[index] = &recorder;
+    }
+  }
+
+  ResultWriter writer(output, is_binary);
+
+  std::uint64_t applied = 0;
+  size_t bad = 0;
+  size_t equations = 0;
+  std::chrono::steady_clock::duration recalculation{};
+  const auto start = std::chrono::steady_clock::now();
+
+  std::string text;
+  PointUpdate update{};
+  std::array<HomoGebra::Complex, 6> coefficients;
+  for (size_t line = 1; std::getline(updates, text); ++line)
+  {
+    if (text.empty() || text.front() == '#' || text == "\r") continue;
+
+    auto error = ParseUpdate(text, update);
+    const auto found = free_points.find(update.id);
+    if (error.empty() && found == free_points.end())
+    {
+      error = "'" + update.id + "' isn't a free point";
+    }
+
+    // Lines through the point must stay defined
+    const HomoGebra::PointEquation equation{update.coordinate};
+    if (error.empty() && !found->second->CanMove(equation))
+    {
+      error = "point would be (0:0:0) or coincide with another point of its "
+              "line";
+    }
+    if (!error.empty())
+    {
+      if (bad++ < kMaxErrors)
+      {
+        std::cerr << options->updates << ':' << line << ": " << error << '\n';
+      }
+      continue;
+    }
+
+    // Constructions recalculate only dependents of the point
+    const auto recalculation_start = std::chrono::steady_clock::now();
+    found->second->Move(equation);
+    recalculation += std::chrono::steady_clock::now() - recalculation_start;
+
+    std::ranges::sort(changed);
+    for (const auto index : changed)
+    {
+      auto& recorder = *recorder_by_index[index];
+      recorder.Reset();
+
+      const auto size = GetCoefficients(recorder.GetObject(), coefficients);
+      writer.Write(applied, ids[index], std::span{coefficients}.first(size));
+    }
+    equations += changed.size();
+    changed.clear();
+
+    ++applied;
+  }
+  writer.Flush();
+
+  const auto finish = std::chrono::steady_clock::now();
+
+  if (bad > kMaxErrors) std::cerr << bad - kMaxErrors << " more errors\n";
+
+  auto seconds = [](const std::chrono::steady_clock::duration duration)
+  { return std::chrono::duration<double>(duration).count(); };
+  auto per_second = [&](const std::chrono::steady_clock::duration duration)
+  {
+    return seconds(duration) > 0.
+               ? static_cast<double>(applied) / seconds(duration)
+               : 0.;
+  };
+
+  std::cerr << "objects: " << constructions.size()
+            << ", updates: " << applied << ", bad: " << bad
+            << ", equations: " << equations << '\n'
+            << "total: " << seconds(finish - start) << " s, "
+            << per_second(finish - start) << " updates/s\n"
+            << "recalculation: " << seconds(recalculation) << " s, "
+            << per_second(recalculation) << " updates/s\n";
+
+  if (!output)
+  {
+    std::cerr << "Couldn't write results\n";
+    return 2;
+  }
+
+  return bad > 0 ? 1 : 0;
+}
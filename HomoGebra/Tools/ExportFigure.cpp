@@ -0,0 +1,243 @@
+/*
+ * Exports scenes as vector figures. The tool uses only the core library, so
+ * it doesn't need graphics.
+ *
+ * Usage:
+ *   ExportFigure (--scene scene.hgs|scene.jsonl --output figure.svg|figure.pdf
+ *                 | --batch list.txt)
+ *                [--viewport left,top,right,bottom] [--width W]
+ *
+ * Every line of the batch list is "scene figure", a pair of paths separated
+ * by spaces. Empty lines and lines starting with '#' are skipped. Format of
+ * a figure is chosen by its extension, PDF for ".pdf" and SVG otherwise.
+ * Viewport is a part of the plane in its coordinates, the default one is
+ * the initial view of the application.
+ *
+ * Exit code is 1 if some figures aren't exported, they are reported.
+ */
+#include <array>
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "Construction.h"
+#include "JsonLines.h"
+#include "PlaneImplementation.h"
+#include "SceneFile.h"
+#include "VectorExport.h"
+
+namespace
+{
+/**
+ * \brief Options of the tool.
+ */
+struct Options
+{
+  std::string scene;   //!< Path to the scene.
+  std::string output;  //!< Path to the figure.
+  std::string batch;   //!< Path to the list of scenes and figures.
+  HomoGebra::VectorExport::Options figure;  //!< Options of figures.
+};
+
+/**
+ * \brief Parses viewport "left,top,right,bottom".
+ *
+ * \param text Text to parse.
+ * \param viewport Viewport to write to.
+ *
+ * \return True if text is a non-empty viewport.
+ */
+bool ParseViewport(const std::string_view text,
+                   HomoGebra::Clipping::Bounds& viewport)
+{
+  std::array<float, 4> values{};
+  const auto* position = text.data();
+  const auto* end = text.data() + text.size();
+  for (size_t index = 0; index < values.size(); ++index)
+  {
+    if (index > 0)
+    {
+      if (position == end || *position != ',') return false;
+      ++position;
+    }
+
+    const auto [next, error] = std::from_chars(position, end, values[index]);
+    if (error != std::errc{}) return false;
+    position = next;
+  }
+  if (position != end) return false;
+
+  viewport = {values[0], values[1], values[2], values[3]};
+  return viewport.right > viewport.left && viewport.bottom > viewport.top;
+}
+
+/**
+ * \brief Parses command line.
+ *
+ * \param argc Amount of arguments.
+ * \param argv Arguments.
+ *
+ * \return Options or std::nullopt if command line is invalid.
+ */
+std::optional<Options> ParseOptions(const int argc, char** argv)
+{
+  Options options;
+
+  for (int argument = 1; argument < argc; ++argument)
+  {
+    const std::string key = argv[argument];
+
+    // Every option has a value
+    if (argument + 1 >= argc) return std::nullopt;
+    const std::string value = argv[++argument];
+
+    try
+    {
+      if (key == "--scene")
+        options.scene = value;
+      else if (key == "--output")
+        options.output = value;
+      else if (key == "--batch")
+        options.batch = value;
+      else if (key == "--viewport")
+      {
+        if (!ParseViewport(value, options.figure.viewport))
+          return std::nullopt;
+      }
+      else if (key == "--width")
+        options.figure.width = std::stof(value);
+      else
+        return std::nullopt;
+    }
+    catch (const std::exception&)
+    {
+      return std::nullopt;
+    }
+  }
+
+  if (!(options.figure.width > 0.f)) return std::nullopt;
+
+  // Either one scene or a batch
+  const auto is_single = !options.scene.empty() && !options.output.empty();
+  const auto is_batch = !options.batch.empty() && options.scene.empty() &&
+                        options.output.empty();
+  if (!is_single && !is_batch) return std::nullopt;
+
+  return options;
+}
+
+/**
+ * \brief Loads scene from a binary file or from JSON Lines.
+ *
+ * \param path Path to the file.
+ * \param plane Plane to add objects to.
+ *
+ * \return True if the file is read, bad lines of JSON Lines are only
+ * reported.
+ */
+bool LoadScene(const std::string& path, HomoGebra::PlaneImplementation& plane)
+{
+  if (!path.ends_with(".jsonl")) return HomoGebra::SceneFile::Load(path, plane);
+
+  std::ifstream input(path);
+  if (!input) return false;
+
+  const auto report = HomoGebra::JsonLines::Import(input, plane);
+  for (const auto& [line, message] : report.errors)
+  {
+    std::cerr << path << ':' << line << ": " << message << '\n';
+  }
+
+  return true;
+}
+
+/**
+ * \brief Exports one scene.
+ *
+ * \param scene Path to the scene.
+ * \param output Path to the figure.
+ * \param options Options of the figure, format is chosen by the path.
+ *
+ * \return True if the figure is written.
+ */
+bool ExportScene(const std::string& scene, const std::string& output,
+                 HomoGebra::VectorExport::Options options)
+{
+  HomoGebra::PlaneImplementation plane;
+  if (!LoadScene(scene, plane))
+  {
+    std::cerr << "Couldn't read " << scene << '\n';
+    return false;
+  }
+
+  options.format = output.ends_with(".pdf")
+                       ? HomoGebra::VectorExport::Format::kPdf
+                       : HomoGebra::VectorExport::Format::kSvg;
+
+  std::ofstream figure(output, std::ios::binary);
+  if (!figure || !HomoGebra::VectorExport::Export(plane, options, figure))
+  {
+    std::cerr << "Couldn't write " << output << '\n';
+    return false;
+  }
+
+  return true;
+}
+}  // namespace
+
+int main(const int argc, char** argv)
+{
+  const auto options = ParseOptions(argc, argv);
+  if (!options)
+  {
+    std::cerr << "Usage: ExportFigure (--scene scene.hgs|scene.jsonl "
+                 "--output figure.svg|figure.pdf | --batch list.txt) "
+                 "[--viewport left,top,right,bottom] [--width W]\n";
+    return 2;
+  }
+
+  if (options->batch.empty())
+  {
+    return ExportScene(options->scene, options->output, options->figure) ? 0
+                                                                         : 1;
+  }
+
+  std::ifstream batch(options->batch);
+  if (!batch)
+  {
+    std::cerr << "Couldn't read " << options->batch << '\n';
+    return 2;
+  }
+
+  size_t exported = 0;
+  size_t failed = 0;
+
+  std::string text;
+  for (size_t line = 1; std::getline(batch, text); ++line)
+  {
+    if (text.empty() || text.front() == '#' || text == "\r") continue;
+
+    std::istringstream fields(text);
+    std::string scene;
+    std::string output;
+    if (!(fields >> scene >> output))
+    {
+      std::cerr << options->batch << ':' << line << ": expected two paths\n";
+      ++failed;
+      continue;
+    }
+
+    if (ExportScene(scene, output, options->figure))
+      ++exported;
+    else
+      ++failed;
+  }
+
+  std::cerr << "exported: " << exported << ", failed: " << failed << '\n';
+
+  return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * Generates a random scene for stress tests and benchmarks. The tool uses
+ * only the core library, so it doesn't need graphics.
+ *
+ * Usage:
+ *   GenerateScene --output scene.hgs|scene.jsonl [--seed S]
+ *                 [--points N] [--lines N] [--conics N] [--fan-out F]
+ *                 [--degenerate D] [--extent E]
+ *
+ * The same options give the same scene on every platform. Fan-out limits
+ * amount of lines through a point, 0 means no limit. Degenerate is a share
+ * in [0, 1] of points, which coincide with earlier ones, and of lines, which
+ * are parallel to earlier ones. Files with .jsonl extension are JSON Lines,
+ * others are binary scene files.
+ *
+ * What is generated is printed to stderr.
+ */
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+
+#include "Construction.h"
+#include "JsonLines.h"
+#include "PlaneImplementation.h"
+#include "SceneFile.h"
+#include "SceneGenerator.h"
+
+namespace
+{
+/**
+ * \brief Options of the tool.
+ */
+struct Options
+{
+  std::string output;                        //!< Path to the scene.
+  HomoGebra::SceneGenerator::Options scene;  //!< Options of the scene.
+};
+
+/**
+ * \brief Parses command line.
+ *
+ * \param argc Amount of arguments.
+ * \param argv Arguments.
+ *
+ * \return Options or std::nullopt if command line is invalid.
+ */
+std::optional<Options> ParseOptions(const int argc, char** argv)
+{
+  Options options;
+  auto& scene = options.scene;
+
+  for (int argument = 1; argument < argc; ++argument)
+  {
+    const std::string key = argv[argument];
+
+    // Every option has a value
+    if (argument + 1 >= argc) return std::nullopt;
+    const std::string value = argv[++argument];
+
+    try
+    {
+      if (key == "--output")
+        options.output = value;
+      else if (key == "--seed")
+        scene.seed = static_cast<unsigned>(std::stoul(value));
+      else if (key == "--points")
+        scene.points = std::stoul(value);
+      else if (key == "--lines")
+        scene.lines = std::stoul(value);
+      else if (key == "--conics")
+        scene.conics = std::stoul(value);
+      else if (key == "--fan-out")
+        scene.fan_out = std::stoul(value);
+      else if (key == "--degenerate")
+        scene.degenerate = std::stof(value);
+      else if (key == "--extent")
+        scene.extent = std::stof(value);
+      else
+        return std::nullopt;
+    }
+    catch (const std::exception&)
+    {
+      return std::nullopt;
+    }
+  }
+
+  if (options.output.empty()) return std::nullopt;
+  if (!(scene.degenerate >= 0.f && scene.degenerate <= 1.f))
+    return std::nullopt;
+  if (!(scene.extent > 0.f)) return std::nullopt;
+
+  return options;
+}
+
+/**
+ * \brief Writes scene to a binary file or to JSON Lines.
+ *
+ * \param plane Plane to write.
+ * \param path Path to the file.
+ *
+ * \return True if the file is written.
+ */
+bool SaveScene(const HomoGebra::PlaneImplementation& plane,
+               const std::string& path)
+{
+  if (!path.ends_with(".jsonl")) return HomoGebra::SceneFile::Save(plane, path);
+
+  std::ofstream output(path);
+  return output && HomoGebra::JsonLines::Export(plane, output);
+}
+}  // namespace
+
+int main(const int argc, char** argv)
+{
+  const auto options = ParseOptions(argc, argv);
+  if (!options)
+  {
+    std::cerr << "Usage: GenerateScene --output scene.hgs|scene.jsonl "
+                 "[--seed S] [--points N] [--lines N] [--conics N] "
+                 "[--fan-out F] [--degenerate D] [--extent E]\n";
+    return 2;
+  }
+
+  HomoGebra::PlaneImplementation plane;
+  const auto report =
+      HomoGebra::SceneGenerator::Generate(plane, options->scene);
+
+  if (!SaveScene(plane, options->output))
+  {
+    std::cerr << "Couldn't write " << options->output << '\n';
+    return 1;
+  }
+
+  std::cerr << "points: " << report.points << ", lines: " << report.lines
+            << ", conics: " << report.conics
+            << ", coincident points: " << report.coincident_points
+            << ", parallel lines: " << report.parallel_lines
+            << ", max fan-out: " << report.max_fan_out << '\n';
+  return 0;
+}
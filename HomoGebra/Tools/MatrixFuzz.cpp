@@ -0,0 +1,1179 @@
+/*
+ * Checks SquaredMatrix and Transformation on random and adversarial inputs.
+ * The tool uses only the core library, so it doesn't need graphics.
+ *
+ * Usage:
+ *   MatrixFuzz [--seed S] [--cases N] [--corpus directory]
+ *              [--tolerance T] [--slowdown F]
+ *
+ * Every case is a matrix of size from 2 to 12 or four pairs of points:
+ * - random: matrix P * L * U with a known determinant;
+ * - scaled: random matrix multiplied by 10^k, |k| <= 12;
+ * - permuted: permutation with phases on entries;
+ * - near-singular: random matrix with a pivot 10^k, -14 <= k <= -4;
+ * - singular: random matrix with a row, which is a sum of two others;
+ * - homography: points in general position and their images by a random
+ *   matrix, all with random homogeneous factors;
+ * - far: the same, scaled by 10^k, |k| <= 6, with a point at infinity;
+ * - near-collinear: the same, but a preimage is 10^k off a line through
+ *   two others, -14 <= k <= -3.
+ *
+ * Invariants are:
+ * - A * A^-1 = I and A * x = b up to the norms of A and A^-1;
+ * - determinant is the known one, det(A) * det(A^-1) = 1 and 3x3
+ *   determinants of SquaredMatrix and TransformationMatrix agree;
+ * - matrices, which are regular by construction, are inverted, and
+ *   singular ones are not;
+ * - fit maps preimages to images and its inverse maps them back.
+ * Near-singular and near-collinear cases have no right answer, so errors
+ * there are reported, but they don't break invariants.
+ *
+ * Case is flagged if an invariant is broken, if its error is over the
+ * tolerance (1e-8 by default) or if a call is slower than F (20 by default)
+ * medians of calls of its kind and size. Flagged cases are written to the
+ * corpus, which is checked before new cases, so the corpus keeps
+ * regressions.
+ *
+ * Exit code is 1 if some invariant is broken.
+ */
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <numbers>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Coordinate.h"
+#include "Equation.h"
+#include "Matrix.h"
+
+namespace
+{
+using HomoGebra::Complex;
+using HomoGebra::ComplexSquaredMatrix;
+using HomoGebra::HomogeneousCoordinate;
+using HomoGebra::PointEquation;
+using HomoGebra::Transformation;
+using HomoGebra::TransformationMatrix;
+
+using Matrix = ComplexSquaredMatrix::Matrix;
+using Row = ComplexSquaredMatrix::Row;
+
+/**
+ * \brief Options of the tool.
+ */
+struct Options
+{
+  unsigned seed = 0;              //!< Seed of new cases.
+  size_t cases = 2000;            //!< Amount of new cases.
+  std::string corpus;             //!< Directory of the corpus, empty if none.
+  long double tolerance = 1e-8L;  //!< Largest relative error.
+  double slowdown = 20.;          //!< Slowdown over the median of a call.
+};
+
+/**
+ * \brief Kind of a case.
+ */
+enum class Kind
+{
+  kRandom,
+  kScaled,
+  kPermuted,
+  kNearSingular,
+  kSingular,
+  kHomography,
+  kFar,
+  kNearCollinear,
+  kCount
+};
+
+/**
+ * \brief Names of kinds in reports and in the corpus.
+ */
+constexpr std::array<const char*, static_cast<size_t>(Kind::kCount)> kNames{
+    "random",   "scaled",     "permuted", "near-singular",
+    "singular", "homography", "far",      "near-collinear"};
+
+/**
+ * \brief Checks if a case is a matrix.
+ *
+ * \param kind Kind of the case.
+ *
+ * \return True for a matrix, false for points.
+ */
+bool IsMatrix(const Kind kind) { return kind < Kind::kHomography; }
+
+/**
+ * \brief Checks if a case has the right answer.
+ *
+ * \param kind Kind of the case.
+ *
+ * \return True if errors over the tolerance break invariants.
+ */
+bool IsWellPosed(const Kind kind)
+{
+  return kind != Kind::kNearSingular && kind != Kind::kNearCollinear;
+}
+
+/**
+ * \brief Matrix or four pairs of points.
+ */
+struct Case
+{
+  Kind kind{};         //!< Kind of the case.
+  std::string origin;  //!< Seed and index or file of the case.
+  bool is_saved{};     //!< Is it in the corpus?
+
+  Matrix matrix;                                //!< Matrix.
+  Complex determinant;                          //!< Known determinant.
+  Row augmentation;                             //!< Right side of equations.
+  std::array<HomogeneousCoordinate, 8> points;  //!< Preimages, then images.
+};
+
+/**
+ * \brief What is found on a case.
+ */
+struct Outcome
+{
+  std::string check;                                  //!< Worst check.
+  long double error = 0;                              //!< Its error.
+  std::string violation;                              //!< Broken invariant.
+  std::vector<std::pair<std::string, double>> calls;  //!< Calls and times.
+  std::string slow_call;                              //!< Slow call, if any.
+};
+
+/**
+ * \brief Source of random numbers, which are the same on every platform.
+ *
+ * \details Sequence of std::mt19937_64 is defined by the standard, unlike
+ * distributions, so numbers are mapped by hand.
+ */
+class Random
+{
+ public:
+  /**
+   * \brief Constructs source by seed.
+   *
+   * \param seed Seed.
+   */
+  explicit Random(const unsigned seed) : generator_(seed) {}
+
+  /**
+   * \brief Gets real number in [from, to).
+   *
+   * \param from Lower bound.
+   * \param to Upper bound.
+   *
+   * \return Number.
+   */
+  long double GetReal(const long double from, const long double to)
+  {
+    // 53 bits fill the mantissa of double
+    constexpr long double kScale = 1.L / static_cast<long double>(1ULL << 53);
+    return from + (to - from) * static_cast<long double>(generator_() >> 11) *
+                      kScale;
+  }
+
+  /**
+   * \brief Gets integer in [from, to].
+   *
+   * \param from Lower bound.
+   * \param to Upper bound.
+   *
+   * \return Integer.
+   */
+  int GetInteger(const int from, const int to)
+  {
+    const auto size = static_cast<std::uint64_t>(to - from + 1);
+    return from + static_cast<int>(((generator_() >> 32) * size) >> 32);
+  }
+
+  /**
+   * \brief Gets complex number with parts in [-1, 1).
+   *
+   * \return Number.
+   */
+  Complex GetComplex() { return Complex{GetReal(-1, 1), GetReal(-1, 1)}; }
+
+  /**
+   * \brief Gets complex number with absolute value in [from, to).
+   *
+   * \param from Lower bound of absolute value.
+   * \param to Upper bound of absolute value.
+   *
+   * \return Number.
+   */
+  Complex GetPolar(const long double from, const long double to)
+  {
+    const auto length = GetReal(from, to);
+    const auto angle = GetReal(0, 2 * std::numbers::pi_v<long double>);
+    return Complex{std::polar(length, angle)};
+  }
+
+ private:
+  /**
+   * Member data.
+   */
+  std::mt19937_64 generator_;  //!< Generator of bits.
+};
+
+/**
+ * \brief Finds the largest absolute value of elements.
+ *
+ * \param matrix Matrix.
+ *
+ * \return Norm.
+ */
+long double GetNorm(const Matrix& matrix)
+{
+  long double norm = 0;
+  for (const auto& row : matrix)
+  {
+    for (const auto& value : row)
+    {
+      norm = std::max(norm, std::abs(value));
+    }
+  }
+  return norm;
+}
+
+/**
+ * \brief Finds the product of lengths of rows, which bounds determinant.
+ *
+ * \param matrix Matrix.
+ *
+ * \return Bound of determinant.
+ */
+long double GetBound(const Matrix& matrix)
+{
+  long double bound = 1;
+  for (const auto& row : matrix)
+  {
+    long double length = 0;
+    for (const auto& value : row)
+    {
+      length += std::norm(value);
+    }
+    bound *= std::sqrt(length);
+  }
+  return bound;
+}
+
+/**
+ * \brief Finds relative distance between two numbers.
+ *
+ * \param value Number.
+ * \param expected Expected number, not zero.
+ *
+ * \return Distance divided by the expected number.
+ */
+long double GetDistance(const Complex& value, const Complex& expected)
+{
+  return std::abs(value - expected) / std::abs(expected);
+}
+
+/**
+ * \brief Finds how far two homogeneous coordinates are from proportional.
+ *
+ * \param first First coordinate.
+ * \param second Second coordinate.
+ *
+ * \return Sine of the angle between them, 1 if one of them is zero.
+ */
+long double GetSine(const HomogeneousCoordinate& first,
+                    const HomogeneousCoordinate& second)
+{
+  const std::array<Complex, 3> u{first.x, first.y, first.z};
+  const std::array<Complex, 3> v{second.x, second.y, second.z};
+
+  long double cross = 0;
+  long double u_length = 0;
+  long double v_length = 0;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    const auto j = (i + 1) % 3;
+    cross += std::norm(u[i] * v[j] - u[j] * v[i]);
+    u_length += std::norm(u[i]);
+    v_length += std::norm(v[i]);
+  }
+
+  if (u_length == 0 || v_length == 0) return 1;
+  return std::sqrt(cross / (u_length * v_length));
+}
+
+/**
+ * \brief Multiplies two matrices.
+ *
+ * \param first First matrix.
+ * \param second Second matrix.
+ *
+ * \return Product.
+ */
+Matrix Multiply(const Matrix& first, const Matrix& second)
+{
+  const auto size = first.size();
+  const ComplexSquaredMatrix left(first, Row(size));
+  const ComplexSquaredMatrix right(second, Row(size));
+  const auto product = left * right;
+  return Matrix(product.begin(), product.end());
+}
+
+/**
+ * \brief Makes matrix P * L * U, where L and U are triangular.
+ *
+ * \param random Source of random numbers.
+ * \param pivots Diagonal of U.
+ * \param determinant Determinant of the matrix.
+ *
+ * \return Matrix.
+ */
+Matrix MakeMatrix(Random& random, const Row& pivots, Complex& determinant)
+{
+  const auto size = pivots.size();
+
+  // Off-diagonal elements are small, so the matrix is well-conditioned
+  Matrix lower(size, Row(size));
+  Matrix upper(size, Row(size));
+  for (size_t row = 0; row < size; ++row)
+  {
+    lower[row][row] = Complex{1};
+    upper[row][row] = pivots[row];
+    for (size_t column = 0; column < row; ++column)
+    {
+      lower[row][column] = random.GetComplex() * Complex{0.5L};
+      upper[column][row] = random.GetComplex() * Complex{0.5L};
+    }
+  }
+
+  auto matrix = Multiply(lower, upper);
+
+  determinant = Complex{1};
+  for (const auto& pivot : pivots)
+  {
+    determinant *= pivot;
+  }
+
+  // Shuffle rows by swaps, each changes sign of determinant
+  for (size_t row = size - 1; row > 0; --row)
+  {
+    const auto other = static_cast<size_t>(
+        random.GetInteger(0, static_cast<int>(row)));
+    if (other == row) continue;
+
+    std::swap(matrix[row], matrix[other]);
+    determinant = -determinant;
+  }
+
+  return matrix;
+}
+
+/**
+ * \brief Gets random pivots, which are far from zero.
+ *
+ * \param random Source of random numbers.
+ * \param size Amount of pivots.
+ *
+ * \return Pivots.
+ */
+Row GetPivots(Random& random, const size_t size)
+{
+  Row pivots(size);
+  for (auto& pivot : pivots)
+  {
+    pivot = random.GetPolar(0.5L, 2.L);
+  }
+  return pivots;
+}
+
+/**
+ * \brief Makes a matrix case.
+ *
+ * \param random Source of random numbers.
+ * \param kind Kind of the case, it is a matrix.
+ * \param size Size of the matrix.
+ *
+ * \return Case.
+ */
+Case MakeMatrixCase(Random& random, const Kind kind, const size_t size)
+{
+  Case result;
+  result.kind = kind;
+
+  auto pivots = GetPivots(random, size);
+  if (kind == Kind::kNearSingular)
+  {
+    const auto exponent = random.GetInteger(-14, -4);
+    pivots[static_cast<size_t>(random.GetInteger(
+        0, static_cast<int>(size) - 1))] =
+        random.GetPolar(1, 2) * Complex{std::pow(10.L, exponent)};
+  }
+
+  if (kind == Kind::kPermuted)
+  {
+    // Permutation is P * I, so only phases are left of pivots
+    for (auto& pivot : pivots)
+    {
+      pivot /= Complex{std::abs(pivot)};
+    }
+
+    Matrix diagonal(size, Row(size));
+    Complex determinant{1};
+    for (size_t i = 0; i < size; ++i)
+    {
+      diagonal[i][i] = pivots[i];
+      determinant *= pivots[i];
+    }
+
+    result.matrix = diagonal;
+    for (size_t row = size - 1; row > 0; --row)
+    {
+      const auto other = static_cast<size_t>(
+          random.GetInteger(0, static_cast<int>(row)));
+      if (other == row) continue;
+
+      std::swap(result.matrix[row], result.matrix[other]);
+      determinant = -determinant;
+    }
+    result.determinant = determinant;
+  }
+  else
+  {
+    result.matrix = MakeMatrix(random, pivots, result.determinant);
+  }
+
+  if (kind == Kind::kScaled)
+  {
+    const auto factor = std::pow(10.L, random.GetInteger(-12, 12));
+    for (auto& row : result.matrix)
+    {
+      for (auto& value : row)
+      {
+        value *= Complex{factor};
+      }
+    }
+    result.determinant *=
+        Complex{std::pow(factor, static_cast<long double>(size))};
+  }
+
+  if (kind == Kind::kSingular)
+  {
+    // Row is a sum of two others with small integer factors
+    const auto target = static_cast<size_t>(
+        random.GetInteger(0, static_cast<int>(size) - 1));
+    const auto first = (target + 1) % size;
+    const auto second = (target + 2) % size;
+    const Complex first_factor{static_cast<long double>(
+        random.GetInteger(1, 3))};
+    const Complex second_factor{static_cast<long double>(
+        random.GetInteger(-3, -1))};
+    for (size_t column = 0; column < size; ++column)
+    {
+      result.matrix[target][column] =
+          result.matrix[first][column] * first_factor +
+          result.matrix[second][column] * second_factor;
+    }
+    result.determinant = Complex{0};
+  }
+
+  result.augmentation.resize(size);
+  for (auto& value : result.augmentation)
+  {
+    value = random.GetComplex();
+  }
+
+  return result;
+}
+
+/**
+ * \brief Applies matrix to a coordinate.
+ *
+ * \param matrix Matrix 3x3.
+ * \param coordinate Coordinate.
+ *
+ * \return Product.
+ */
+HomogeneousCoordinate Apply(const Matrix& matrix,
+                            const HomogeneousCoordinate& coordinate)
+{
+  return Transformation(TransformationMatrix(
+      matrix[0][0], matrix[0][1], matrix[0][2], matrix[1][0], matrix[1][1],
+      matrix[1][2], matrix[2][0], matrix[2][1], matrix[2][2]))(coordinate);
+}
+
+/**
+ * \brief Multiplies coordinate by a number.
+ *
+ * \param coordinate Coordinate.
+ * \param factor Number.
+ *
+ * \return Product, which is the same point.
+ */
+HomogeneousCoordinate Scale(const HomogeneousCoordinate& coordinate,
+                            const Complex& factor)
+{
+  return HomogeneousCoordinate{coordinate.x * factor, coordinate.y * factor,
+                               coordinate.z * factor};
+}
+
+/**
+ * \brief Makes a case of points.
+ *
+ * \param random Source of random numbers.
+ * \param kind Kind of the case, it is points.
+ *
+ * \return Case.
+ */
+Case MakePointCase(Random& random, const Kind kind)
+{
+  Case result;
+  result.kind = kind;
+
+  Complex determinant;
+  const auto homography = MakeMatrix(random, GetPivots(random, 3), determinant);
+
+  // Triangle of the first three preimages is large, so they aren't collinear
+  std::array<HomogeneousCoordinate, 4> preimages{
+      HomogeneousCoordinate{Complex{random.GetReal(-1, -0.5L)},
+                            Complex{random.GetReal(-1, -0.5L)}},
+      HomogeneousCoordinate{Complex{random.GetReal(0.5L, 1)},
+                            Complex{random.GetReal(-1, -0.5L)}},
+      HomogeneousCoordinate{Complex{random.GetReal(-0.25L, 0.25L)},
+                            Complex{random.GetReal(0.5L, 1)}},
+      HomogeneousCoordinate{Complex{random.GetReal(-0.1L, 0.1L)},
+                            Complex{random.GetReal(-0.1L, 0.1L)}}};
+
+  if (kind == Kind::kNearCollinear)
+  {
+    // Third preimage is moved to the middle of the first two and off by delta
+    const auto delta = std::pow(10.L, random.GetInteger(-14, -3));
+    const auto& first = preimages[0];
+    const auto& second = preimages[1];
+    const auto direction_x = second.x - first.x;
+    const auto direction_y = second.y - first.y;
+    const auto length = std::abs(direction_x);
+    preimages[2] = HomogeneousCoordinate{
+        (first.x + second.x) * Complex{0.5L} -
+            direction_y * Complex{delta / length},
+        (first.y + second.y) * Complex{0.5L} +
+            direction_x * Complex{delta / length}};
+  }
+
+  if (kind == Kind::kFar)
+  {
+    const auto factor = std::pow(10.L, random.GetInteger(-6, 6));
+    for (auto& preimage : preimages)
+    {
+      preimage.x *= Complex{factor};
+      preimage.y *= Complex{factor};
+    }
+
+    // The fourth preimage is inside of the triangle, so its direction is free
+    preimages[3].z = Complex{0};
+  }
+
+  for (size_t i = 0; i < preimages.size(); ++i)
+  {
+    result.points[i] = Scale(preimages[i], random.GetPolar(0.5L, 2));
+    result.points[i + 4] =
+        Scale(Apply(homography, preimages[i]), random.GetPolar(0.5L, 2));
+  }
+
+  return result;
+}
+
+/**
+ * \brief Makes a case.
+ *
+ * \param random Source of random numbers.
+ * \param index Index of the case.
+ * \param seed Seed of cases.
+ *
+ * \return Case.
+ */
+Case MakeCase(Random& random, const size_t index, const unsigned seed)
+{
+  const auto kind = static_cast<Kind>(
+      random.GetInteger(0, static_cast<int>(Kind::kCount) - 1));
+
+  auto result = IsMatrix(kind)
+                    ? MakeMatrixCase(random, kind,
+                                     static_cast<size_t>(random.GetInteger(
+                                         kind == Kind::kSingular ? 3 : 2, 12)))
+                    : MakePointCase(random, kind);
+
+  result.origin =
+      "seed " + std::to_string(seed) + ", case " + std::to_string(index);
+  return result;
+}
+
+/**
+ * \brief Calls function a few times.
+ *
+ * \param function Function to call.
+ * \param microseconds The fastest time of a call.
+ *
+ * \return Result of the function.
+ */
+template <class Function>
+auto Measure(const Function& function, double& microseconds)
+{
+  // The fastest of repeated calls, so preemption isn't counted
+  constexpr size_t kRepeats = 3;
+
+  std::optional<decltype(function())> result;
+  microseconds = std::numeric_limits<double>::infinity();
+  for (size_t repeat = 0; repeat < kRepeats; ++repeat)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    result.emplace(function());
+    const std::chrono::duration<double, std::micro> time =
+        std::chrono::steady_clock::now() - start;
+    microseconds = std::min(microseconds, time.count());
+  }
+
+  return std::move(*result);
+}
+
+/**
+ * \brief Remembers the error if it is the worst one.
+ *
+ * \param outcome Outcome of a case.
+ * \param check Name of the check.
+ * \param error Relative error.
+ */
+void Check(Outcome& outcome, const char* check, const long double error)
+{
+  // NaN is the worst
+  if (error <= outcome.error) return;
+
+  outcome.check = check;
+  outcome.error = error;
+}
+
+/**
+ * \brief Checks a matrix.
+ *
+ * \param test Case, which is a matrix.
+ *
+ * \return Outcome.
+ */
+Outcome CheckMatrix(const Case& test)
+{
+  Outcome outcome;
+  const auto size = test.matrix.size();
+  const auto suffix = "/" + std::to_string(size);
+  const ComplexSquaredMatrix matrix(test.matrix, test.augmentation);
+
+  double time{};
+  const auto inverse = Measure([&matrix] { return matrix.GetInverse(); }, time);
+  outcome.calls.emplace_back("inverse" + suffix, time);
+
+  const auto determinant =
+      Measure([&matrix] { return matrix.GetDeterminant(); }, time);
+  outcome.calls.emplace_back("determinant" + suffix, time);
+
+  const auto solution =
+      Measure([&matrix] { return matrix.GetSolution(); }, time);
+  outcome.calls.emplace_back("solution" + suffix, time);
+
+  if (test.kind == Kind::kSingular)
+  {
+    if (inverse) outcome.violation = "singular matrix is inverted";
+    Check(outcome, "determinant",
+          std::abs(determinant) / GetBound(test.matrix));
+    return outcome;
+  }
+
+  if (!inverse || !solution)
+  {
+    if (IsWellPosed(test.kind)) outcome.violation = "no inverse";
+    return outcome;
+  }
+
+  const Matrix inverse_matrix(inverse->begin(), inverse->end());
+  const auto norm = GetNorm(test.matrix);
+  const auto inverse_norm = GetNorm(inverse_matrix);
+  const auto condition = static_cast<long double>(size) * norm * inverse_norm;
+
+  // A * A^-1 = I
+  const auto product = Multiply(test.matrix, inverse_matrix);
+  long double residual = 0;
+  for (size_t row = 0; row < size; ++row)
+  {
+    for (size_t column = 0; column < size; ++column)
+    {
+      const Complex expected{row == column ? 1.L : 0.L};
+      residual = std::max(residual, std::abs(product[row][column] - expected));
+    }
+  }
+  Check(outcome, "A * A^-1 = I", residual / condition);
+
+  // A * x = b
+  const auto image = matrix * *solution;
+  long double solution_norm = 0;
+  long double right_norm = 0;
+  residual = 0;
+  for (size_t row = 0; row < size; ++row)
+  {
+    solution_norm = std::max(solution_norm, std::abs((*solution)[row]));
+    right_norm = std::max(right_norm, std::abs(test.augmentation[row]));
+    residual =
+        std::max(residual, std::abs(image[row] - test.augmentation[row]));
+  }
+  Check(outcome, "A * x = b",
+        residual / (static_cast<long double>(size) * norm * solution_norm +
+                    right_norm));
+
+  // Determinants
+  Check(outcome, "det(A)",
+        GetDistance(determinant, test.determinant) / condition);
+  Check(outcome, "det(A) * det(A^-1) = 1",
+        GetDistance(determinant * inverse->GetDeterminant(), Complex{1}) /
+            condition);
+
+  if (size == 3)
+  {
+    const TransformationMatrix transformation(
+        test.matrix[0][0], test.matrix[0][1], test.matrix[0][2],
+        test.matrix[1][0], test.matrix[1][1], test.matrix[1][2],
+        test.matrix[2][0], test.matrix[2][1], test.matrix[2][2]);
+    Check(outcome, "3x3 determinants agree",
+          std::abs(transformation.Determinant() - determinant) /
+              GetBound(test.matrix));
+  }
+
+  return outcome;
+}
+
+/**
+ * \brief Checks points.
+ *
+ * \param test Case, which is four pairs of points.
+ *
+ * \return Outcome.
+ */
+Outcome CheckPoints(const Case& test)
+{
+  Outcome outcome;
+
+  std::array<PointEquation, 8> points;
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    points[i] = PointEquation{test.points[i]};
+  }
+
+  double time{};
+  const auto transformation = Measure(
+      [&points]
+      {
+        return Transformation::Fit(points[0], points[1], points[2], points[3],
+                                   points[4], points[5], points[6], points[7]);
+      },
+      time);
+  outcome.calls.emplace_back("fit", time);
+
+  if (!transformation)
+  {
+    if (IsWellPosed(test.kind)) outcome.violation = "no fit";
+    return outcome;
+  }
+
+  const auto inverse =
+      Measure([&transformation] { return transformation->GetInverse(); }, time);
+  outcome.calls.emplace_back("fit inverse", time);
+
+  for (size_t i = 0; i < 4; ++i)
+  {
+    Check(outcome, "fit maps preimages",
+          GetSine((*transformation)(test.points[i]), test.points[i + 4]));
+    if (inverse)
+    {
+      Check(outcome, "inverse maps images",
+            GetSine((*inverse)(test.points[i + 4]), test.points[i]));
+    }
+  }
+
+  if (!inverse && IsWellPosed(test.kind))
+  {
+    outcome.violation = "fit isn't inverted";
+  }
+
+  return outcome;
+}
+
+/**
+ * \brief Writes a case to the corpus.
+ *
+ * \param test Case.
+ * \param path Path to the file.
+ *
+ * \return True if the file is written.
+ */
+bool Save(const Case& test, const std::filesystem::path& path)
+{
+  std::ofstream output(path);
+  output << std::hexfloat;
+
+  const auto write = [&output](const Complex& value)
+  { output << ' ' << value.real() << ' ' << value.imag(); };
+
+  output << "kind " << kNames[static_cast<size_t>(test.kind)] << '\n';
+  if (IsMatrix(test.kind))
+  {
+    output << "determinant";
+    write(test.determinant);
+    output << '\n';
+
+    for (const auto& row : test.matrix)
+    {
+      output << "row";
+      for (const auto& value : row) write(value);
+      output << '\n';
+    }
+
+    output << "augmentation";
+    for (const auto& value : test.augmentation) write(value);
+    output << '\n';
+  }
+  else
+  {
+    for (const auto& point : test.points)
+    {
+      output << "point";
+      write(point.x);
+      write(point.y);
+      write(point.z);
+      output << '\n';
+    }
+  }
+
+  return static_cast<bool>(output);
+}
+
+/**
+ * \brief Reads complex numbers till the end of a line.
+ *
+ * \param line Line without the first word.
+ *
+ * \return Numbers or std::nullopt if some isn't a number.
+ */
+std::optional<Row> ReadNumbers(std::istringstream& line)
+{
+  Row numbers;
+  std::string real;
+  std::string imag;
+  while (line >> real)
+  {
+    if (!(line >> imag)) return std::nullopt;
+
+    // Hexadecimal floats are read by strtold, unlike streams
+    char* real_end{};
+    char* imag_end{};
+    const auto real_value = std::strtold(real.c_str(), &real_end);
+    const auto imag_value = std::strtold(imag.c_str(), &imag_end);
+    if (*real_end != '\0' || *imag_end != '\0') return std::nullopt;
+
+    numbers.emplace_back(real_value, imag_value);
+  }
+  return numbers;
+}
+
+/**
+ * \brief Reads a case from the corpus.
+ *
+ * \param path Path to the file.
+ *
+ * \return Case or std::nullopt if the file is invalid.
+ */
+std::optional<Case> Load(const std::filesystem::path& path)
+{
+  std::ifstream input(path);
+  if (!input) return std::nullopt;
+
+  Case result;
+  result.origin = path.filename().string();
+  result.is_saved = true;
+
+  bool has_kind = false;
+  size_t points = 0;
+  std::string text;
+  while (std::getline(input, text))
+  {
+    std::istringstream line(text);
+    std::string key;
+    if (!(line >> key)) continue;
+
+    if (key == "kind")
+    {
+      std::string name;
+      line >> name;
+      const auto found = std::ranges::find(kNames, name);
+      if (found == kNames.end()) return std::nullopt;
+
+      result.kind = static_cast<Kind>(found - kNames.begin());
+      has_kind = true;
+      continue;
+    }
+
+    auto numbers = ReadNumbers(line);
+    if (!numbers) return std::nullopt;
+
+    if (key == "determinant" && numbers->size() == 1)
+      result.determinant = numbers->front();
+    else if (key == "row")
+      result.matrix.push_back(std::move(*numbers));
+    else if (key == "augmentation")
+      result.augmentation = std::move(*numbers);
+    else if (key == "point" && numbers->size() == 3 && points < 8)
+      result.points[points++] = HomogeneousCoordinate{
+          (*numbers)[0], (*numbers)[1], (*numbers)[2]};
+    else
+      return std::nullopt;
+  }
+
+  if (!has_kind) return std::nullopt;
+  if (!IsMatrix(result.kind))
+  {
+    if (points != 8) return std::nullopt;
+    return result;
+  }
+
+  // Matrix is squared and has augmentation
+  const auto size = result.matrix.size();
+  if (size == 0 || result.augmentation.size() != size) return std::nullopt;
+  if (std::ranges::any_of(result.matrix, [size](const Row& row)
+                          { return row.size() != size; }))
+    return std::nullopt;
+
+  return result;
+}
+
+/**
+ * \brief Reads all cases of the corpus.
+ *
+ * \param directory Directory of the corpus.
+ *
+ * \return Cases in order of names of files.
+ */
+std::vector<Case> LoadCorpus(const std::filesystem::path& directory)
+{
+  std::vector<std::filesystem::path> paths;
+  std::error_code error;
+  for (const auto& entry :
+       std::filesystem::directory_iterator(directory, error))
+  {
+    if (entry.is_regular_file() && entry.path().extension() == ".case")
+      paths.push_back(entry.path());
+  }
+  std::ranges::sort(paths);
+
+  std::vector<Case> cases;
+  for (const auto& path : paths)
+  {
+    auto test = Load(path);
+    if (!test)
+    {
+      std::cerr << "Skipped invalid " << path.string() << '\n';
+      continue;
+    }
+    cases.push_back(std::move(*test));
+  }
+  return cases;
+}
+
+/**
+ * \brief Parses command line.
+ *
+ * \param argc Amount of arguments.
+ * \param argv Arguments.
+ *
+ * \return Options or std::nullopt if command line is invalid.
+ */
+std::optional<Options> ParseOptions(const int argc, char** argv)
+{
+  Options options;
+
+  for (int argument = 1; argument < argc; ++argument)
+  {
+    const std::string key = argv[argument];
+
+    // Every option has a value
+    if (argument + 1 >= argc) return std::nullopt;
+    const std::string value = argv[++argument];
+
+    try
+    {
+      if (key == "--seed")
+        options.seed = static_cast<unsigned>(std::stoul(value));
+      else if (key == "--cases")
+        options.cases = std::stoul(value);
+      else if (key == "--corpus")
+        options.corpus = value;
+      else if (key == "--tolerance")
+        options.tolerance = std::stold(value);
+      else if (key == "--slowdown")
+        options.slowdown = std::stod(value);
+      else
+        return std::nullopt;
+    }
+    catch (const std::exception&)
+    {
+      return std::nullopt;
+    }
+  }
+
+  if (!(options.tolerance > 0) || !(options.slowdown > 1)) return std::nullopt;
+  return options;
+}
+
+/**
+ * \brief Flags calls, which are slower than medians of calls of their kind.
+ *
+ * \param outcomes Outcomes of all cases.
+ * \param slowdown Slowdown over the median, which is an outlier.
+ */
+void FlagSlowCalls(std::vector<Outcome>& outcomes, const double slowdown)
+{
+  // Calls of tiny matrices are faster than the clock, so they need a floor
+  constexpr double kFloor = 1.;  // microseconds
+
+  std::map<std::string, std::vector<double>> times;
+  for (const auto& outcome : outcomes)
+  {
+    for (const auto& [call, time] : outcome.calls) times[call].push_back(time);
+  }
+
+  std::map<std::string, double> medians;
+  for (auto& [call, values] : times)
+  {
+    const auto middle = values.begin() + values.size() / 2;
+    std::ranges::nth_element(values, middle);
+    medians[call] = std::max(*middle, kFloor);
+  }
+
+  for (auto& outcome : outcomes)
+  {
+    for (const auto& [call, time] : outcome.calls)
+    {
+      if (times[call].size() < 5 || time <= slowdown * medians[call]) continue;
+
+      std::ostringstream text;
+      text << call << " takes " << time << " us, median is " << medians[call];
+      outcome.slow_call = text.str();
+    }
+  }
+}
+}  // namespace
+
+int main(const int argc, char** argv)
+{
+  const auto options = ParseOptions(argc, argv);
+  if (!options)
+  {
+    std::cerr << "Usage: MatrixFuzz [--seed S] [--cases N] "
+                 "[--corpus directory] [--tolerance T] [--slowdown F]\n";
+    return 2;
+  }
+
+  // Corpus goes first, so regressions are seen on top
+  std::vector<Case> cases;
+  if (!options->corpus.empty()) cases = LoadCorpus(options->corpus);
+  const auto saved = cases.size();
+
+  Random random(options->seed);
+  for (size_t index = 0; index < options->cases; ++index)
+  {
+    cases.push_back(MakeCase(random, index, options->seed));
+  }
+
+  std::vector<Outcome> outcomes;
+  outcomes.reserve(cases.size());
+  for (const auto& test : cases)
+  {
+    outcomes.push_back(IsMatrix(test.kind) ? CheckMatrix(test)
+                                           : CheckPoints(test));
+  }
+  FlagSlowCalls(outcomes, options->slowdown);
+
+  // Summary by kinds
+  struct Summary
+  {
+    size_t cases{};
+    size_t violations{};
+    size_t flagged{};
+    long double worst{};
+  };
+  std::array<Summary, static_cast<size_t>(Kind::kCount)> summaries{};
+
+  size_t violations = 0;
+  size_t written = 0;
+  for (size_t index = 0; index < cases.size(); ++index)
+  {
+    const auto& test = cases[index];
+    const auto& outcome = outcomes[index];
+    auto& summary = summaries[static_cast<size_t>(test.kind)];
+    ++summary.cases;
+    if (!(outcome.error <= summary.worst)) summary.worst = outcome.error;
+
+    // Error of a well-posed case breaks an invariant
+    auto violation = outcome.violation;
+    const auto is_inaccurate = !(outcome.error <= options->tolerance);
+    if (violation.empty() && is_inaccurate && IsWellPosed(test.kind))
+      violation = outcome.check;
+
+    if (violation.empty() && !is_inaccurate && outcome.slow_call.empty())
+      continue;
+
+    ++summary.flagged;
+    std::cout << test.origin << " (" << kNames[static_cast<size_t>(test.kind)]
+              << "):";
+    if (!violation.empty())
+    {
+      ++summary.violations;
+      ++violations;
+      std::cout << " broken: " << violation << ';';
+    }
+    if (is_inaccurate)
+      std::cout << " error of " << outcome.check << " is " << outcome.error
+                << ';';
+    if (!outcome.slow_call.empty()) std::cout << ' ' << outcome.slow_call;
+    std::cout << '\n';
+
+    // New flagged cases join the corpus
+    if (options->corpus.empty() || test.is_saved) continue;
+
+    std::filesystem::create_directories(options->corpus);
+    const auto path = std::filesystem::path(options->corpus) /
+                      (std::string(kNames[static_cast<size_t>(test.kind)]) +
+                       '-' + std::to_string(options->seed) + '-' +
+                       std::to_string(index - saved) + ".case");
+    if (Save(test, path)) ++written;
+  }
+
+  std::cout << "\nkind            cases  broken  flagged  worst error\n";
+  for (size_t kind = 0; kind < summaries.size(); ++kind)
+  {
+    const auto& summary = summaries[kind];
+    std::cout << std::left << std::setw(16) << kNames[kind] << std::right
+              << std::setw(5) << summary.cases << std::setw(8)
+              << summary.violations << std::setw(9) << summary.flagged
+              << std::setw(13) << static_cast<double>(summary.worst) << '\n';
+  }
+  std::cout << "corpus: " << saved << " replayed, " << written
+            << " written\n";
+
+  return violations > 0 ? 1 : 0;
+}
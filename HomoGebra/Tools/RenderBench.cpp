@@ -0,0 +1,361 @@
+/*
+ * Renders a generated scene without a window and reports frame timings.
+ *
+ * Usage:
+ *   RenderBench [--width W] [--height H] [--frames N] [--seed S]
+ *               [--points N] [--lines N] [--conics N] [--zoom Z]
+ *               [--pan P] [--output image.png|image.ppm]
+ *               [--golden image.ppm] [--tolerance T]
+ *               [--scene scene.hgs|scene.jsonl]
+ *               [--save scene.hgs|scene.jsonl]
+ *
+ * --scene loads the scene from a file instead of generating it, --save
+ * writes the scene to a file before rendering. Files with .jsonl extension
+ * are JSON Lines, others are binary scene files.
+ *
+ * Exit code is 1 if the last frame differs from the golden image.
+ */
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "GeometricObject.h"
+#include "JsonLines.h"
+#include "Plane.h"
+#include "SceneFile.h"
+#include "SceneGenerator.h"
+#include "SoftwareCanvas.h"
+
+namespace
+{
+/**
+ * \brief Options of the benchmark.
+ */
+struct Options
+{
+  unsigned width = 1000;   //!< Width of the image.
+  unsigned height = 1000;  //!< Height of the image.
+  size_t frames = 100;     //!< Amount of frames to render.
+  unsigned seed = 0;       //!< Seed of the scene.
+  size_t points = 100;     //!< Amount of points.
+  size_t lines = 50;       //!< Amount of lines by two points.
+  size_t conics = 10;      //!< Amount of circles.
+  float zoom = 1.f;        //!< How many times the view is zoomed in.
+  float pan = 0.f;         //!< Pixels the view moves right every frame.
+  std::string output;      //!< Path to the image of the last frame.
+  std::string golden;      //!< Path to the image to compare with.
+  unsigned tolerance = 0;  //!< Maximum difference of a channel.
+  std::string scene;       //!< Path to the scene to load.
+  std::string save;        //!< Path to write the scene to.
+};
+
+/**
+ * \brief Parses command line.
+ *
+ * \param argc Amount of arguments.
+ * \param argv Arguments.
+ *
+ * \return Options or std::nullopt if command line is invalid.
+ */
+std::optional<Options> ParseOptions(const int argc, char** argv)
+{
+  Options options;
+
+  for (int argument = 1; argument < argc; ++argument)
+  {
+    const std::string key = argv[argument];
+
+    // Every option has a value
+    if (argument + 1 >= argc) return std::nullopt;
+    const std::string value = argv[++argument];
+
+    try
+    {
+      if (key == "--width")
+        options.width = static_cast<unsigned>(std::stoul(value));
+      else if (key == "--height")
+        options.height = static_cast<unsigned>(std::stoul(value));
+      else if (key == "--frames")
+        options.frames = std::stoul(value);
+      else if (key == "--seed")
+        options.seed = static_cast<unsigned>(std::stoul(value));
+      else if (key == "--points")
+        options.points = std::stoul(value);
+      else if (key == "--lines")
+        options.lines = std::stoul(value);
+      else if (key == "--conics")
+        options.conics = std::stoul(value);
+      else if (key == "--zoom")
+        options.zoom = std::stof(value);
+      else if (key == "--pan")
+        options.pan = std::stof(value);
+      else if (key == "--output")
+        options.output = value;
+      else if (key == "--golden")
+        options.golden = value;
+      else if (key == "--tolerance")
+        options.tolerance = static_cast<unsigned>(std::stoul(value));
+      else if (key == "--scene")
+        options.scene = value;
+      else if (key == "--save")
+        options.save = value;
+      else
+        return std::nullopt;
+    }
+    catch (const std::exception&)
+    {
+      return std::nullopt;
+    }
+  }
+
+  if (options.width == 0 || options.height == 0 || !(options.zoom > 0.f))
+  {
+    return std::nullopt;
+  }
+
+  return options;
+}
+
+/**
+ * \brief Loads scene from a binary file or from JSON Lines.
+ *
+ * \param path Path to the file.
+ * \param plane Plane to add objects to.
+ *
+ * \return True if the file is read, bad lines of JSON Lines are only
+ * reported.
+ */
+bool LoadScene(const std::string& path, HomoGebra::PlaneImplementation& plane)
+{
+  if (!path.ends_with(".jsonl")) return HomoGebra::SceneFile::Load(path, plane);
+
+  std::ifstream input(path);
+  if (!input) return false;
+
+  const auto report = HomoGebra::JsonLines::Import(input, plane);
+  for (const auto& [line, message] : report.errors)
+  {
+    std::cerr << path << ':' << line << ": " << message << '\n';
+  }
+  if (report.failed > report.errors.size())
+  {
+    std::cerr << report.failed - report.errors.size() << " more errors\n";
+  }
+
+  return true;
+}
+
+/**
+ * \brief Writes scene to a binary file or to JSON Lines.
+ *
+ * \param plane Plane to write.
+ * \param path Path to the file.
+ *
+ * \return True if the file is written.
+ */
+bool SaveScene(const HomoGebra::PlaneImplementation& plane,
+               const std::string& path)
+{
+  if (!path.ends_with(".jsonl")) return HomoGebra::SceneFile::Save(plane, path);
+
+  std::ofstream output(path);
+  return output && HomoGebra::JsonLines::Export(plane, output);
+}
+
+/**
+ * \brief Timings of one stage of a frame.
+ */
+struct Stage
+{
+  std::string name;                  //!< Name of the stage.
+  std::vector<double> milliseconds;  //!< Time of the stage in every frame.
+};
+
+/**
+ * \brief Prints statistics of stages.
+ *
+ * \param stages Stages to print.
+ */
+void PrintTimings(const std::vector<Stage>& stages)
+{
+  std::cout << std::left << std::setw(10) << "stage" << std::right
+            << std::setw(10) << "min" << std::setw(10) << "median"
+            << std::setw(10) << "p95" << std::setw(10) << "mean"
+            << std::setw(10) << "max" << "  (ms)\n";
+
+  for (const auto& [name, milliseconds] : stages)
+  {
+    if (milliseconds.empty()) continue;
+
+    auto sorted = milliseconds;
+    std::ranges::sort(sorted);
+
+    auto percentile = [&sorted](const double part)
+    {
+      return sorted[static_cast<size_t>(
+          part * static_cast<double>(sorted.size() - 1))];
+    };
+
+    const auto mean = std::accumulate(sorted.begin(), sorted.end(), 0.) /
+                      static_cast<double>(sorted.size());
+
+    std::cout << std::left << std::setw(10) << name << std::right
+              << std::fixed << std::setprecision(3) << std::setw(10)
+              << sorted.front() << std::setw(10) << percentile(0.5)
+              << std::setw(10) << percentile(0.95) << std::setw(10) << mean
+              << std::setw(10) << sorted.back() << '\n';
+  }
+}
+
+/**
+ * \brief Measures time of a function.
+ *
+ * \param stage Stage to add time to.
+ * \param function Function to measure.
+ */
+template <class Function>
+void Measure(Stage& stage, Function&& function)
+{
+  const auto start = std::chrono::steady_clock::now();
+  function();
+  const auto finish = std::chrono::steady_clock::now();
+
+  stage.milliseconds.push_back(
+      std::chrono::duration<double, std::milli>(finish - start).count());
+}
+}  // namespace
+
+int main(const int argc, char** argv)
+{
+  const auto options = ParseOptions(argc, argv);
+  if (!options)
+  {
+    std::cerr << "Usage: RenderBench [--width W] [--height H] [--frames N] "
+                 "[--seed S] [--points N] [--lines N] [--conics N] [--zoom Z] "
+                 "[--pan P] [--output image.png|image.ppm] "
+                 "[--golden image.ppm] [--tolerance T] "
+                 "[--scene scene.hgs|scene.jsonl] "
+                 "[--save scene.hgs|scene.jsonl]\n";
+    return 2;
+  }
+
+  HomoGebra::SoftwareCanvas canvas(options->width, options->height);
+
+  // Same scale as in the editor: 1000 units along the height
+  constexpr float kViewHeight = 1000.f;
+  const auto aspect_ratio = static_cast<float>(options->width) /
+                            static_cast<float>(options->height);
+  const auto view_height = kViewHeight / options->zoom;
+  const sf::Vector2f view_size{view_height * aspect_ratio, view_height};
+  const auto pan_step =
+      options->pan * view_height / static_cast<float>(options->height);
+
+  HomoGebra::Plane plane;
+
+  Stage generate{options->scene.empty() ? "generate" : "load", {}};
+  Stage update{"update", {}};
+  Stage clear{"clear", {}};
+  Stage draw{"draw", {}};
+  Stage frame{"frame", {}};
+  Stage encode{"encode", {}};
+
+  bool is_loaded = true;
+  Measure(generate,
+          [&]
+          {
+            if (options->scene.empty())
+            {
+              HomoGebra::SceneGenerator::Options scene;
+              scene.seed = options->seed;
+              scene.points = options->points;
+              scene.lines = options->lines;
+              scene.conics = options->conics;
+              scene.extent = kViewHeight / 2.f;
+              HomoGebra::SceneGenerator::Generate(plane.GetImplementation(),
+                                                  scene);
+            }
+            else
+            {
+              is_loaded = LoadScene(options->scene, plane.GetImplementation());
+            }
+          });
+
+  if (!is_loaded)
+  {
+    std::cerr << "Couldn't read " << options->scene << '\n';
+    return 2;
+  }
+
+  if (!options->save.empty() &&
+      !SaveScene(plane.GetImplementation(), options->save))
+  {
+    std::cerr << "Couldn't write " << options->save << '\n';
+    return 2;
+  }
+
+  for (size_t frame_number = 0; frame_number < options->frames; ++frame_number)
+  {
+    canvas.setView(sf::View(
+        {pan_step * static_cast<float>(frame_number), 0.f}, view_size));
+
+    Measure(frame,
+            [&]
+            {
+              Measure(update, [&] { plane.UpdateBodies(canvas); });
+              Measure(clear, [&] { canvas.Clear(); });
+              Measure(draw, [&] { plane.Draw(canvas); });
+            });
+  }
+
+  int exit_code = 0;
+
+  if (!options->output.empty())
+  {
+    bool saved = false;
+    Measure(encode,
+            [&]
+            {
+              saved = options->output.ends_with(".ppm")
+                          ? canvas.SaveToPpm(options->output)
+                          : canvas.SaveToPng(options->output);
+            });
+
+    if (!saved)
+    {
+      std::cerr << "Couldn't write " << options->output << '\n';
+      exit_code = 2;
+    }
+  }
+
+  const auto& views = plane.GetViews();
+  std::cout << "objects: " << views.size() << ", visible: "
+            << std::ranges::count_if(views, [](const auto& view)
+                                     { return view->GetBody().IsVisible(); })
+            << ", frames: " << options->frames << ", size: " << options->width
+            << 'x' << options->height << '\n';
+  PrintTimings({generate, update, clear, draw, frame, encode});
+
+  if (!options->golden.empty())
+  {
+    HomoGebra::SoftwareCanvas golden(1, 1);
+    if (!golden.LoadFromPpm(options->golden))
+    {
+      std::cerr << "Couldn't read " << options->golden << '\n';
+      return 2;
+    }
+
+    const auto different = canvas.CountDifferentPixels(
+        golden, static_cast<sf::Uint8>(std::min(options->tolerance, 255u)));
+    std::cout << "different pixels: " << different << '\n';
+
+    if (different > 0) exit_code = 1;
+  }
+
+  return exit_code;
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace HomoGebra
+{
+/**
+ * \brief Lock-free buffer between one writer and one reader.
+ *
+ * \details Double buffering with a spare buffer: the writer fills the back
+ * buffer and publishes it, the reader takes the newest published buffer as
+ * the front one. Neither side ever waits for the other, the reader just
+ * keeps the previous front buffer until a new one is published. Buffers are
+ * reused, so their allocations survive between publications.
+ *
+ * \tparam T Type of a buffer.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+template <class T>
+class TripleBuffer
+{
+ public:
+  /**
+   * \brief Gets buffer to write to.
+   *
+   * \details Only the writer may call it.
+   *
+   * \return Back buffer.
+   */
+  [[nodiscard]] T& GetBack() { return buffers_[back_]; }
+
+  /**
+   * \brief Publishes back buffer and takes a free one as back buffer.
+   *
+   * \details Only the writer may call it.
+   */
+  void Publish()
+  {
+    back_ = middle_.exchange(static_cast<std::uint8_t>(back_ | kFresh),
+                             std::memory_order_acq_rel) &
+            kIndexMask;
+  }
+
+  /**
+   * \brief Takes the newest published buffer as front buffer.
+   *
+   * \details Only the reader may call it.
+   *
+   * \return True if front buffer has changed.
+   */
+  bool Update()
+  {
+    if (!IsFresh()) return false;
+
+    front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+    return true;
+  }
+
+  /**
+   * \brief Gets buffer to read from.
+   *
+   * \details Only the reader may call it.
+   *
+   * \return Front buffer.
+   */
+  [[nodiscard]] const T& GetFront() const { return buffers_[front_]; }
+
+  /**
+   * \brief Checks if a published buffer isn't taken yet.
+   *
+   * \details Only the reader may call it.
+   *
+   * \return True if Update() would change front buffer.
+   */
+  [[nodiscard]] bool IsFresh() const
+  {
+    return middle_.load(std::memory_order_relaxed) & kFresh;
+  }
+
+ private:
+  /**
+   * Member data.
+   */
+  static constexpr std::uint8_t kIndexMask = 0b011;  //!< Bits of an index.
+  static constexpr std::uint8_t kFresh = 0b100;      //!< Spare is unread.
+
+  std::array<T, 3> buffers_{};  //!< Buffers.
+
+  std::uint8_t back_ = 0;                //!< Index of the back buffer.
+  std::atomic<std::uint8_t> middle_{1};  //!< Index of the spare buffer.
+  std::uint8_t front_ = 2;               //!< Index of the front buffer.
+};
+}  // namespace HomoGebra
@@ -0,0 +1,1450 @@
+#include "VectorExport.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <numbers>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "GeometricObject.h"
+#include "PlaneImplementation.h"
+
+namespace HomoGebra::VectorExport
+{
+namespace
+{
+/**
+ * \brief Point or vector of a plane or of a figure.
+ */
+struct Vector
+{
+  double x;  //!< Abscissa.
+  double y;  //!< Ordinate.
+};
+
+Vector operator+(const Vector& left, const Vector& right)
+{
+  return {left.x + right.x, left.y + right.y};
+}
+
+Vector operator-(const Vector& left, const Vector& right)
+{
+  return {left.x - right.x, left.y - right.y};
+}
+
+Vector operator*(const Vector& vector, const double factor)
+{
+  return {vector.x * factor, vector.y * factor};
+}
+
+/**
+ * \brief Color of a layer.
+ */
+struct Color
+{
+  std::uint8_t red;    //!< Red channel.
+  std::uint8_t green;  //!< Green channel.
+  std::uint8_t blue;   //!< Blue channel.
+};
+
+constexpr Color kCurveColor{0, 0, 0};    //!< Color of lines and conics.
+constexpr Color kPointColor{255, 0, 0};  //!< Color of points.
+constexpr Color kTextColor{0, 0, 0};     //!< Color of names.
+
+constexpr double kEpsilon = 1e-9;  //!< Relative precision of conics.
+
+/**
+ * \brief Parametrized real conic.
+ *
+ * \details Point with parameter t is:
+ * - origin + first * cos(t) + second * sin(t) for an ellipse;
+ * - origin + first * cosh(t) + second * sinh(t) for a branch of a
+ *   hyperbola;
+ * - origin + first * t + second * t^2 for a parabola.
+ */
+struct Curve
+{
+  /**
+   * \brief Type of the conic.
+   */
+  enum class Kind
+  {
+    kEllipse,
+    kHyperbola,
+    kParabola
+  };
+
+  /**
+   * \brief Calculates point of the curve.
+   *
+   * \param parameter Parameter of the point.
+   *
+   * \return Point.
+   */
+  [[nodiscard]] Vector operator()(const double parameter) const
+  {
+    switch (kind)
+    {
+      case Kind::kEllipse:
+        return origin + first * std::cos(parameter) +
+               second * std::sin(parameter);
+      case Kind::kHyperbola:
+        return origin + first * std::cosh(parameter) +
+               second * std::sinh(parameter);
+      default:
+        return origin + first * parameter + second * (parameter * parameter);
+    }
+  }
+
+  /**
+   * \brief Calculates derivative of the curve by the parameter.
+   *
+   * \param parameter Parameter of the point.
+   *
+   * \return Tangent vector.
+   */
+  [[nodiscard]] Vector GetDerivative(const double parameter) const
+  {
+    switch (kind)
+    {
+      case Kind::kEllipse:
+        return second * std::cos(parameter) - first * std::sin(parameter);
+      case Kind::kHyperbola:
+        return first * std::sinh(parameter) + second * std::cosh(parameter);
+      default:
+        return first + second * (2 * parameter);
+    }
+  }
+
+  Kind kind;      //!< Type of the conic.
+  Vector origin;  //!< Center or vertex.
+  Vector first;   //!< Coefficient of cos, cosh or t.
+  Vector second;  //!< Coefficient of sin, sinh or t^2.
+};
+
+/**
+ * \brief Line a*x + b*y + c = 0.
+ */
+struct LineCoefficients
+{
+  double a;  //!< Coefficient of x.
+  double b;  //!< Coefficient of y.
+  double c;  //!< Constant.
+};
+
+/**
+ * \brief Real conic split into curves and lines, which can be written.
+ */
+struct Shape
+{
+  std::array<Curve, 2> curves{};            //!< Ellipse or branches.
+  size_t curve_count = 0;                   //!< Amount of curves.
+  std::array<LineCoefficients, 2> lines{};  //!< Lines of degenerate conic.
+  size_t line_count = 0;                    //!< Amount of lines.
+};
+
+/**
+ * \brief Real roots of a*x^2 + b*x + c = 0.
+ */
+struct QuadraticRoots
+{
+  std::array<double, 2> roots{};  //!< Roots.
+  size_t count = 0;               //!< Amount of roots.
+};
+
+/**
+ * \brief Solves real quadratic equation without cancellation.
+ *
+ * \param a Coefficient of x^2.
+ * \param b Coefficient of x.
+ * \param c Constant.
+ *
+ * \return Real roots.
+ */
+QuadraticRoots SolveQuadratic(const double a, const double b, const double c)
+{
+  if (a == 0)
+  {
+    if (b == 0) return {};
+    return {{-c / b}, 1};
+  }
+
+  const auto discriminant = b * b - 4 * a * c;
+  if (discriminant < 0) return {};
+
+  const auto q = -(b + std::copysign(std::sqrt(discriminant), b)) / 2;
+  if (q == 0) return {{0.}, 1};
+
+  return {{q / a, c / q}, 2};
+}
+
+/**
+ * \brief Writes figure in some format.
+ *
+ * \details Coordinates are given in units of the figure, axis y is directed
+ * down. Every path starts with MoveTo() and ends with EndPath().
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+class Writer
+{
+ public:
+  /**
+   * \brief Constructs writer to a stream.
+   *
+   * \param output Stream to write to.
+   */
+  explicit Writer(std::ostream& output) : output_(output) {}
+
+  /**
+   * \brief Default destructor.
+   */
+  virtual ~Writer() = default;
+
+  /**
+   * \brief Writes beginning of a figure.
+   *
+   * \param width Width of the figure.
+   * \param height Height of the figure.
+   */
+  virtual void Begin(double width, double height) = 0;
+
+  /**
+   * \brief Writes end of the figure.
+   */
+  virtual void End() = 0;
+
+  /**
+   * \brief Starts a layer, paths of which are stroked or filled.
+   *
+   * \param color Color of the layer.
+   * \param stroke_width Width of strokes, paths are filled if it is zero.
+   */
+  virtual void BeginLayer(const Color& color, double stroke_width) = 0;
+
+  /**
+   * \brief Ends the layer.
+   */
+  virtual void EndLayer() = 0;
+
+  /**
+   * \brief Starts a path.
+   *
+   * \param point First point of the path.
+   */
+  virtual void MoveTo(const Vector& point) = 0;
+
+  /**
+   * \brief Adds a segment to the path.
+   *
+   * \param point End of the segment.
+   */
+  virtual void LineTo(const Vector& point) = 0;
+
+  /**
+   * \brief Adds a cubic Bezier curve to the path.
+   *
+   * \param first First control point.
+   * \param second Second control point.
+   * \param end End of the curve.
+   */
+  virtual void CubicTo(const Vector& first, const Vector& second,
+                       const Vector& end) = 0;
+
+  /**
+   * \brief Adds a quadratic Bezier curve to the path.
+   *
+   * \param control Control point.
+   * \param end End of the curve.
+   */
+  virtual void QuadraticTo(const Vector& control, const Vector& end) = 0;
+
+  /**
+   * \brief Adds an arc of an ellipse to the path.
+   *
+   * \details Arc is approximated by cubic Bezier curves, each of them is at
+   * most a quarter of the ellipse.
+   *
+   * \param ellipse Ellipse, path is at the point with parameter from.
+   * \param from Parameter of the start.
+   * \param to Parameter of the end, it is greater than from.
+   */
+  virtual void ArcTo(const Curve& ellipse, const double from, const double to)
+  {
+    const auto pieces = GetArcPieces(from, to);
+    const auto step = (to - from) / static_cast<double>(pieces);
+
+    // Tangents of a quarter of a circle are 4/3 * tan(pi/8) long
+    const auto tangent = 4. / 3. * std::tan(step / 4);
+    for (size_t piece = 0; piece < pieces; ++piece)
+    {
+      const auto start = from + step * static_cast<double>(piece);
+      const auto end = start + step;
+      CubicTo(ellipse(start) + ellipse.GetDerivative(start) * tangent,
+              ellipse(end) - ellipse.GetDerivative(end) * tangent,
+              ellipse(end));
+    }
+  }
+
+  /**
+   * \brief Ends the path, it is stroked or filled by the layer.
+   */
+  virtual void EndPath() = 0;
+
+  /**
+   * \brief Writes filled circle.
+   *
+   * \param center Center of the circle.
+   * \param radius Radius of the circle.
+   */
+  virtual void Circle(const Vector& center, double radius) = 0;
+
+  /**
+   * \brief Writes text.
+   *
+   * \param position Top left corner of the text.
+   * \param size Height of the text.
+   * \param text Text to write.
+   */
+  virtual void Text(const Vector& position, double size,
+                    std::string_view text) = 0;
+
+ protected:
+  /**
+   * \brief Calculates amount of pieces of an arc of an ellipse.
+   *
+   * \param from Parameter of the start.
+   * \param to Parameter of the end.
+   *
+   * \return Amount of pieces, each is at most a quarter of the ellipse.
+   */
+  [[nodiscard]] static size_t GetArcPieces(const double from, const double to)
+  {
+    constexpr auto kQuarter = std::numbers::pi / 2;
+    return std::max(size_t{1},
+                    static_cast<size_t>(std::ceil((to - from) / kQuarter)));
+  }
+
+  /**
+   * \brief Writes text to the stream.
+   *
+   * \param text Text to write.
+   */
+  void Write(const std::string_view text)
+  {
+    output_.write(text.data(), static_cast<std::streamsize>(text.size()));
+    offset_ += text.size();
+  }
+
+  /**
+   * \brief Appends number with three digits after the point.
+   *
+   * \param text Text to append to.
+   * \param value Number to append.
+   */
+  static void AppendNumber(std::string& text, const double value)
+  {
+    std::array<char, 48> buffer{};
+    auto [end, error] =
+        std::to_chars(buffer.data(), buffer.data() + buffer.size(), value,
+                      std::chars_format::fixed, 3);
+    if (error != std::errc{})
+    {
+      text += '0';
+      return;
+    }
+
+    // Trailing zeros aren't needed
+    while (*(end - 1) == '0') --end;
+    if (*(end - 1) == '.') --end;
+
+    const std::string_view number{buffer.data(), end};
+    text += number == "-0" ? "0" : number;
+  }
+
+  /**
+   * Member data.
+   */
+  std::string text_;  //!< Text, which is being composed.
+  size_t offset_{};   //!< Amount of written bytes.
+
+ private:
+  std::ostream& output_;  //!< Stream to write to.
+};
+
+/**
+ * \brief Writes figure as SVG.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+class SvgWriter final : public Writer
+{
+ public:
+  using Writer::Writer;
+
+  void Begin(const double width, const double height) override
+  {
+    text_ =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"";
+    AppendNumber(text_, width);
+    text_ += "\" height=\"";
+    AppendNumber(text_, height);
+    text_ += "\" viewBox=\"0 0 ";
+    AppendNumber(text_, width);
+    text_ += ' ';
+    AppendNumber(text_, height);
+    text_ +=
+        "\" font-family=\"sans-serif\">\n"
+        "<rect width=\"100%\" height=\"100%\" fill=\"white\"/>\n";
+    Write(text_);
+  }
+
+  void End() override { Write("</svg>\n"); }
+
+  void BeginLayer(const Color& color, const double stroke_width) override
+  {
+    text_ = "<g ";
+    if (stroke_width > 0)
+    {
+      text_ += "fill=\"none\" stroke=\"";
+      AppendColor(color);
+      text_ += "\" stroke-width=\"";
+      AppendNumber(text_, stroke_width);
+      text_ += "\" stroke-linecap=\"round\" stroke-linejoin=\"round\">\n";
+    }
+    else
+    {
+      text_ += "fill=\"";
+      AppendColor(color);
+      text_ += "\">\n";
+    }
+    Write(text_);
+  }
+
+  void EndLayer() override { Write("</g>\n"); }
+
+  void MoveTo(const Vector& point) override
+  {
+    text_ = "<path d=\"M";
+    AppendPoint(point);
+  }
+
+  void LineTo(const Vector& point) override
+  {
+    text_ += 'L';
+    AppendPoint(point);
+  }
+
+  void CubicTo(const Vector& first, const Vector& second,
+               const Vector& end) override
+  {
+    text_ += 'C';
+    AppendPoint(first);
+    text_ += ' ';
+    AppendPoint(second);
+    text_ += ' ';
+    AppendPoint(end);
+  }
+
+  void QuadraticTo(const Vector& control, const Vector& end) override
+  {
+    text_ += 'Q';
+    AppendPoint(control);
+    text_ += ' ';
+    AppendPoint(end);
+  }
+
+  void ArcTo(const Curve& ellipse, const double from, const double to) override
+  {
+    const auto radius_x = std::hypot(ellipse.first.x, ellipse.first.y);
+    const auto radius_y = std::hypot(ellipse.second.x, ellipse.second.y);
+    const auto rotation = std::atan2(ellipse.first.y, ellipse.first.x) * 180 /
+                          std::numbers::pi;
+
+    // Parameter grows from the first axis to the second one
+    const auto sweep = ellipse.first.x * ellipse.second.y -
+                           ellipse.first.y * ellipse.second.x >
+                       0;
+
+    // Pieces are short, so the small arc is always taken
+    const auto pieces = GetArcPieces(from, to);
+    const auto step = (to - from) / static_cast<double>(pieces);
+    for (size_t piece = 1; piece <= pieces; ++piece)
+    {
+      text_ += 'A';
+      AppendNumber(text_, radius_x);
+      text_ += ' ';
+      AppendNumber(text_, radius_y);
+      text_ += ' ';
+      AppendNumber(text_, rotation);
+      text_ += sweep ? " 0 1 " : " 0 0 ";
+      AppendPoint(ellipse(from + step * static_cast<double>(piece)));
+    }
+  }
+
+  void EndPath() override
+  {
+    text_ += "\"/>\n";
+    Write(text_);
+  }
+
+  void Circle(const Vector& center, const double radius) override
+  {
+    text_ = "<circle cx=\"";
+    AppendNumber(text_, center.x);
+    text_ += "\" cy=\"";
+    AppendNumber(text_, center.y);
+    text_ += "\" r=\"";
+    AppendNumber(text_, radius);
+    text_ += "\"/>\n";
+    Write(text_);
+  }
+
+  void Text(const Vector& position, const double size,
+            const std::string_view text) override
+  {
+    // Baseline is below the top of the text
+    text_ = "<text x=\"";
+    AppendNumber(text_, position.x);
+    text_ += "\" y=\"";
+    AppendNumber(text_, position.y + size * kAscent);
+    text_ += "\" font-size=\"";
+    AppendNumber(text_, size);
+    text_ += "\">";
+    for (const auto character : text)
+    {
+      switch (character)
+      {
+        case '&':
+          text_ += "&amp;";
+          break;
+        case '<':
+          text_ += "&lt;";
+          break;
+        case '>':
+          text_ += "&gt;";
+          break;
+        default:
+          text_ += character;
+      }
+    }
+    text_ += "</text>\n";
+    Write(text_);
+  }
+
+ private:
+  /**
+   * \brief Appends coordinates of a point.
+   *
+   * \param point Point to append.
+   */
+  void AppendPoint(const Vector& point)
+  {
+    AppendNumber(text_, point.x);
+    text_ += ' ';
+    AppendNumber(text_, point.y);
+  }
+
+  /**
+   * \brief Appends color as #rrggbb.
+   *
+   * \param color Color to append.
+   */
+  void AppendColor(const Color& color)
+  {
+    constexpr std::string_view kDigits = "0123456789abcdef";
+    text_ += '#';
+    for (const auto channel : {color.red, color.green, color.blue})
+    {
+      text_ += kDigits[channel >> 4];
+      text_ += kDigits[channel & 0xf];
+    }
+  }
+
+  static constexpr double kAscent =
+      0.8;  //!< Distance from the top to the baseline per height.
+};
+
+/**
+ * \brief Writes figure as a one-page PDF.
+ *
+ * \details Content of the page is written as soon as it comes, its length
+ * is written after it as an indirect object, so nothing is kept in memory.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+class PdfWriter final : public Writer
+{
+ public:
+  using Writer::Writer;
+
+  void Begin(const double width, const double height) override
+  {
+    height_ = height;
+
+    Write("%PDF-1.4\n%\xE2\xE3\xCF\xD3\n");
+
+    BeginObject(kCatalog);
+    Write("<< /Type /Catalog /Pages 2 0 R >>\nendobj\n");
+
+    BeginObject(kPages);
+    Write("<< /Type /Pages /Kids [3 0 R] /Count 1 >>\nendobj\n");
+
+    BeginObject(kPage);
+    text_ = "<< /Type /Page /Parent 2 0 R /MediaBox [0 0 ";
+    AppendNumber(text_, width);
+    text_ += ' ';
+    AppendNumber(text_, height);
+    text_ +=
+        "] /Resources << /Font << /F1 4 0 R >> >> /Contents 5 0 R >>\n"
+        "endobj\n";
+    Write(text_);
+
+    BeginObject(kFont);
+    Write(
+        "<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica "
+        "/Encoding /WinAnsiEncoding >>\nendobj\n");
+
+    BeginObject(kContents);
+    Write("<< /Length 6 0 R >>\nstream\n");
+    contents_start_ = offset_;
+
+    // White background
+    text_ = "1 g 0 0 ";
+    AppendNumber(text_, width);
+    text_ += ' ';
+    AppendNumber(text_, height);
+    text_ += " re f\n";
+    Write(text_);
+  }
+
+  void End() override
+  {
+    const auto length = offset_ - contents_start_;
+    Write("\nendstream\nendobj\n");
+
+    BeginObject(kLength);
+    Write(std::to_string(length) + "\nendobj\n");
+
+    const auto cross_reference = offset_;
+    text_ = "xref\n0 " + std::to_string(kObjectCount) +
+            "\n0000000000 65535 f \n";
+    for (size_t object = 1; object < kObjectCount; ++object)
+    {
+      const auto offset = std::to_string(offsets_[object]);
+      text_ += std::string(10 - offset.size(), '0') + offset + " 00000 n \n";
+    }
+    text_ += "trailer\n<< /Size " + std::to_string(kObjectCount) +
+             " /Root 1 0 R >>\nstartxref\n" +
+             std::to_string(cross_reference) + "\n%%EOF\n";
+    Write(text_);
+  }
+
+  void BeginLayer(const Color& color, const double stroke_width) override
+  {
+    is_filled_ = stroke_width <= 0;
+
+    text_ = "q ";
+    for (const auto channel : {color.red, color.green, color.blue})
+    {
+      AppendNumber(text_, channel / 255.);
+      text_ += ' ';
+    }
+    if (is_filled_)
+    {
+      text_ += "rg\n";
+    }
+    else
+    {
+      text_ += "RG ";
+      AppendNumber(text_, stroke_width);
+      text_ += " w 1 J 1 j\n";
+    }
+    Write(text_);
+  }
+
+  void EndLayer() override { Write("Q\n"); }
+
+  void MoveTo(const Vector& point) override
+  {
+    text_.clear();
+    AppendPoint(point);
+    text_ += " m\n";
+    current_ = point;
+  }
+
+  void LineTo(const Vector& point) override
+  {
+    AppendPoint(point);
+    text_ += " l\n";
+    current_ = point;
+  }
+
+  void CubicTo(const Vector& first, const Vector& second,
+               const Vector& end) override
+  {
+    AppendPoint(first);
+    text_ += ' ';
+    AppendPoint(second);
+    text_ += ' ';
+    AppendPoint(end);
+    text_ += " c\n";
+    current_ = end;
+  }
+
+  void QuadraticTo(const Vector& control, const Vector& end) override
+  {
+    // PDF has only cubic curves, degree is elevated exactly
+    CubicTo(current_ + (control - current_) * (2. / 3.),
+            end + (control - end) * (2. / 3.), end);
+  }
+
+  void EndPath() override
+  {
+    text_ += is_filled_ ? "f\n" : "S\n";
+    Write(text_);
+  }
+
+  void Circle(const Vector& center, const double radius) override
+  {
+    const Curve circle{Curve::Kind::kEllipse, center, {radius, 0.},
+                       {0., radius}};
+
+    MoveTo(circle(0.));
+    ArcTo(circle, 0., 2 * std::numbers::pi);
+    text_ += "h ";
+    EndPath();
+  }
+
+  void Text(const Vector& position, const double size,
+            const std::string_view text) override
+  {
+    text_ = "BT /F1 ";
+    AppendNumber(text_, size);
+    text_ += " Tf ";
+    AppendPoint(position + Vector{0., size * kAscent});
+    text_ += " Td (";
+    for (const auto character : text)
+    {
+      if (character == '(' || character == ')' || character == '\\')
+      {
+        text_ += '\\';
+      }
+      text_ += character;
+    }
+    text_ += ") Tj ET\n";
+    Write(text_);
+  }
+
+ private:
+  /**
+   * \brief Numbers of objects of the document.
+   */
+  enum Object : size_t
+  {
+    kCatalog = 1,
+    kPages,
+    kPage,
+    kFont,
+    kContents,
+    kLength,
+    kObjectCount
+  };
+
+  /**
+   * \brief Writes header of an object and remembers its offset.
+   *
+   * \param object Number of the object.
+   */
+  void BeginObject(const Object object)
+  {
+    offsets_[object] = offset_;
+    Write(std::to_string(object) + " 0 obj\n");
+  }
+
+  /**
+   * \brief Appends coordinates of a point, axis y of PDF is directed up.
+   *
+   * \param point Point to append.
+   */
+  void AppendPoint(const Vector& point)
+  {
+    AppendNumber(text_, point.x);
+    text_ += ' ';
+    AppendNumber(text_, height_ - point.y);
+  }
+
+  static constexpr double kAscent =
+      0.8;  //!< Distance from the top to the baseline per height.
+
+  /**
+   * Member data.
+   */
+  double height_{};                             //!< Height of the page.
+  size_t contents_start_{};                     //!< Offset of the content.
+  std::array<size_t, kObjectCount> offsets_{};  //!< Offsets of objects.
+  Vector current_{};                            //!< End of the path.
+  bool is_filled_ = false;                      //!< Is layer filled?
+};
+
+/**
+ * \brief Maps plane to a figure.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+class Figure
+{
+ public:
+  /**
+   * \brief Constructs map of a viewport.
+   *
+   * \param options Options of the export.
+   */
+  explicit Figure(const Options& options)
+      : viewport_(options.viewport),
+        scale_(options.width / (options.viewport.right - options.viewport.left))
+  {
+  }
+
+  /**
+   * \brief Maps point of the plane.
+   *
+   * \param point Point of the plane.
+   *
+   * \return Point of the figure.
+   */
+  [[nodiscard]] Vector Map(const Vector& point) const
+  {
+    return Vector{point.x - viewport_.left, point.y - viewport_.top} * scale_;
+  }
+
+  /**
+   * \brief Maps curve of the plane.
+   *
+   * \param curve Curve of the plane.
+   *
+   * \return Curve of the figure with the same parameters of points.
+   */
+  [[nodiscard]] Curve Map(const Curve& curve) const
+  {
+    return {curve.kind, Map(curve.origin), curve.first * scale_,
+            curve.second * scale_};
+  }
+
+  /**
+   * \brief Gets units of the figure per unit of the plane.
+   *
+   * \return Scale.
+   */
+  [[nodiscard]] double GetScale() const { return scale_; }
+
+  /**
+   * \brief Gets size of the figure.
+   *
+   * \return Width and height.
+   */
+  [[nodiscard]] Vector GetSize() const
+  {
+    return Vector{viewport_.right - viewport_.left,
+                  viewport_.bottom - viewport_.top} *
+           scale_;
+  }
+
+ private:
+  /**
+   * Member data.
+   */
+  Clipping::Bounds viewport_;  //!< Part of the plane.
+  double scale_;               //!< Units of the figure per unit of the plane.
+};
+
+/**
+ * \brief Checks if a point is in a rectangle.
+ *
+ * \param bounds Rectangle.
+ * \param point Point to check.
+ *
+ * \return True if the point is inside or on the border.
+ */
+bool Contains(const Clipping::Bounds& bounds, const Vector& point)
+{
+  return point.x >= bounds.left && point.x <= bounds.right &&
+         point.y >= bounds.top && point.y <= bounds.bottom;
+}
+
+/**
+ * \brief Lines, which are clipped together.
+ *
+ * \details Only a fixed amount of lines is kept, they are written when the
+ * batch is full.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+class LineBatch
+{
+ public:
+  /**
+   * \brief Constructs batch of a figure.
+   *
+   * \param options Options of the export.
+   * \param figure Map to the figure.
+   * \param writer Writer of the figure.
+   */
+  LineBatch(const Options& options, const Figure& figure, Writer& writer)
+      : viewport_(options.viewport), figure_(figure), writer_(writer)
+  {
+  }
+
+  /**
+   * \brief Adds a line, batch is written if it is full.
+   *
+   * \param line Line to add.
+   */
+  void Push(const LineCoefficients& line)
+  {
+    lines_.Push(static_cast<float>(line.a), static_cast<float>(line.b),
+                static_cast<float>(line.c));
+    if (lines_.GetSize() == kBatchSize) Flush();
+  }
+
+  /**
+   * \brief Writes visible parts of the lines.
+   */
+  void Flush()
+  {
+    Clipping::ClipLines(lines_, viewport_, segments_);
+    for (size_t line = 0; line < lines_.GetSize(); ++line)
+    {
+      if (!segments_.visible[line]) continue;
+
+      writer_.MoveTo(figure_.Map({segments_.x0[line], segments_.y0[line]}));
+      writer_.LineTo(figure_.Map({segments_.x1[line], segments_.y1[line]}));
+      writer_.EndPath();
+    }
+    lines_.Clear();
+  }
+
+ private:
+  static constexpr size_t kBatchSize = 256;  //!< Amount of lines in a batch.
+
+  /**
+   * Member data.
+   */
+  Clipping::Bounds viewport_;    //!< Bounds to clip with.
+  const Figure& figure_;         //!< Map to the figure.
+  Writer& writer_;               //!< Writer of the figure.
+  Clipping::Lines lines_;        //!< Lines of the batch.
+  Clipping::Segments segments_;  //!< Clipped lines.
+};
+
+/**
+ * \brief Gets real line.
+ *
+ * \param equation Equation of the line.
+ *
+ * \return Line or std::nullopt if it isn't in the real plane.
+ */
+std::optional<LineCoefficients> GetLine(const LineEquation& equation)
+{
+  const auto normalized = equation.equation.GetNormalized();
+  if (!normalized.x.IsReal() || !normalized.y.IsReal() ||
+      !normalized.z.IsReal())
+  {
+    return std::nullopt;
+  }
+
+  return LineCoefficients{static_cast<double>(normalized.x.real()),
+                          static_cast<double>(normalized.y.real()),
+                          static_cast<double>(normalized.z.real())};
+}
+
+/**
+ * \brief Gets real position of a point.
+ *
+ * \param equation Equation of the point.
+ *
+ * \return Position or std::nullopt if it isn't in the real plane or is at
+ * infinity.
+ */
+std::optional<Vector> GetPosition(const PointEquation& equation)
+{
+  const auto normalized = equation.GetEquation().GetNormalized();
+  if (!normalized.x.IsReal() || !normalized.y.IsReal() ||
+      normalized[Var::kZ].IsZero())
+  {
+    return std::nullopt;
+  }
+
+  return Vector{static_cast<double>(normalized.x.real()),
+                static_cast<double>(normalized.y.real())};
+}
+
+/**
+ * \brief Splits real conic into curves and lines.
+ *
+ * \details Axes are rotated, so the conic has no xy term, then the conic is
+ * classified by its canonical form.
+ *
+ * \param equation Equation of the conic.
+ *
+ * \return Shape of the conic, it is empty if the conic has no real points
+ * or is a point.
+ */
+Shape GetShape(const ConicEquation& equation)
+{
+  Shape shape;
+
+  // a*x^2 + b*xy + c*y^2 + d*x + e*y + f = 0
+  const std::array coefficients{
+      equation.squares[static_cast<size_t>(Var::kX)],
+      equation.pair_products[static_cast<size_t>(Var::kZ)],
+      equation.squares[static_cast<size_t>(Var::kY)],
+      equation.pair_products[static_cast<size_t>(Var::kY)],
+      equation.pair_products[static_cast<size_t>(Var::kX)],
+      equation.squares[static_cast<size_t>(Var::kZ)]};
+
+  // Largest coefficient becomes 1
+  const auto largest = *std::ranges::max_element(
+      coefficients, {}, [](const Complex& number) { return std::abs(number); });
+  if (largest.IsZero()) return shape;
+
+  std::array<double, 6> real{};
+  for (size_t index = 0; index < coefficients.size(); ++index)
+  {
+    const auto normalized = coefficients[index] / largest;
+    if (!normalized.IsReal()) return shape;
+    real[index] = static_cast<double>(normalized.real());
+  }
+  const auto [a, b, c, d, e, f] = real;
+
+  auto add_line = [&shape](const LineCoefficients& line)
+  {
+    if (std::hypot(line.a, line.b) > kEpsilon)
+    {
+      shape.lines[shape.line_count++] = line;
+    }
+  };
+
+  // Conic is a line and the line at infinity
+  const auto quadratic_scale =
+      std::max({std::abs(a), std::abs(b), std::abs(c)});
+  if (quadratic_scale <= kEpsilon)
+  {
+    add_line({d, e, f});
+    return shape;
+  }
+
+  // Rotate axes, so xy term vanishes and |a| >= |c| in the new axes
+  auto angle = std::atan2(b, a - c) / 2;
+  auto rotate = [&](const double rotation_angle)
+  {
+    const auto cosine = std::cos(rotation_angle);
+    const auto sine = std::sin(rotation_angle);
+    return std::array{
+        a * cosine * cosine + b * cosine * sine + c * sine * sine,
+        a * sine * sine - b * cosine * sine + c * cosine * cosine,
+        d * cosine + e * sine, -d * sine + e * cosine};
+  };
+  auto rotated = rotate(angle);
+  if (std::abs(rotated[0]) < std::abs(rotated[1]))
+  {
+    angle += std::numbers::pi / 2;
+    rotated = rotate(angle);
+  }
+  const auto [square_u, square_v, linear_u, linear_v] = rotated;
+
+  const Vector u_axis{std::cos(angle), std::sin(angle)};
+  const Vector v_axis{-u_axis.y, u_axis.x};
+
+  // Line alpha*u + beta*v + gamma = 0 in the rotated axes
+  auto add_rotated_line =
+      [&](const double alpha, const double beta, const double gamma)
+  {
+    add_line({alpha * u_axis.x - beta * u_axis.y,
+              alpha * u_axis.y + beta * u_axis.x, gamma});
+  };
+
+  // square_u*u^2 + linear_u*u + linear_v*v + f = 0
+  if (std::abs(square_v) <= kEpsilon * quadratic_scale)
+  {
+    // Parallel lines
+    if (std::abs(linear_v) <= kEpsilon)
+    {
+      const auto [roots, count] = SolveQuadratic(square_u, linear_u, f);
+      for (size_t root = 0; root < count; ++root)
+      {
+        add_rotated_line(1., 0., -roots[root]);
+      }
+      return shape;
+    }
+
+    // Parabola v = -(square_u*u^2 + linear_u*u + f) / linear_v
+    shape.curves[shape.curve_count++] = {
+        Curve::Kind::kParabola, v_axis * (-f / linear_v),
+        u_axis + v_axis * (-linear_u / linear_v),
+        v_axis * (-square_u / linear_v)};
+    return shape;
+  }
+
+  // square_u*(u - u0)^2 + square_v*(v - v0)^2 = free_term
+  const auto u0 = -linear_u / (2 * square_u);
+  const auto v0 = -linear_v / (2 * square_v);
+  const auto free_term = square_u * u0 * u0 + square_v * v0 * v0 - f;
+  const auto center = u_axis * u0 + v_axis * v0;
+
+  const auto is_ellipse = square_u * square_v > 0;
+  if (std::abs(free_term) <=
+      kEpsilon * (1 + std::abs(square_u) * u0 * u0 +
+                  std::abs(square_v) * v0 * v0))
+  {
+    // Point isn't written
+    if (is_ellipse) return shape;
+
+    // Pair of lines crosses at the center
+    const auto root_u = std::sqrt(std::abs(square_u));
+    const auto root_v = std::sqrt(std::abs(square_v));
+    add_rotated_line(root_u, root_v, -root_u * u0 - root_v * v0);
+    add_rotated_line(root_u, -root_v, -root_u * u0 + root_v * v0);
+    return shape;
+  }
+
+  if (is_ellipse)
+  {
+    // Ellipse without real points
+    if (free_term / square_u < 0) return shape;
+
+    shape.curves[shape.curve_count++] = {
+        Curve::Kind::kEllipse, center,
+        u_axis * std::sqrt(free_term / square_u),
+        v_axis * std::sqrt(free_term / square_v)};
+    return shape;
+  }
+
+  // Branches of a hyperbola are symmetric about the center
+  const auto [real_axis, imaginary_axis] =
+      free_term / square_u > 0
+          ? std::pair{u_axis * std::sqrt(free_term / square_u),
+                      v_axis * std::sqrt(-free_term / square_v)}
+          : std::pair{v_axis * std::sqrt(free_term / square_v),
+                      u_axis * std::sqrt(-free_term / square_u)};
+
+  shape.curves[shape.curve_count++] = {Curve::Kind::kHyperbola, center,
+                                       real_axis, imaginary_axis};
+  shape.curves[shape.curve_count++] = {Curve::Kind::kHyperbola, center,
+                                       real_axis * -1., imaginary_axis};
+  return shape;
+}
+
+/**
+ * \brief Finds parameters, where a coordinate of a curve equals to a value.
+ *
+ * \param curve Curve to cross.
+ * \param coordinate Abscissa or ordinate.
+ * \param value Value of the coordinate.
+ * \param parameters Parameters to append to.
+ */
+void AppendCrossings(const Curve& curve, const double Vector::*coordinate,
+                     const double value, std::vector<double>& parameters)
+{
+  const auto origin = curve.origin.*coordinate - value;
+  const auto first = curve.first.*coordinate;
+  const auto second = curve.second.*coordinate;
+
+  switch (curve.kind)
+  {
+    case Curve::Kind::kEllipse:
+    {
+      // first*cos(t) + second*sin(t) = radius*cos(t - phase) = -origin
+      const auto radius = std::hypot(first, second);
+      if (radius == 0 || std::abs(origin) > radius) return;
+
+      const auto phase = std::atan2(second, first);
+      const auto offset = std::acos(-origin / radius);
+      parameters.push_back(phase + offset);
+      parameters.push_back(phase - offset);
+      return;
+    }
+    case Curve::Kind::kHyperbola:
+    {
+      // cosh and sinh of t are expressed by s = e^t
+      const auto [roots, count] =
+          SolveQuadratic(first + second, 2 * origin, first - second);
+      for (size_t root = 0; root < count; ++root)
+      {
+        if (roots[root] > 0) parameters.push_back(std::log(roots[root]));
+      }
+      return;
+    }
+    default:
+    {
+      const auto [roots, count] = SolveQuadratic(second, first, origin);
+      parameters.insert(parameters.end(), roots.begin(),
+                        roots.begin() + static_cast<ptrdiff_t>(count));
+    }
+  }
+}
+
+/**
+ * \brief Calls a visitor for every part of a curve inside of a rectangle.
+ *
+ * \details Curve is cut by borders of the rectangle, a part is inside, if
+ * its middle is.
+ *
+ * \param curve Curve to cut.
+ * \param bounds Rectangle.
+ * \param parameters Buffer for parameters of cuts.
+ * \param visit Visitor, which takes parameters of the start and the end.
+ */
+template <class Visitor>
+void ForEachVisibleArc(const Curve& curve, const Clipping::Bounds& bounds,
+                       std::vector<double>& parameters, Visitor&& visit)
+{
+  parameters.clear();
+  AppendCrossings(curve, &Vector::x, bounds.left, parameters);
+  AppendCrossings(curve, &Vector::x, bounds.right, parameters);
+  AppendCrossings(curve, &Vector::y, bounds.top, parameters);
+  AppendCrossings(curve, &Vector::y, bounds.bottom, parameters);
+  std::erase_if(parameters, [](const double parameter)
+                { return !std::isfinite(parameter); });
+
+  if (curve.kind == Curve::Kind::kEllipse)
+  {
+    constexpr auto kPeriod = 2 * std::numbers::pi;
+
+    // Ellipse without cuts is either inside or outside
+    if (parameters.empty())
+    {
+      if (Contains(bounds, curve(0.))) visit(0., kPeriod);
+      return;
+    }
+
+    for (auto& parameter : parameters)
+    {
+      parameter -= kPeriod * std::floor(parameter / kPeriod);
+    }
+    std::ranges::sort(parameters);
+
+    // Last part goes through the start
+    parameters.push_back(parameters.front() + kPeriod);
+  }
+  else
+  {
+    std::ranges::sort(parameters);
+  }
+
+  // Parts, which go to infinity, can't be inside
+  for (size_t cut = 0; cut + 1 < parameters.size(); ++cut)
+  {
+    const auto from = parameters[cut];
+    const auto to = parameters[cut + 1];
+
+    constexpr double kShortest = 1e-12;
+    if (to - from <= kShortest) continue;
+
+    if (Contains(bounds, curve((from + to) / 2))) visit(from, to);
+  }
+}
+
+/**
+ * \brief Writes a part of a curve.
+ *
+ * \param curve Curve in coordinates of the figure.
+ * \param from Parameter of the start.
+ * \param to Parameter of the end.
+ * \param tolerance Maximal distance from an approximation to the curve.
+ * \param writer Writer of the figure.
+ */
+void WriteArc(const Curve& curve, const double from, const double to,
+              const double tolerance, Writer& writer)
+{
+  writer.MoveTo(curve(from));
+
+  switch (curve.kind)
+  {
+    case Curve::Kind::kEllipse:
+      writer.ArcTo(curve, from, to);
+      break;
+    case Curve::Kind::kHyperbola:
+    {
+      /*
+       * Cubic Hermite interpolation of a piece of length h is at most
+       * h^4 / 384 * max|P''''| away, fourth derivative is the curve itself
+       * without the center.
+       */
+      const auto largest = std::max(std::abs(from), std::abs(to));
+      const auto derivative =
+          (std::hypot(curve.first.x, curve.first.y) +
+           std::hypot(curve.second.x, curve.second.y)) *
+          std::cosh(largest);
+      const auto longest = std::pow(384 * tolerance / derivative, 0.25);
+
+      constexpr double kMostPieces = 4096;
+      const auto pieces = static_cast<size_t>(
+          std::clamp(std::ceil((to - from) / longest), 1., kMostPieces));
+      const auto step = (to - from) / static_cast<double>(pieces);
+
+      for (size_t piece = 0; piece < pieces; ++piece)
+      {
+        const auto start = from + step * static_cast<double>(piece);
+        const auto end = start + step;
+        writer.CubicTo(curve(start) + curve.GetDerivative(start) * (step / 3),
+                       curve(end) - curve.GetDerivative(end) * (step / 3),
+                       curve(end));
+      }
+      break;
+    }
+    default:
+      // Parabola is a quadratic Bezier curve itself
+      writer.QuadraticTo(
+          curve(from) + curve.GetDerivative(from) * ((to - from) / 2),
+          curve(to));
+  }
+
+  writer.EndPath();
+}
+}  // namespace
+
+bool Export(const PlaneImplementation& plane, const Options& options,
+            std::ostream& output)
+{
+  const auto& viewport = options.viewport;
+  if (!(viewport.right > viewport.left) || !(viewport.bottom > viewport.top) ||
+      !(options.width > 0))
+  {
+    return false;
+  }
+
+  const Figure figure{options};
+
+  std::unique_ptr<Writer> writer;
+  if (options.format == Format::kPdf)
+  {
+    writer = std::make_unique<PdfWriter>(output);
+  }
+  else
+  {
+    writer = std::make_unique<SvgWriter>(output);
+  }
+
+  const auto size = figure.GetSize();
+  writer->Begin(size.x, size.y);
+
+  const auto& constructions = plane.GetConstructions();
+
+  // Lines
+  writer->BeginLayer(kCurveColor, options.line_width);
+  {
+    LineBatch batch{options, figure, *writer};
+    for (const auto& construction : constructions)
+    {
+      const auto* line = dynamic_cast<const Line*>(construction->GetObject());
+      if (!line) continue;
+
+      if (const auto coefficients = GetLine(line->GetEquation()))
+      {
+        batch.Push(coefficients.value());
+      }
+    }
+    batch.Flush();
+  }
+  writer->EndLayer();
+
+  // Conics
+  writer->BeginLayer(kCurveColor, options.conic_width);
+  {
+    LineBatch batch{options, figure, *writer};
+    std::vector<double> parameters;
+    for (const auto& construction : constructions)
+    {
+      const auto* conic = dynamic_cast<const Conic*>(construction->GetObject());
+      if (!conic) continue;
+
+      const auto shape = GetShape(conic->GetEquation());
+      for (size_t line = 0; line < shape.line_count; ++line)
+      {
+        batch.Push(shape.lines[line]);
+      }
+      for (size_t curve = 0; curve < shape.curve_count; ++curve)
+      {
+        const auto& plane_curve = shape.curves[curve];
+        const auto figure_curve = figure.Map(plane_curve);
+        ForEachVisibleArc(
+            plane_curve, viewport, parameters,
+            [&](const double from, const double to)
+            { WriteArc(figure_curve, from, to, options.tolerance, *writer); });
+      }
+    }
+    batch.Flush();
+  }
+  writer->EndLayer();
+
+  // Points are partly visible near the border
+  const auto margin = options.point_radius / figure.GetScale();
+  const Clipping::Bounds point_bounds{
+      static_cast<float>(viewport.left - margin),
+      static_cast<float>(viewport.top - margin),
+      static_cast<float>(viewport.right + margin),
+      static_cast<float>(viewport.bottom + margin)};
+
+  auto for_each_point = [&](auto&& visit)
+  {
+    for (const auto& construction : constructions)
+    {
+      const auto* point = dynamic_cast<const Point*>(construction->GetObject());
+      if (!point) continue;
+
+      const auto position = GetPosition(point->GetEquation());
+      if (position && Contains(point_bounds, position.value()))
+      {
+        visit(*point, figure.Map(position.value()));
+      }
+    }
+  };
+
+  writer->BeginLayer(kPointColor, 0.);
+  for_each_point([&](const Point&, const Vector& position)
+                 { writer->Circle(position, options.point_radius); });
+  writer->EndLayer();
+
+  // Names are above all points
+  writer->BeginLayer(kTextColor, 0.);
+  for_each_point(
+      [&](const Point& point, const Vector& position)
+      {
+        if (point.GetName().empty()) return;
+        writer->Text(position, options.font_size, point.GetName());
+      });
+  writer->EndLayer();
+
+  writer->End();
+
+  return static_cast<bool>(output);
+}
+}  // namespace HomoGebra::VectorExport
@@ -0,0 +1,70 @@
+#pragma once
+#include <ostream>
+
+#include "Clipping.h"
+
+namespace HomoGebra
+{
+class PlaneImplementation;
+
+/**
+ * \brief Vector figures of a part of a plane.
+ *
+ * \details Objects are written in the order of layers: lines, conics,
+ * points and names of points. Every object is written as soon as it is
+ * computed, so memory doesn't depend on amount of objects. Lines are
+ * clipped with the viewport. Ellipses are written as elliptic arcs (cubic
+ * Bezier curves in PDF), parabolas as quadratic Bezier curves. Neither
+ * format has rational curves, so hyperbolas are written as cubic Bezier
+ * curves within the tolerance. Objects, which aren't in the real plane,
+ * and points at infinity aren't written.
+ */
+namespace VectorExport
+{
+/**
+ * \brief Format of a figure.
+ */
+enum class Format
+{
+  kSvg,  //!< Scalable Vector Graphics, units are pixels.
+  kPdf   //!< Portable Document Format, units are points.
+};
+
+/**
+ * \brief How to export a figure.
+ *
+ * \author nook0110
+ *
+ * \version 1.0
+ *
+ * \date May 2024
+ */
+struct Options
+{
+  Clipping::Bounds viewport{-500.f, -500.f, 500.f,
+                            500.f};  //!< Part of the plane to export.
+  Format format = Format::kSvg;      //!< Format of the figure.
+  float width = 1000.f;              //!< Width, height keeps the aspect.
+  float line_width = 1.f;            //!< Width of lines.
+  float conic_width = 3.f;           //!< Width of conics.
+  float point_radius = 6.f;          //!< Radius of points.
+  float font_size = 12.f;            //!< Height of names of points.
+  float tolerance = 0.05f;           //!< Maximal error of approximations.
+};
+
+/**
+ * \brief Writes objects of a plane, which are in the viewport.
+ *
+ * \details Sizes and the tolerance are given in units of the figure. Axis y
+ * is directed down as on the screen, PDF is flipped to keep it.
+ *
+ * \param plane Plane to write.
+ * \param options How to export.
+ * \param output Stream to write to, it should be binary for PDF.
+ *
+ * \return False if the viewport is empty or stream failed.
+ */
+[[nodiscard]] bool Export(const PlaneImplementation& plane,
+                          const Options& options, std::ostream& output);
+}  // namespace VectorExport
+}  // namespace HomoGebra